@@ -86,6 +86,9 @@ bool DefaultEventManager::pollEvent(Common::Event &event) {
 		// Handle autosaves if enabled
 		g_engine->handleAutoSave();
 
+	// Write out coalesced configuration changes
+	ConfMan.processScheduledFlush();
+
 	if (_eventQueue.empty()) {
 		return false;
 	}
@@ -172,6 +172,14 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the time the object referred by this path was last modified.
+	 *
+	 * @return the modification time in seconds since an arbitrary epoch,
+	 *         or 0 if it is unknown or not supported by the backend.
+	 */
+	virtual int64 getModificationTime() const { return 0; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -88,6 +88,8 @@ public:
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
 	virtual Graphics::Surface *lockScreen() = 0;
 	virtual void unlockScreen() = 0;
+	virtual Graphics::Surface *lockScreenRect(const Common::Rect &rect) { return nullptr; }
+	virtual void unlockScreenRect() {}
 	virtual void fillScreen(uint32 col) = 0;
 	virtual void fillScreen(const Common::Rect &r, uint32 col) = 0;
 	virtual void updateScreen() = 0;
@@ -981,6 +981,21 @@ void OpenGLGraphicsManager::unlockScreen() {
 	_gameScreen->flagDirty();
 }
 
+Graphics::Surface *OpenGLGraphicsManager::lockScreenRect(const Common::Rect &rect) {
+	Graphics::Surface *screen = lockScreen();
+	if (!screen)
+		return nullptr;
+
+	_lockedScreenRect = rect;
+	_lockedScreenArea = screen->getSubArea(rect);
+	return &_lockedScreenArea;
+}
+
+void OpenGLGraphicsManager::unlockScreenRect() {
+	assert(_gameScreen);
+	_gameScreen->addDirtyArea(_lockedScreenRect);
+}
+
 void OpenGLGraphicsManager::setFocusRectangle(const Common::Rect& rect) {
 }
 
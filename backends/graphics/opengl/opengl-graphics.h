@@ -114,6 +114,9 @@ public:
 	Graphics::Surface *lockScreen() override;
 	void unlockScreen() override;
 
+	Graphics::Surface *lockScreenRect(const Common::Rect &rect) override;
+	void unlockScreenRect() override;
+
 	void setFocusRectangle(const Common::Rect& rect) override;
 	void clearFocusRectangle() override;
 
@@ -361,6 +364,12 @@ protected:
 	 */
 	Surface *_gameScreen;
 
+	/**
+	 * The area of the game screen handed out by lockScreenRect().
+	 */
+	Common::Rect _lockedScreenRect;
+	Graphics::Surface _lockedScreenArea;
+
 #if defined(USE_OPENGL_GAME) || defined(USE_OPENGL_SHADERS)
 	/**
 	 * The rendering helper for 3D games.
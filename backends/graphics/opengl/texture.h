@@ -108,6 +108,7 @@ public:
 	void fill(const Common::Rect &r, uint32 color);
 
 	void flagDirty() { _allDirty = true; }
+	void addDirtyArea(const Common::Rect &r);
 	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
 
 	virtual uint getWidth() const = 0;
@@ -150,7 +151,6 @@ public:
 protected:
 	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
 
-	void addDirtyArea(const Common::Rect &r);
 	Common::Rect getDirtyArea() const;
 private:
 	bool _allDirty;
@@ -25,6 +25,7 @@
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -192,6 +193,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_transactionMode(kTransactionNone),
 	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr),
 	_needRestoreAfterOverlay(false), _isInOverlayPalette(false), _isDoubleBuf(false), _prevForceRedraw(false), _numPrevDirtyRects(0),
+	_scalerPool(nullptr),
 	_prevCursorNeedsRedraw(false),
 	_mouseKeyColor(0), _disableMouseKeyColor(false) {
 
@@ -237,10 +239,13 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 
 	_videoMode.scalerIndex = getDefaultScaler();
 	_videoMode.scaleFactor = getDefaultScaleFactor();
+
+	_scalerPool = new SdlScalerPool();
 }
 
 SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
 	unloadGFXMode();
+	delete _scalerPool;
 	delete _scaler;
 	delete _mouseScaler;
 	if (_mouseOrigSurface) {
@@ -1211,6 +1216,92 @@ void SurfaceSdlGraphicsManager::updateScreen(SDL_Rect *dirtyRectList, int actual
 	SDL_UpdateRects(_hwScreen, actualDirtyRects, dirtyRectList);
 }
 
+// Fixed cost of scaling and presenting a rect, expressed in source pixels
+static const int kDirtyRectOverhead = 16 * 16;
+
+// Updates smaller than this (in source pixels) are not split across threads
+static const int kMinBandedPixels = 320 * 64;
+
+static uint64 getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	uint64 counter = SDL_GetPerformanceCounter();
+	uint64 freq = SDL_GetPerformanceFrequency();
+	return (counter / freq) * 1000000 + (counter % freq) * 1000000 / freq;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
+int SurfaceSdlGraphicsManager::coalesceDirtyRects(SDL_Rect *rects, int count) {
+	bool merged;
+	do {
+		merged = false;
+		for (int i = 0; i < count; ++i) {
+			for (int j = i + 1; j < count; ) {
+				SDL_Rect &a = rects[i];
+				const SDL_Rect &b = rects[j];
+
+				const int left = MIN<int>(a.x, b.x);
+				const int top = MIN<int>(a.y, b.y);
+				const int right = MAX<int>(a.x + a.w, b.x + b.w);
+				const int bottom = MAX<int>(a.y + a.h, b.y + b.h);
+
+				const int overlapW = MIN<int>(a.x + a.w, b.x + b.w) - MAX<int>(a.x, b.x);
+				const int overlapH = MIN<int>(a.y + a.h, b.y + b.h) - MAX<int>(a.y, b.y);
+				const int overlap = (overlapW > 0 && overlapH > 0) ? overlapW * overlapH : 0;
+
+				const int separateCost = a.w * a.h + b.w * b.h - overlap + kDirtyRectOverhead;
+				const int mergedCost = (right - left) * (bottom - top);
+
+				if (mergedCost <= separateCost) {
+					a.x = left;
+					a.y = top;
+					a.w = right - left;
+					a.h = bottom - top;
+					rects[j] = rects[--count];
+					merged = true;
+				} else {
+					++j;
+				}
+			}
+		}
+	} while (merged);
+
+	return count;
+}
+
+void SurfaceSdlGraphicsManager::scaleRect(const byte *src, uint32 srcPitch, byte *dst, uint32 dstPitch,
+                                          int width, int height, int x, int y, int factor) {
+	// Scalers using the old source keep state between calls and have to
+	// see the whole rect at once
+	if (_scalerPool && !_useOldSrc && width * height >= kMinBandedPixels)
+		_scalerPool->scale(_scaler, src, srcPitch, dst, dstPitch, width, height, x, y, factor);
+	else
+		_scaler->scale(src, srcPitch, dst, dstPitch, width, height, x, y);
+}
+
+void SurfaceSdlGraphicsManager::updateFrameStats(uint64 startTime, int rectsAdded, int rectsScaled, uint64 pixelsScaled) {
+	const uint64 elapsed = getMicros() - startTime;
+
+	_frameStats.frames++;
+	_frameStats.rectsAdded += rectsAdded;
+	_frameStats.rectsScaled += rectsScaled;
+	_frameStats.pixelsScaled += pixelsScaled;
+	_frameStats.totalTime += elapsed;
+	_frameStats.maxTime = MAX(_frameStats.maxTime, elapsed);
+
+	const uint32 now = SDL_GetTicks();
+	if (now - _frameStats.lastReport < 5000)
+		return;
+
+	const double frames = _frameStats.frames;
+	debug(2, "SurfaceSdlGraphicsManager: %u updates, %.2f ms avg, %.2f ms max, %.1f dirty rects merged into %.1f, %.1f kpixels scaled per update",
+	      _frameStats.frames, _frameStats.totalTime / frames / 1000.0, _frameStats.maxTime / 1000.0,
+	      _frameStats.rectsAdded / frames, _frameStats.rectsScaled / frames, _frameStats.pixelsScaled / frames / 1000.0);
+
+	_frameStats.reset(now);
+}
+
 void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	SDL_Surface *srcSurf, *origSurf;
 	int height, width;
@@ -1221,6 +1312,9 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	if (debugger)
 		debugger->onFrame();
 
+	const uint64 frameStart = getMicros();
+	uint64 pixelsScaled = 0;
+
 	bool curCursorNeedsRedraw = _cursorNeedsRedraw;
 	if (_prevCursorNeedsRedraw && _isDoubleBuf) {
 		_cursorNeedsRedraw = true;
@@ -1359,6 +1453,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		memcpy(_dirtyRectList + _numDirtyRects, _prevDirtyRectList, _numPrevDirtyRects * sizeof(_dirtyRectList[0]));
 		actualDirtyRects += _numPrevDirtyRects;
 	}
+	const int rectsAdded = actualDirtyRects;
 
 	// Force a full redraw if requested.
 	// If _useOldSrc, the scaler will do its own partial updates.
@@ -1376,6 +1471,13 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		_numPrevDirtyRects = _numDirtyRects;
 	}
 
+	// Merge overlapping and neighbouring rects, so that no pixel gets
+	// scaled twice and small updates share the per-rect overhead.
+	// Since the rects are expanded by the scaler's extra pixels and made
+	// stretchable in addDirtyRect(), their bounding box is as well.
+	if (!doRedraw && actualDirtyRects > 1)
+		actualDirtyRects = coalesceDirtyRects(_dirtyRectList, actualDirtyRects);
+
 	// Only draw anything if necessary
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	bool doPresent = false;
@@ -1453,8 +1555,9 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				if (_videoMode.aspectRatioCorrection && !_overlayVisible)
 					dst_y = real2Aspect(dst_y);
 
-				_scaler->scale((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
-						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y);
+				scaleRect((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
+						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y, scale1);
+				pixelsScaled += dst_w * dst_h;
 
 				r->x = dst_x;
 				r->y = dst_y;
@@ -1591,6 +1694,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	_forceRedraw = false;
 	_cursorNeedsRedraw = false;
 
+	updateFrameStats(frameStart, rectsAdded, actualDirtyRects, pixelsScaled);
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 
 #if defined(USE_IMGUI) && (defined(USE_IMGUI_SDLRENDERER2) || defined(USE_IMGUI_SDLRENDERER3))
@@ -1788,6 +1893,33 @@ void SurfaceSdlGraphicsManager::unlockScreen() {
 	_graphicsMutex.unlock();
 }
 
+Graphics::Surface *SurfaceSdlGraphicsManager::lockScreenRect(const Common::Rect &rect) {
+	assert(rect.left >= 0 && rect.right <= _videoMode.screenWidth);
+	assert(rect.top >= 0 && rect.bottom <= _videoMode.screenHeight);
+
+	Graphics::Surface *screen = lockScreen();
+	_lockedScreenRect = rect;
+	_framebuffer = screen->getSubArea(rect);
+	return &_framebuffer;
+}
+
+void SurfaceSdlGraphicsManager::unlockScreenRect() {
+	assert(_transactionMode == kTransactionNone);
+
+	// paranoia check
+	assert(_screenIsLocked);
+	_screenIsLocked = false;
+
+	// Unlock the screen surface
+	SDL_UnlockSurface(_screen);
+
+	// Only the locked area needs to be scaled and presented again
+	addDirtyRect(_lockedScreenRect.left, _lockedScreenRect.top, _lockedScreenRect.width(), _lockedScreenRect.height(), false);
+
+	// Finally unlock the graphics mutex
+	_graphicsMutex.unlock();
+}
+
 void SurfaceSdlGraphicsManager::fillScreen(uint32 col) {
 	Graphics::Surface *screen = lockScreen();
 	if (screen)
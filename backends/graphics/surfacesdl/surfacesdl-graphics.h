@@ -24,6 +24,7 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/graphics/sdl/sdl-graphics.h"
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
@@ -104,6 +105,8 @@ public:
 	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
 	Graphics::Surface *lockScreen() override;
 	void unlockScreen() override;
+	Graphics::Surface *lockScreenRect(const Common::Rect &rect) override;
+	void unlockScreenRect() override;
 	void fillScreen(uint32 col) override;
 	void fillScreen(const Common::Rect &r, uint32 col) override;
 	void updateScreen() override;
@@ -348,6 +351,7 @@ protected:
 
 	bool _screenIsLocked;
 	Graphics::Surface _framebuffer;
+	Common::Rect _lockedScreenRect;
 
 	int _screenChangeCount;
 
@@ -366,6 +370,40 @@ protected:
 	SDL_Rect _prevDirtyRectList[NUM_DIRTY_RECT];
 	int _numPrevDirtyRects;
 
+	/**
+	 * Merge the given dirty rects into a smaller covering set. Two rects
+	 * are merged whenever scaling their bounding box is not more expensive
+	 * than scaling both separately. Returns the new number of rects.
+	 */
+	static int coalesceDirtyRects(SDL_Rect *rects, int count);
+
+	// Threads used to scale large updates in horizontal bands
+	SdlScalerPool *_scalerPool;
+
+	void scaleRect(const byte *src, uint32 srcPitch, byte *dst, uint32 dstPitch,
+	               int width, int height, int x, int y, int factor);
+
+	// Screen update statistics, reported through debug level 2
+	struct FrameStats {
+		uint32 frames;
+		uint32 rectsAdded;
+		uint32 rectsScaled;
+		uint64 pixelsScaled;
+		uint64 totalTime;
+		uint64 maxTime;
+		uint32 lastReport;
+
+		FrameStats() { reset(0); }
+		void reset(uint32 now) {
+			frames = rectsAdded = rectsScaled = 0;
+			pixelsScaled = totalTime = maxTime = 0;
+			lastReport = now;
+		}
+	};
+	FrameStats _frameStats;
+
+	void updateFrameStats(uint64 startTime, int rectsAdded, int rectsScaled, uint64 pixelsScaled);
+
 	struct MousePos {
 		// The size and hotspot of the original cursor image.
 		int16 w, h;
@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
+#include "common/debug.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+#define SCALERPOOL_SEM_POST(sem) SDL_SignalSemaphore(sem)
+#define SCALERPOOL_SEM_WAIT(sem) SDL_WaitSemaphore(sem)
+#else
+#define SCALERPOOL_SEM_POST(sem) SDL_SemPost(sem)
+#define SCALERPOOL_SEM_WAIT(sem) SDL_SemWait(sem)
+#endif
+
+SdlScalerPool::SdlScalerPool() : _numWorkers(0), _quit(false), _done(nullptr),
+	_scaler(nullptr), _srcPitch(0), _dstPitch(0), _width(0), _x(0) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	int cpus = SDL_GetNumLogicalCPUCores();
+#else
+	int cpus = SDL_GetCPUCount();
+#endif
+	int wanted = CLIP(cpus - 1, 0, (int)kMaxWorkers);
+	if (wanted == 0)
+		return;
+
+	_done = SDL_CreateSemaphore(0);
+	if (!_done) {
+		warning("SdlScalerPool: Could not create semaphore: %s", SDL_GetError());
+		return;
+	}
+
+	for (int i = 0; i < wanted; ++i) {
+		Worker &w = _workers[i];
+		w.pool = this;
+		w.index = i + 1;
+		w.start = SDL_CreateSemaphore(0);
+		if (!w.start)
+			break;
+		w.thread = SDL_CreateThread(workerMain, "ScummVM scaler", &w);
+		if (!w.thread) {
+			SDL_DestroySemaphore(w.start);
+			break;
+		}
+		++_numWorkers;
+	}
+
+	if (_numWorkers < wanted)
+		warning("SdlScalerPool: Only %d of %d scaler threads could be started", _numWorkers, wanted);
+	debug(1, "SdlScalerPool: Using %d scaler threads", _numWorkers + 1);
+#endif
+}
+
+SdlScalerPool::~SdlScalerPool() {
+	_quit = true;
+	for (int i = 0; i < _numWorkers; ++i)
+		SCALERPOOL_SEM_POST(_workers[i].start);
+	for (int i = 0; i < _numWorkers; ++i) {
+		SDL_WaitThread(_workers[i].thread, nullptr);
+		SDL_DestroySemaphore(_workers[i].start);
+	}
+	if (_done)
+		SDL_DestroySemaphore(_done);
+}
+
+int SDLCALL SdlScalerPool::workerMain(void *data) {
+	Worker *worker = (Worker *)data;
+	SdlScalerPool *pool = worker->pool;
+
+	for (;;) {
+		SCALERPOOL_SEM_WAIT(worker->start);
+		if (pool->_quit)
+			break;
+
+		pool->scaleBand(pool->_bands[worker->index]);
+		SCALERPOOL_SEM_POST(pool->_done);
+	}
+
+	return 0;
+}
+
+void SdlScalerPool::scaleBand(const Band &band) {
+	_scaler->scale(band.src, _srcPitch, band.dst, _dstPitch, _width, band.height, _x, band.y);
+}
+
+void SdlScalerPool::scale(Scaler *scaler, const byte *src, uint32 srcPitch, byte *dst, uint32 dstPitch,
+                          int width, int height, int x, int y, int factor) {
+	int numBands = MIN(getThreadCount(), height / (int)kMinBandHeight);
+	if (numBands <= 1) {
+		scaler->scale(src, srcPitch, dst, dstPitch, width, height, x, y);
+		return;
+	}
+
+	_scaler = scaler;
+	_srcPitch = srcPitch;
+	_dstPitch = dstPitch;
+	_width = width;
+	_x = x;
+
+	// Spread the lines evenly, the first bands get the remainder
+	int line = 0;
+	for (int i = 0; i < numBands; ++i) {
+		Band &band = _bands[i];
+		band.height = height / numBands + (i < height % numBands ? 1 : 0);
+		band.src = src + line * srcPitch;
+		band.dst = dst + line * factor * dstPitch;
+		band.y = y + line;
+		line += band.height;
+	}
+
+	for (int i = 1; i < numBands; ++i)
+		SCALERPOOL_SEM_POST(_workers[i - 1].start);
+
+	scaleBand(_bands[0]);
+
+	for (int i = 1; i < numBands; ++i)
+		SCALERPOOL_SEM_WAIT(_done);
+}
+
+#endif
@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+#define BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+
+#include "backends/platform/sdl/sdl-sys.h"
+#include "graphics/scalerplugin.h"
+
+/**
+ * Runs a scaler over horizontal bands of a rectangle on several threads.
+ *
+ * The pool is only used with scalers that don't keep state between calls
+ * (i.e. scalers which don't use the old source), since those can work on
+ * disjoint bands of the destination without synchronisation. The calling
+ * thread always scales the first band itself.
+ */
+class SdlScalerPool {
+public:
+	SdlScalerPool();
+	~SdlScalerPool();
+
+	/** Number of threads taking part in a banded scale, including the caller. */
+	int getThreadCount() const { return _numWorkers + 1; }
+
+	/**
+	 * Scale a rectangle, splitting it into up to getThreadCount() bands of
+	 * at least kMinBandHeight source lines each.
+	 */
+	void scale(Scaler *scaler, const byte *src, uint32 srcPitch, byte *dst, uint32 dstPitch,
+	           int width, int height, int x, int y, int factor);
+
+	enum {
+		kMaxWorkers = 7,
+		kMinBandHeight = 16
+	};
+
+private:
+	struct Band {
+		const byte *src;
+		byte *dst;
+		int height;
+		int y;
+	};
+
+	struct Worker {
+		SdlScalerPool *pool;
+		int index;
+		SDL_Thread *thread;
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_Semaphore *start;
+#else
+		SDL_sem *start;
+#endif
+	};
+
+	static int SDLCALL workerMain(void *data);
+	void scaleBand(const Band &band);
+
+	Worker _workers[kMaxWorkers];
+	int _numWorkers;
+	bool _quit;
+
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_Semaphore *_done;
+#else
+	SDL_sem *_done;
+#endif
+
+	// The job currently being processed, only written while the workers are idle
+	Band _bands[kMaxWorkers + 1];
+	Scaler *_scaler;
+	uint32 _srcPitch, _dstPitch;
+	int _width, _x;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include "backends/mixer/mixer.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 
@@ -180,6 +181,14 @@ void ModularGraphicsBackend::unlockScreen() {
 	_graphicsManager->unlockScreen();
 }
 
+Graphics::Surface *ModularGraphicsBackend::lockScreenRect(const Common::Rect &rect) {
+	return _graphicsManager->lockScreenRect(rect);
+}
+
+void ModularGraphicsBackend::unlockScreenRect() {
+	_graphicsManager->unlockScreenRect();
+}
+
 void ModularGraphicsBackend::fillScreen(uint32 col) {
 	_graphicsManager->fillScreen(col);
 }
@@ -189,6 +198,10 @@ void ModularGraphicsBackend::fillScreen(const Common::Rect &r, uint32 col) {
 }
 
 void ModularGraphicsBackend::updateScreen() {
+	// Each screen update starts a new profiler frame
+	PROFILE_FRAME();
+	PROFILE_ZONE("OSystem::updateScreen");
+
 #ifdef ENABLE_EVENTRECORDER
 	g_system->getMillis();		// force event recorder to update the tick count
 	g_eventRec.processScreenUpdate();
@@ -402,6 +402,10 @@ void registerDefaults() {
 	ConfMan.registerDefault("gui_list_max_scan_entries", -1);
 	ConfMan.registerDefault("game", "");
 
+	// Memory budget in KB for the extracted contents of compressed and
+	// installer archives, shared by all of them
+	ConfMan.registerDefault("archive_cache_size", 16 * 1024);
+
 #ifdef USE_FLUIDSYNTH
 	// The settings are deliberately stored the same way as in Qsynth. The
 	// FluidSynth music driver is responsible for transforming them into
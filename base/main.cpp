@@ -902,6 +902,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #endif
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
+	ConfMan.processScheduledFlush(true);
 	Common::ConfigManager::destroy();
 	Common::DebugManager::destroy();
 	Common::OSDMessageQueue::destroy();
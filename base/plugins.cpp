@@ -25,14 +25,14 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
-
-#ifdef DYNAMIC_MODULES
 #include "common/fs.h"
-#endif
+#include "common/hash-str.h"
+#include "common/stream.h"
 
 #include "base/detection/detection.h"
 
 #include "engines/advancedDetector.h"
+#include "engines/metaengine.h"
 
 // Plugin versioning
 
@@ -385,9 +385,95 @@ bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineI
 			}
 		}
 	}
+
+	// Finally, look it up in the manifest of all engines
+	if (ensureEngineManifest()) {
+		domain = ConfMan.getDomain("engine_plugin_manifest");
+		if (domain && domain->contains(engineId)) {
+			if (loadPluginByFileName(Common::Path::fromConfig((*domain)[engineId]))) {
+				return true;
+			}
+		}
+	}
 	return false;
 }
 
+/**
+ * Build a string identifying the set of engine plugins found at startup,
+ * from their file names, sizes and modification times.
+ **/
+Common::String PluginManagerUncached::computePluginsStamp() const {
+	Common::String list;
+	for (const auto &enginePlugin : _allEnginePlugins) {
+		Common::Path filename = enginePlugin->getFileName();
+		Common::FSNode node(filename);
+		Common::SeekableReadStream *stream = node.createReadStream();
+		list += Common::String::format("%s:%d:%lld;", filename.toConfig().c_str(), stream ? (int)stream->size() : -1,
+		                               (long long)node.getModificationTime());
+		delete stream;
+	}
+
+	return Common::String::format("%u-%x", _allEnginePlugins.size(), Common::hashit(list.c_str()));
+}
+
+/**
+ * Make sure the manifest stored in the 'engine_plugin_manifest' domain of the
+ * ConfigManager, which maps each engine ID to its plugin file, matches the
+ * plugins we have. If it doesn't, every plugin is loaded once to rebuild it.
+ *
+ * This allows finding the plugin of any engine without having to go through
+ * all plugins each time. If any plugin fails to load, the manifest is left
+ * incomplete and unstamped, so that it is rebuilt on the next run, and the
+ * callers keep scanning the plugins.
+ **/
+bool PluginManagerUncached::ensureEngineManifest() {
+	if (_manifestChecked)
+		return _manifestValid;
+	_manifestChecked = true;
+
+	Common::String stamp = computePluginsStamp();
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_manifest");
+	if (domain && domain->contains("plugins_stamp") && (*domain)["plugins_stamp"] == stamp) {
+		_manifestValid = true;
+		return true;
+	}
+
+	debug(1, "Engine plugin manifest is missing or outdated, rebuilding it");
+
+	if (!domain) {
+		ConfMan.addMiscDomain("engine_plugin_manifest");
+		domain = ConfMan.getDomain("engine_plugin_manifest");
+		assert(domain);
+	}
+	domain->clear();
+
+	bool complete = true;
+	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, nullptr, false);
+	for (auto &enginePlugin : _allEnginePlugins) {
+		if (!enginePlugin->loadPlugin()) {
+			warning("Could not load plugin '%s' for the engine plugin manifest", enginePlugin->getFileName().toString(Common::Path::kNativeSeparator).c_str());
+			complete = false;
+			continue;
+		}
+
+		if (enginePlugin->getType() == PLUGIN_TYPE_ENGINE)
+			domain->setVal(enginePlugin->get<MetaEngine>().getName(), enginePlugin->getFileName().toConfig());
+
+		enginePlugin->unloadPlugin();
+	}
+
+	if (!complete) {
+		_manifestValid = false;
+		return false;
+	}
+
+	domain->setVal("plugins_stamp", stamp);
+	ConfMan.flushToDisk();
+
+	_manifestValid = true;
+	return true;
+}
+
 /**
  * Load a plugin with a filename taken from ConfigManager.
  **/
@@ -608,8 +694,6 @@ void PluginManager::addToPluginsInMemList(Plugin *plugin) {
 
 // Engine plugins
 
-#include "engines/metaengine.h"
-
 namespace Common {
 DECLARE_SINGLETON(EngineManager);
 }
@@ -346,9 +346,20 @@ protected:
 
 	bool _isDetectionLoaded;
 
-	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false) {}
+	/**
+	 * Whether the engine manifest has been checked against the plugins
+	 * found at startup, and whether it matches them.
+	 */
+	bool _manifestChecked;
+	bool _manifestValid;
+
+	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false),
+		_manifestChecked(false), _manifestValid(false) {}
 	bool loadPluginByFileName(const Common::Path &filename);
 
+	Common::String computePluginsStamp() const;
+	bool ensureEngineManifest();
+
 public:
 	virtual ~PluginManagerUncached();
 	void init() override;
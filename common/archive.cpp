@@ -20,6 +20,7 @@
  */
 
 #include "common/archive.h"
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/system.h"
@@ -249,50 +250,171 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberI
 	cacheKey.path = translatePath(path);
 	cacheKey.altStreamType = isAltStream ? altStreamType : AltStreamType::Invalid;
 
-	bool isNew = false;
-	if (!_cache.contains(cacheKey)) {
-		SharedArchiveContents readResult = isAltStream ? readContentsForPathAltStream(cacheKey.path, altStreamType) : readContentsForPath(cacheKey.path);
-		if (readResult._bypass)
-			return readResult._bypass;
-		_cache[cacheKey] = readResult;
-		isNew = true;
+	{
+		StackLock lock(getCacheMutex());
+		CacheMap::iterator it = _cache.find(cacheKey);
+		if (it != _cache.end()) {
+			// Errors and missing files. Just return nullptr,
+			// no need to create stream.
+			if (it->_value.contents.isFileMissing())
+				return nullptr;
+
+			// Check whether the entry is still valid as WeakPtr might have expired.
+			if (it->_value.contents.makeStrong()) {
+				_cacheStats.hits++;
+				return createCachedStream(cacheKey, it->_value);
+			}
+		}
 	}
 
-	SharedArchiveContents* entry = &_cache[cacheKey];
+	// Not cached or expired. Reading may take a while, so don't keep the
+	// other archives waiting meanwhile.
+	SharedArchiveContents readResult = isAltStream ? readContentsForPathAltStream(cacheKey.path, altStreamType) : readContentsForPath(cacheKey.path);
+	if (readResult._bypass)
+		return readResult._bypass;
 
-	// Errors and missing files. Just return nullptr,
-	// no need to create stream.
-	if (entry->isFileMissing())
-		return nullptr;
+	StackLock lock(getCacheMutex());
 
-	// Check whether the entry is still valid as WeakPtr might have expired.
-	if (!entry->makeStrong()) {
-		// If it's expired, recreate the entry.
-		SharedArchiveContents readResult = isAltStream ? readContentsForPathAltStream(cacheKey.path, altStreamType) : readContentsForPath(cacheKey.path);
-		if (readResult._bypass)
-			return readResult._bypass;
-		_cache[cacheKey] = readResult;
-		entry = &_cache[cacheKey];
-		isNew = true;
-	}
+	// Another thread may have read the same member in the meantime, in
+	// which case our copy replaces it.
+	CacheEntry &entry = _cache[cacheKey];
+	removeFromLRU(entry);
+	entry.contents = readResult;
 
-	// It's possible that recreation failed in case of e.g. network
+	// It's possible that reading failed in case of e.g. network
 	// share going offline.
-	if (entry->isFileMissing())
+	if (entry.contents.isFileMissing())
 		return nullptr;
 
-	// Now we have a valid contents reference. Make stream for it.
-	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(entry->getContents(), entry->getSize());
+	_cacheStats.misses++;
+	return createCachedStream(cacheKey, entry);
+}
 
-	// If the entry was just created and it's too big for strong caching,
-	// mark the copy in cache as weak
-	if (isNew && entry->getSize() > _maxStronglyCachedSize) {
-		entry->makeWeak();
+SeekableReadStream *MemcachingCaseInsensitiveArchive::createCachedStream(const CacheKey &key, CacheEntry &entry) const {
+	// Now we have a valid contents reference. Make stream for it.
+	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(entry.contents.getContents(), entry.contents.getSize());
+
+	if (entry.inLRU) {
+		// Mark as most recently used
+		LRUList &lru = getLRU();
+		LRUNode node = *entry.lruNode;
+		lru.erase(entry.lruNode);
+		lru.push_front(node);
+		entry.lruNode = lru.begin();
+	} else {
+		// Either new or brought back from a weak reference. Keep it if it
+		// may fit within our budget, otherwise let it go with its streams.
+		uint64 budget = getCacheBudget();
+		uint32 size = entry.contents.getSize();
+		if (size == 0 || size > budget || (_maxStronglyCachedSize && size > _maxStronglyCachedSize)) {
+			entry.contents.makeWeak();
+		} else {
+			addToLRU(key, entry);
+			trimCache(budget);
+		}
 	}
 
 	return memStream;
 }
 
+MemcachingCaseInsensitiveArchive::~MemcachingCaseInsensitiveArchive() {
+	StackLock lock(getCacheMutex());
+	for (auto &entry : _cache)
+		removeFromLRU(entry._value);
+}
+
+void MemcachingCaseInsensitiveArchive::addToLRU(const CacheKey &key, CacheEntry &entry) const {
+	LRUNode node;
+	node.archive = this;
+	node.key = key;
+	node.size = entry.contents.getSize();
+
+	LRUList &lru = getLRU();
+	lru.push_front(node);
+	entry.lruNode = lru.begin();
+	entry.inLRU = true;
+	_cacheUsed += node.size;
+}
+
+void MemcachingCaseInsensitiveArchive::removeFromLRU(CacheEntry &entry) const {
+	if (!entry.inLRU)
+		return;
+
+	_cacheUsed -= entry.lruNode->size;
+	getLRU().erase(entry.lruNode);
+	entry.inLRU = false;
+}
+
+Mutex &MemcachingCaseInsensitiveArchive::getCacheMutex() {
+	static Mutex mutex;
+	return mutex;
+}
+
+MemcachingCaseInsensitiveArchive::LRUList &MemcachingCaseInsensitiveArchive::getLRU() {
+	static LRUList lru;
+	return lru;
+}
+
+uint64 MemcachingCaseInsensitiveArchive::getCacheBudget() {
+	// 16 MB, unless configured otherwise
+	int budgetKB = 16 * 1024;
+	if (ConfMan.hasKey("archive_cache_size"))
+		budgetKB = ConfMan.getInt("archive_cache_size");
+	return budgetKB > 0 ? (uint64)budgetKB * 1024 : 0;
+}
+
+void MemcachingCaseInsensitiveArchive::trimCache(uint64 budget) {
+	LRUList &lru = getLRU();
+	LRUList::iterator it = lru.reverse_begin();
+	while (_cacheUsed > budget && it != lru.end()) {
+		LRUList::iterator prev = it;
+		--prev;
+
+		// Pinned entries stay: dropping them wouldn't free anything while
+		// their streams are open, and they would have to be read again.
+		CacheEntry &entry = it->archive->_cache[it->key];
+		if (!entry.contents.isInUse()) {
+			const MemcachingCaseInsensitiveArchive *archive = it->archive;
+			CacheKey key = it->key;
+			archive->removeFromLRU(entry);
+			archive->_cache.erase(key);
+			_cacheStats.evictions++;
+		}
+
+		it = prev;
+	}
+}
+
+ArchiveCacheStats MemcachingCaseInsensitiveArchive::getCacheStats() {
+	StackLock lock(getCacheMutex());
+	ArchiveCacheStats stats = _cacheStats;
+	stats.entries = 0;
+	stats.pinned = 0;
+	for (const auto &node : getLRU()) {
+		stats.entries++;
+		if (node.archive->_cache[node.key].contents.isInUse())
+			stats.pinned++;
+	}
+	stats.bytesUsed = _cacheUsed;
+	stats.budget = getCacheBudget();
+	return stats;
+}
+
+void MemcachingCaseInsensitiveArchive::resetCacheStats() {
+	StackLock lock(getCacheMutex());
+	_cacheStats.hits = 0;
+	_cacheStats.misses = 0;
+	_cacheStats.evictions = 0;
+}
+
+void MemcachingCaseInsensitiveArchive::enforceCacheBudget() {
+	StackLock lock(getCacheMutex());
+	trimCache(getCacheBudget());
+}
+
+uint64 MemcachingCaseInsensitiveArchive::_cacheUsed = 0;
+ArchiveCacheStats MemcachingCaseInsensitiveArchive::_cacheStats = { 0, 0, 0, 0, 0, 0, 0 };
+
 SharedArchiveContents MemcachingCaseInsensitiveArchive::readContentsForPathAltStream(const Path &translatedPath, AltStreamType altStreamType) const {
 	return SharedArchiveContents();
 }
@@ -338,6 +460,52 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	invalidateIndexes();
+}
+
+int SearchSet::_generation = 0;
+
+SearchSet::IndexPtr SearchSet::getIndex() const {
+	int generation = atomicLoad(_generation);
+
+	{
+		StackLock lock(_indexMutex);
+		if (_index && _index->generation == generation)
+			return _index;
+	}
+
+	// Archives may look up files while listing their members, so the index
+	// is built without holding the lock
+	IndexPtr index = buildIndex(generation);
+
+	StackLock lock(_indexMutex);
+	_index = index;
+	return index;
+}
+
+SearchSet::IndexPtr SearchSet::buildIndex(int generation) const {
+	IndexPtr index(new Index(generation));
+
+	uint rank = 0;
+	for (const auto &archive : _list) {
+		if (archive._arc->hasStableMemberList()) {
+			ArchiveMemberList members;
+			archive._arc->listMembers(members);
+
+			for (const auto &member : members) {
+				Path path = member->getPathInArchive();
+				// Archives with a higher priority come first and win
+				if (!index->members.contains(path))
+					index->members[path] = IndexEntry(archive._arc, rank);
+			}
+		} else {
+			index->unindexed.push_back(IndexEntry(archive._arc, rank));
+		}
+
+		++rank;
+	}
+
+	return index;
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -434,6 +602,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateIndexes();
 	}
 }
 
@@ -457,6 +626,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateIndexes();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -475,16 +645,27 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
-bool SearchSet::hasFile(const Path &path) const {
+Archive *SearchSet::findFile(const Path &path) const {
 	if (path.empty())
-		return false;
+		return nullptr;
 
-	for (const auto &archive : _list) {
-		if (archive._arc->hasFile(path))
-			return true;
+	IndexPtr index = getIndex();
+	IndexEntry hit;
+	bool found = index->members.tryGetVal(path, hit);
+
+	// Only the unindexed archives with a higher priority need to be asked
+	for (const auto &entry : index->unindexed) {
+		if (found && entry.rank > hit.rank)
+			break;
+		if (entry.arc->hasFile(path))
+			return entry.arc;
 	}
 
-	return false;
+	return hit.arc;
+}
+
+bool SearchSet::hasFile(const Path &path) const {
+	return findFile(path) != nullptr;
 }
 
 bool SearchSet::isPathDirectory(const Path &path) const {
@@ -510,6 +691,15 @@ bool SearchSet::isPathDirectory(const Path &path) const {
 	return false;
 }
 
+bool SearchSet::hasStableMemberList() const {
+	for (const auto &archive : _list) {
+		if (!archive._arc->hasStableMemberList())
+			return false;
+	}
+
+	return true;
+}
+
 bool SearchSet::getChildren(const Common::Path &path, Common::Array<Common::String> &list, ListMode mode, bool hidden) const {
 	bool hasAny = false;
 	list.clear();
@@ -556,36 +746,50 @@ int SearchSet::listMembers(ArchiveMemberList &list) const {
 }
 
 const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **container) const {
-	if (path.empty())
+	Archive *archive = findFile(path);
+	if (!archive)
 		return ArchiveMemberPtr();
 
-	for (const auto &archive : _list) {
-		if (archive._arc->hasFile(path)) {
-			if (container) {
-				*container = archive._arc;
-			}
-			return archive._arc->getMember(path);
-		}
+	if (container) {
+		*container = archive;
 	}
-
-	return ArchiveMemberPtr();
+	return archive->getMember(path);
 }
 
 const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
 	return getMember(path, nullptr);
 }
 
+int64 SearchSet::getMemberSize(const Path &path) const {
+	Archive *archive = findFile(path);
+	return archive ? archive->getMemberSize(path) : -1;
+}
+
 SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const {
 	if (path.empty())
 		return nullptr;
 
-	for (const auto &archive : _list) {
-		SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
+	IndexPtr index = getIndex();
+	IndexEntry hit;
+	bool found = index->members.tryGetVal(path, hit);
+
+	for (const auto &entry : index->unindexed) {
+		if (found && entry.rank > hit.rank)
+			break;
+		SeekableReadStream *stream = entry.arc->createReadStreamForMember(path);
 		if (stream)
 			return stream;
 	}
 
-	return nullptr;
+	if (!found)
+		return nullptr;
+
+	SeekableReadStream *stream = hit.arc->createReadStreamForMember(path);
+	if (stream)
+		return stream;
+
+	// The member could not be opened after all, so try the archives after it
+	return createReadStreamForMemberNext(path, hit.arc);
 }
 
 SeekableReadStream *SearchSet::createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const {
@@ -22,10 +22,13 @@
 #ifndef COMMON_ARCHIVE_H
 #define COMMON_ARCHIVE_H
 
+#include "common/array.h"
+#include "common/atomic.h"
 #include "common/error.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
 #include "common/list.h"
+#include "common/mutex.h"
 #include "common/path.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -175,6 +178,14 @@ public:
 	 */
 	virtual int listMembers(ArchiveMemberList &list) const = 0;
 
+	/**
+	 * Check whether listMembers() adds exactly the paths for which hasFile()
+	 * succeeds, and keeps doing so for as long as the Archive is in use.
+	 * A SearchSet looks up the members of such archives in an index instead
+	 * of asking them each time.
+	 */
+	virtual bool hasStableMemberList() const { return false; }
+
 	/**
 	 * Return an ArchiveMember representation of the given file.
 	 */
@@ -188,6 +199,15 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const Path &path) const = 0;
 
+	/**
+	 * Return the size of the member with the specified name, as recorded
+	 * in the archive, without opening or decompressing it.
+	 *
+	 * @return The uncompressed size, or -1 if the member does not exist or
+	 *         the archive does not record sizes.
+	 */
+	virtual int64 getMemberSize(const Path &path) const { return -1; }
+
 	/**
 	 * Create a stream bound to an alternate stream of a member with the specified
 	 * name in the archive. If no member with this name exists, 0 is returned.
@@ -256,6 +276,9 @@ private:
 	SharedPtr<byte> getContents() const { return _strongRef; }
 	uint32 getSize() const { return _contentSize; }
 
+	// Streams created from these contents hold additional strong references
+	bool isInUse() const { return _strongRef && _strongRef.refCount() > 1; }
+
 	bool makeStrong() {
 		if (_strongRef || _contentSize == 0 || _missingFile)
 			return true;
@@ -282,11 +305,42 @@ private:
 };
 
 /**
- * An archive that caches the resulting contents.
+ * Statistics of the contents cache shared by all MemcachingCaseInsensitiveArchive
+ * instances.
+ */
+struct ArchiveCacheStats {
+	uint32 hits;      ///< Streams served from cached contents
+	uint32 misses;    ///< Streams for which the contents had to be read
+	uint32 evictions; ///< Entries dropped to stay within the budget
+	uint32 entries;   ///< Entries currently held by the cache
+	uint32 pinned;    ///< Entries which can't be evicted as streams are open on them
+	uint64 bytesUsed; ///< Total size of the entries held by the cache
+	uint64 budget;    ///< Current budget in bytes
+};
+
+/**
+ * An archive which keeps the contents of the members it extracted in memory,
+ * so that opening them again does not require reading them again.
+ *
+ * The strongly cached contents of all such archives share a single byte
+ * budget, set with the "archive_cache_size" configuration key (in KB).
+ * When it is exceeded, the least recently opened entries are dropped, except
+ * those which still have streams open on them. Dropped contents stay
+ * available for as long as such streams keep them alive.
+ *
+ * The cache is shared between threads and guarded by a single mutex, which
+ * is not held while an archive reads the contents of a member.
  */
 class MemcachingCaseInsensitiveArchive : public Archive {
 public:
+	/**
+	 * @param maxStronglyCachedSize	Members larger than this are never kept in
+	 *                              the cache once their streams are closed,
+	 *                              0 to only rely on the global budget.
+	 */
 	MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize = 512) : _maxStronglyCachedSize(maxStronglyCachedSize) {}
+	~MemcachingCaseInsensitiveArchive();
+
 	SeekableReadStream *createReadStreamForMember(const Path &path) const;
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, Common::AltStreamType altStreamType) const;
 
@@ -297,6 +351,19 @@ public:
 	virtual SharedArchiveContents readContentsForPath(const Path &translatedPath) const = 0;
 	virtual SharedArchiveContents readContentsForPathAltStream(const Path &translatedPath, AltStreamType altStreamType) const;
 
+	/** Return statistics about the contents cache shared by all archives. */
+	static ArchiveCacheStats getCacheStats();
+
+	/** Reset the hit, miss and eviction counters. */
+	static void resetCacheStats();
+
+	/**
+	 * Drop as many cached entries as needed to fit within the current budget.
+	 * This is done automatically whenever new contents get cached, but may be
+	 * called after the budget has been lowered.
+	 */
+	static void enforceCacheBudget();
+
 private:
 	struct CacheKey {
 		CacheKey();
@@ -313,9 +380,38 @@ private:
 		uint operator()(const CacheKey &x) const;
 	};
 
+	struct LRUNode {
+		const MemcachingCaseInsensitiveArchive *archive;
+		CacheKey key;
+		uint32 size;
+	};
+
+	typedef List<LRUNode> LRUList;
+
+	struct CacheEntry {
+		CacheEntry() : inLRU(false) {}
+
+		SharedArchiveContents contents;
+		LRUList::iterator lruNode; ///< Only valid if inLRU is set
+		bool inLRU;                ///< Whether the contents are strongly held and accounted for
+	};
+
 	SeekableReadStream *createReadStreamForMemberImpl(const Path &path, bool isAltStream, Common::AltStreamType altStreamType) const;
+	SeekableReadStream *createCachedStream(const CacheKey &key, CacheEntry &entry) const;
+
+	void addToLRU(const CacheKey &key, CacheEntry &entry) const;
+	void removeFromLRU(CacheEntry &entry) const;
+
+	static Mutex &getCacheMutex();
+	static LRUList &getLRU();
+	static uint64 getCacheBudget();
+	static void trimCache(uint64 budget);
+
+	static uint64 _cacheUsed;
+	static ArchiveCacheStats _cacheStats;
 
-	mutable HashMap<CacheKey, SharedArchiveContents, CacheKey_Hash, CacheKey_EqualTo> _cache;
+	typedef HashMap<CacheKey, CacheEntry, CacheKey_Hash, CacheKey_EqualTo> CacheMap;
+	mutable CacheMap _cache;
 	uint32 _maxStronglyCachedSize;
 };
 
@@ -347,6 +443,50 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	/**
+	 * Archive which has a member, along with its position in the list, so
+	 * that matches from indexed and unindexed archives can be ranked.
+	 */
+	struct IndexEntry {
+		IndexEntry() : arc(nullptr), rank(0) {}
+		IndexEntry(Archive *a, uint r) : arc(a), rank(r) {}
+
+		Archive *arc;
+		uint rank;
+	};
+
+	typedef HashMap<Path, IndexEntry, Path::IgnoreCaseAndMac_Hash, Path::IgnoreCaseAndMac_EqualTo> MemberIndex;
+
+	/**
+	 * Case-folded paths of the members of all archives with a stable member
+	 * list, each mapped to the highest priority archive which has it.
+	 * Archives without a stable member list are still asked for each lookup.
+	 */
+	struct Index {
+		Index(int gen) : generation(gen) {}
+
+		int generation;
+		MemberIndex members;
+		Array<IndexEntry> unindexed; ///< Sorted by rank
+	};
+
+	typedef SharedPtr<Index> IndexPtr;
+
+	mutable IndexPtr _index;
+	mutable Mutex _indexMutex; ///< Guards _index, but not the archives
+
+	/**
+	 * Incremented whenever the contents of any SearchSet change, which
+	 * invalidates the indexes of all sets, including those that contain
+	 * the one that changed.
+	 */
+	static int _generation;
+
+	IndexPtr getIndex() const;
+	IndexPtr buildIndex(int generation) const;
+	Archive *findFile(const Path &path) const;
+	static void invalidateIndexes() { atomicIncrement(_generation); }
+
 public:
 	SearchSet() : _ignoreClashes(false) { }
 	virtual ~SearchSet() { clear(); }
@@ -445,6 +585,7 @@ public:
 
 	bool hasFile(const Path &path) const override;
 	bool isPathDirectory(const Path &path) const override;
+	bool hasStableMemberList() const override;
 	int listMatchingMembers(ArchiveMemberList &list, const Path &pattern, bool matchPathComponents = false) const override;
 	int listMatchingMembers(ArchiveMemberDetailsList &list, const Path &pattern, bool matchPathComponents = false) const;
 	int listMembers(ArchiveMemberList &list) const override;
@@ -453,6 +594,9 @@ public:
 
 	const ArchiveMemberPtr getMember(const Path &path, Archive **container) const;
 
+	/** Return the size recorded by the first archive that has the member. */
+	int64 getMemberSize(const Path &path) const override;
+
 	/**
 	 * Implement createReadStreamForMember from the Archive base class. The current policy is
 	 * opening the first file encountered that matches the name.
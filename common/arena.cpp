@@ -0,0 +1,138 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/arena.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+// Keep the data of each chunk aligned like the allocations made from it
+static const size_t kChunkHeaderSize = (sizeof(void *) + sizeof(size_t) + Arena::kDefaultAlignment - 1) & ~(Arena::kDefaultAlignment - 1);
+
+Arena::Arena(size_t chunkSize) : _chunkSize(chunkSize), _current(nullptr), _pos(nullptr), _end(nullptr) {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+Arena::~Arena() {
+	freeChunks(nullptr);
+}
+
+byte *Arena::chunkData(Chunk *chunk) {
+	return (byte *)chunk + kChunkHeaderSize;
+}
+
+void *Arena::allocate(size_t size, size_t alignment) {
+	assert(alignment && (alignment & (alignment - 1)) == 0);
+
+	byte *ptr = (byte *)(((uintptr)_pos + alignment - 1) & ~(uintptr)(alignment - 1));
+	if (!_current || ptr + size > _end) {
+		addChunk(size + alignment);
+		ptr = (byte *)(((uintptr)_pos + alignment - 1) & ~(uintptr)(alignment - 1));
+	}
+
+	_pos = ptr + size;
+
+	_stats.allocations++;
+	_stats.bytesUsed += size;
+	if (_stats.bytesUsed > _stats.peakBytesUsed)
+		_stats.peakBytesUsed = _stats.bytesUsed;
+
+	return ptr;
+}
+
+void Arena::addChunk(size_t minSize) {
+	size_t size = MAX(_chunkSize, minSize);
+	Chunk *chunk = (Chunk *)malloc(kChunkHeaderSize + size);
+	if (!chunk)
+		error("Arena: could not allocate a chunk of %u bytes", (uint)size);
+
+	chunk->prev = _current;
+	chunk->size = size;
+	_current = chunk;
+	_pos = chunkData(chunk);
+	_end = _pos + size;
+
+	_stats.chunkAllocations++;
+	_stats.capacity += size;
+}
+
+void Arena::freeChunks(Chunk *until) {
+	while (_current != until) {
+		Chunk *prev = _current->prev;
+		_stats.capacity -= _current->size;
+		free(_current);
+		_current = prev;
+	}
+}
+
+void Arena::reset() {
+	_stats.resets++;
+	_stats.bytesUsed = 0;
+
+	if (!_current)
+		return;
+
+	if (_current->prev) {
+		// Replace the chunks by a single one which can hold them all
+		size_t total = _stats.capacity;
+		freeChunks(nullptr);
+		_chunkSize = MAX(_chunkSize, total);
+		addChunk(_chunkSize);
+	}
+
+	_pos = chunkData(_current);
+	_end = _pos + _current->size;
+}
+
+Arena::Mark Arena::getMark() const {
+	Mark mark;
+	mark.chunk = _current;
+	mark.pos = _pos;
+	mark.bytesUsed = _stats.bytesUsed;
+	return mark;
+}
+
+void Arena::rewind(const Mark &mark) {
+	Chunk *chunk = (Chunk *)mark.chunk;
+
+	if (!chunk) {
+		// Nothing had been allocated when the mark was taken: keep
+		// the first chunk around for reuse
+		_stats.bytesUsed = 0;
+		if (!_current)
+			return;
+
+		Chunk *first = _current;
+		while (first->prev)
+			first = first->prev;
+		freeChunks(first);
+		_pos = chunkData(first);
+		_end = _pos + first->size;
+		return;
+	}
+
+	freeChunks(chunk);
+	_pos = mark.pos;
+	_end = chunkData(chunk) + chunk->size;
+	_stats.bytesUsed = mark.bytesUsed;
+}
+
+} // End of namespace Common
@@ -0,0 +1,135 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_arena Arena allocator
+ * @ingroup common_memory
+ *
+ * @brief Region-based allocator for short-lived objects.
+ * @{
+ */
+
+/**
+ * A monotonic buffer: allocations are carved out of large chunks one after
+ * the other and are never freed individually. Instead, the whole arena is
+ * released at once with reset(), or back to an earlier point with rewind().
+ *
+ * This suits objects which share a lifetime, such as everything allocated
+ * while rendering one frame or while a room is loaded. Destructors are not
+ * run by the arena; objects with non-trivial destructors must be destroyed
+ * by their owner before the memory is released.
+ *
+ * The arena grows by adding chunks when it runs out of space. On reset(),
+ * the chunks are merged into a single one large enough for everything that
+ * was allocated, so that a steady workload settles into one chunk.
+ */
+class Arena : NonCopyable {
+public:
+	/** Statistics about the use of an arena. */
+	struct Stats {
+		uint32 allocations;    ///< Number of allocations since creation
+		uint32 chunkAllocations; ///< Number of chunks taken from the system
+		uint32 resets;         ///< Number of calls to reset()
+		size_t bytesUsed;      ///< Bytes handed out since the last reset
+		size_t peakBytesUsed;  ///< Highest value of bytesUsed
+		size_t capacity;       ///< Total size of the chunks currently owned
+	};
+
+	/** A position in the arena, to rewind to with rewind(). */
+	struct Mark {
+		void *chunk;
+		byte *pos;
+		size_t bytesUsed;
+	};
+
+	static const size_t kDefaultAlignment = 16;
+
+	/**
+	 * Create an arena.
+	 * @param chunkSize  Size of the chunks taken from the system. The first
+	 *                   chunk is allocated on the first allocation.
+	 */
+	explicit Arena(size_t chunkSize = 64 * 1024);
+	~Arena();
+
+	/** Allocate @p size bytes aligned on @p alignment, which must be a power of 2. */
+	void *allocate(size_t size, size_t alignment = kDefaultAlignment);
+
+	/** Construct an object of type T in the arena. */
+	template<class T, class... TArgs>
+	T *create(TArgs &&...args) {
+		return new (allocate(sizeof(T), alignof(T))) T(Common::forward<TArgs>(args)...);
+	}
+
+	/** Release all the allocations, keeping the memory for reuse. */
+	void reset();
+
+	/** Return the current position, to release everything allocated after it with rewind(). */
+	Mark getMark() const;
+	/** Release everything allocated after @p mark was taken. */
+	void rewind(const Mark &mark);
+
+	const Stats &getStats() const { return _stats; }
+
+private:
+	struct Chunk {
+		Chunk *prev;
+		size_t size;
+	};
+
+	static byte *chunkData(Chunk *chunk);
+	void addChunk(size_t minSize);
+	void freeChunks(Chunk *until);
+
+	size_t _chunkSize;
+	Chunk *_current;
+	byte *_pos;
+	byte *_end;
+	Stats _stats;
+};
+
+/**
+ * Rewinds an arena to the position it had when the scope was entered.
+ */
+class ArenaScope : NonCopyable {
+public:
+	explicit ArenaScope(Arena &arena) : _arena(arena), _mark(arena.getMark()) {}
+	~ArenaScope() { _arena.rewind(_mark); }
+
+private:
+	Arena &_arena;
+	Arena::Mark _mark;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,137 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+
+#if defined(_MSC_VER) && !defined(DISABLE_ATOMIC_REFCOUNT)
+#include <intrin.h>
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_atomic Atomic reference counts
+ * @ingroup common
+ *
+ * @brief Helpers updating the reference counts of shared objects.
+ *
+ * The counts of String storage and SharedPtr are updated with atomic
+ * operations, so that copies of the same object can be made and dropped
+ * from several threads. Ports which never run code on more than one
+ * thread can define DISABLE_ATOMIC_REFCOUNT to use plain arithmetic.
+ *
+ * SCUMMVM_ATOMIC_REFCOUNT is defined when the counts are atomic.
+ *
+ * @{
+ */
+
+#if !defined(DISABLE_ATOMIC_REFCOUNT)
+#if defined(__GNUC__) && defined(__ATOMIC_ACQ_REL)
+#define SCUMMVM_ATOMIC_REFCOUNT
+
+/** Increment @p count. */
+inline void atomicIncrement(int &count) {
+	__atomic_add_fetch(&count, 1, __ATOMIC_RELAXED);
+}
+
+/** Decrement @p count and return its new value. */
+inline int atomicDecrement(int &count) {
+	return __atomic_sub_fetch(&count, 1, __ATOMIC_ACQ_REL);
+}
+
+/** Return the current value of @p count. */
+inline int atomicLoad(const int &count) {
+	return __atomic_load_n(&count, __ATOMIC_ACQUIRE);
+}
+
+/** Increment @p count unless it is zero. Return true if it was incremented. */
+inline bool atomicIncrementIfNonZero(int &count) {
+	int value = __atomic_load_n(&count, __ATOMIC_RELAXED);
+	while (value != 0) {
+		if (__atomic_compare_exchange_n(&count, &value, value + 1, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			return true;
+	}
+	return false;
+}
+
+#elif defined(_MSC_VER)
+#define SCUMMVM_ATOMIC_REFCOUNT
+
+static_assert(sizeof(long) == sizeof(int), "Interlocked functions operate on long");
+
+inline void atomicIncrement(int &count) {
+	_InterlockedIncrement(reinterpret_cast<volatile long *>(&count));
+}
+
+inline int atomicDecrement(int &count) {
+	return _InterlockedDecrement(reinterpret_cast<volatile long *>(&count));
+}
+
+inline int atomicLoad(const int &count) {
+	return _InterlockedCompareExchange(reinterpret_cast<volatile long *>(const_cast<int *>(&count)), 0, 0);
+}
+
+inline bool atomicIncrementIfNonZero(int &count) {
+	volatile long *target = reinterpret_cast<volatile long *>(&count);
+	long value = *target;
+	while (value != 0) {
+		long previous = _InterlockedCompareExchange(target, value + 1, value);
+		if (previous == value)
+			return true;
+		value = previous;
+	}
+	return false;
+}
+
+#endif
+#endif
+
+#ifndef SCUMMVM_ATOMIC_REFCOUNT
+
+inline void atomicIncrement(int &count) {
+	count++;
+}
+
+inline int atomicDecrement(int &count) {
+	return --count;
+}
+
+inline int atomicLoad(const int &count) {
+	return count;
+}
+
+inline bool atomicIncrementIfNonZero(int &count) {
+	if (count == 0)
+		return false;
+	count++;
+	return true;
+}
+
+#endif
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
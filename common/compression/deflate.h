@@ -151,6 +151,21 @@ SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped,
 		DisposeAfterUse::Flag disposeParent = DisposeAfterUse::YES, uint64 knownSize = 0,
 		const byte *dict = nullptr, uint dictLen = 0);
 
+/**
+ * Same as wrapDeflateReadStream(), but suited for random access into large
+ * streams. While data gets decompressed, the decompressor state is saved at
+ * regular intervals, and seeking resumes from the closest of those points
+ * instead of restarting from the beginning of the stream.
+ *
+ * This needs zlib, the stream returned otherwise is the same as the one
+ * returned by wrapDeflateReadStream().
+ *
+ * @param toBeWrapped	the stream to be wrapped (raw deflate data)
+ * @param knownSize	the length of the uncompressed data
+ */
+SeekableReadStream *wrapSeekableDeflateReadStream(SeekableReadStream *toBeWrapped,
+		DisposeAfterUse::Flag disposeParent = DisposeAfterUse::YES, uint64 knownSize = 0);
+
 /**
  * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
  * provides transparent on-the-fly decompression. Assumes the data it
@@ -95,9 +95,11 @@ typedef Byte Bytef;
 #include "common/compression/deflate.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/substream.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/ptr.h"
 
 #if defined(STRICTUNZIP) || defined(STRICTZIPUNZIP)
 /* like the STRICT of WIN32, we define a pointer that cannot be converted
@@ -237,6 +239,14 @@ Common::SharedArchiveContents unzOpenCurrentFile(unzFile file
   If there is no error, the return value is UNZ_OK.
 */
 
+Common::SeekableReadStream *unzOpenCurrentFileStream(unzFile file);
+/*
+  Open a stream decompressing the current file on the fly, reading from
+  the zipfile stream as needed. The stream keeps the zipfile stream alive,
+  so it may outlive the zipfile. Once all of its data has been read, the
+  CRC32 is checked and err() is set on a mismatch. Returns NULL on error.
+*/
+
 int unzCloseCurrentFile(unzFile file);
 /*
   Close the file in zip opened with unzOpenCurrentFile
@@ -325,6 +335,7 @@ typedef Common::HashMap<Common::Path, cached_file_in_zip, Common::Path::IgnoreCa
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _streamRef; /* owns _stream, shared with the streamed files */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -521,6 +532,8 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		return nullptr;
 	}
 
+	us->_streamRef.reset(us->_stream);
+
 	us->byte_before_the_zipfile = central_pos -
 		                    (us->offset_central_dir + us->size_central_dir);
 	us->central_pos = central_pos;
@@ -606,7 +619,7 @@ int unzClose(unzFile file) {
 		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
 
-	delete s->_stream;
+	// The stream itself goes away with the last streamed file
 	delete s;
 	return UNZ_OK;
 }
@@ -1024,9 +1037,117 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	return Common::SharedArchiveContents(uncompressedBuffer, s->cur_file_info.uncompressed_size);
 }
 
+/*
+  A file decompressed on the fly. It holds a reference to the zipfile stream,
+  and computes the CRC32 of the data as it gets read. Reading again after
+  seeking back doesn't affect it, but data skipped by seeking forward is only
+  accounted for once it is actually read.
+*/
+class ZipStreamedFile : public Common::SeekableReadStream {
+public:
+	ZipStreamedFile(Common::SeekableReadStream *parentStream, const Common::SharedPtr<Common::SeekableReadStream> &zipStream, uint32 expectedCrc) :
+		_parentStream(parentStream), _zipStream(zipStream), _expectedCrc(expectedCrc), _crcPos(0), _crcMismatch(false) {
+#ifndef USE_ZLIB
+		_crcValue = _crc.getInitRemainder();
+#else
+		_crcValue = crc32(0, Z_NULL, 0);
+#endif
+	}
+
+	~ZipStreamedFile() override {
+		// The zipfile stream must outlive the decompressor reading from it
+		delete _parentStream;
+	}
+
+	bool err() const override { return _crcMismatch || _parentStream->err(); }
+	void clearErr() override { _parentStream->clearErr(); }
+	bool eos() const override { return _parentStream->eos(); }
+
+	int64 pos() const override { return _parentStream->pos(); }
+	int64 size() const override { return _parentStream->size(); }
+	bool seek(int64 offset, int whence = SEEK_SET) override { return _parentStream->seek(offset, whence); }
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		int64 start = _parentStream->pos();
+		uint32 len = _parentStream->read(dataPtr, dataSize);
+
+		if (start <= _crcPos && start + len > _crcPos) {
+			const byte *data = (const byte *)dataPtr + (_crcPos - start);
+			uint32 count = start + len - _crcPos;
+#ifndef USE_ZLIB
+			for (uint32 i = 0; i < count; i++)
+				_crcValue = _crc.processByte(data[i], _crcValue);
+#else
+			_crcValue = crc32(_crcValue, data, count);
+#endif
+			_crcPos += count;
+
+			if (_crcPos == size()) {
+#ifndef USE_ZLIB
+				uint32 crcValue = _crc.finalize(_crcValue);
+#else
+				uint32 crcValue = _crcValue;
+#endif
+				if (crcValue != _expectedCrc) {
+					warning("CRC32 mismatch: %08x, %08x", crcValue, _expectedCrc);
+					_crcMismatch = true;
+				}
+			}
+		}
+
+		return len;
+	}
+
+private:
+	Common::SeekableReadStream *_parentStream;
+	Common::SharedPtr<Common::SeekableReadStream> _zipStream;
+#ifndef USE_ZLIB
+	Common::CRC32 _crc;
+#endif
+	uint32 _crcValue;
+	uint32 _expectedCrc;
+	int64 _crcPos;   ///< Amount of data accounted for in _crcValue
+	bool _crcMismatch;
+};
+
+Common::SeekableReadStream *unzOpenCurrentFileStream(unzFile file) {
+	uInt iSizeVar;
+	unz_s *s;
+	uLong offset_local_extrafield;  /* offset of the local extra field */
+	uInt  size_local_extrafield;    /* size of the local extra field */
+
+	if (file == nullptr)
+		return nullptr;
+	s = (unz_s *)file;
+	if (!s->current_file_ok)
+		return nullptr;
+
+	if (unzlocal_CheckCurrentFileCoherencyHeader(s, &iSizeVar,
+				&offset_local_extrafield, &size_local_extrafield) != UNZ_OK)
+		return nullptr;
+
+	uint32 begin = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar;
+	Common::SeekableReadStream *data = new Common::SafeSeekableSubReadStream(s->_stream, begin, begin + s->cur_file_info.compressed_size);
+
+	switch (s->cur_file_info.compression_method) {
+	case 0: // Store
+		return new ZipStreamedFile(data, s->_streamRef, s->cur_file_info.crc);
+	case Z_DEFLATED:
+		data = Common::wrapSeekableDeflateReadStream(data, DisposeAfterUse::YES, s->cur_file_info.uncompressed_size);
+		return new ZipStreamedFile(data, s->_streamRef, s->cur_file_info.crc);
+	default:
+		warning("Unknown compression algoritthm %d", (int)s->cur_file_info.compression_method);
+		delete data;
+		return nullptr;
+	}
+}
+
 
 namespace Common {
 
+// Members at least this large are decompressed on the fly instead of being
+// fully extracted to memory when opened
+static const uint32 kZipStreamingThreshold = 4 * 1024 * 1024;
 
 class ZipArchive : public MemcachingCaseInsensitiveArchive {
 	unzFile _zipFile;
@@ -1044,7 +1165,9 @@ public:
 	bool hasFile(const Path &path) const override;
 	bool isPathDirectory(const Path &path) const override;
 	int listMembers(ArchiveMemberList &list) const override;
+	bool hasStableMemberList() const override { return true; }
 	const ArchiveMemberPtr getMember(const Path &path) const override;
+	int64 getMemberSize(const Path &path) const override;
 	Common::SharedArchiveContents readContentsForPath(const Common::Path &translated) const override;
 	Common::Path translatePath(const Common::Path &path) const override {
 		return _flattenTree ? path.getLastComponent() : path;
@@ -1111,9 +1234,29 @@ const ArchiveMemberPtr ZipArchive::getMember(const Path &path) const {
 	return ArchiveMemberPtr(new GenericArchiveMember(path, *this));
 }
 
+int64 ZipArchive::getMemberSize(const Path &path) const {
+	if (unzLocateFile(_zipFile, path, 2) != UNZ_OK)
+		return -1;
+
+	unz_file_info fi;
+	if (unzGetCurrentFileInfo(_zipFile, &fi, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
+		return -1;
+
+	return fi.uncompressed_size;
+}
+
 Common::SharedArchiveContents ZipArchive::readContentsForPath(const Common::Path &path) const {
 	if (unzLocateFile(_zipFile, path, 2) != UNZ_OK)
 		return Common::SharedArchiveContents();
+
+	// Large members are streamed. Their CRC is checked as they get read.
+	unz_file_info fi;
+	if (unzGetCurrentFileInfo(_zipFile, &fi, nullptr, 0, nullptr, 0, nullptr, 0) == UNZ_OK && fi.uncompressed_size >= kZipStreamingThreshold) {
+		Common::SeekableReadStream *stream = unzOpenCurrentFileStream(_zipFile);
+		if (stream)
+			return Common::SharedArchiveContents::bypass(stream);
+	}
+
 #ifndef USE_ZLIB
 	return unzOpenCurrentFile(_zipFile, _crc);
 #else
@@ -33,6 +33,7 @@
 
 #include "common/compression/deflate.h"
 
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -110,9 +111,73 @@ protected:
 	uint32 _origSize;
 	bool _eos;
 
+	/**
+	 * Decompressor state at a deflate block boundary, from which decoding
+	 * can be resumed without going through the preceding data.
+	 */
+	struct Checkpoint {
+		uint32 outPos;      ///< Position in the decompressed data
+		uint32 inPos;       ///< Offset of the first byte of the block in the compressed data
+		byte bits;          ///< Number of bits of the previous byte belonging to the block
+		uint16 windowSize;
+		byte *window;       ///< Last decompressed bytes, up to 32 KB
+	};
+
+	// Checkpoints are only recorded for raw deflate streams, in increasing
+	// order of position, while data gets decompressed for the first time.
+	Array<Checkpoint> _checkpoints;
+	uint32 _checkpointSpan; ///< Minimum distance between checkpoints, 0 if disabled
+	uint32 _indexedSize;    ///< Amount of decompressed data covered by checkpoints
+
+	void addCheckpoint(uint32 outPos) {
+#if ZLIB_VERNUM >= 0x1280
+		Checkpoint cp;
+		cp.outPos = outPos;
+		cp.inPos = _wrapped->pos() - _parentPos - _stream.avail_in;
+		cp.bits = _stream.data_type & 7;
+		cp.window = new byte[1 << MAX_WBITS];
+		uInt windowSize = 0;
+		if (inflateGetDictionary(&_stream, cp.window, &windowSize) != Z_OK) {
+			delete[] cp.window;
+			_checkpointSpan = 0;
+			return;
+		}
+		cp.windowSize = windowSize;
+		_checkpoints.push_back(cp);
+#endif
+	}
+
+	bool restoreCheckpoint(const Checkpoint &cp) {
+#if ZLIB_VERNUM >= 0x1280
+		_zlibErr = inflateReset(&_stream);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		// A block may start in the middle of a byte
+		_wrapped->seek(_parentPos + cp.inPos - (cp.bits ? 1 : 0), SEEK_SET);
+		if (cp.bits) {
+			byte partial = _wrapped->readByte();
+			_zlibErr = inflatePrime(&_stream, cp.bits, partial >> (8 - cp.bits));
+			if (_zlibErr != Z_OK)
+				return false;
+		}
+
+		_zlibErr = inflateSetDictionary(&_stream, cp.window, cp.windowSize);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		_pos = cp.outPos;
+		return true;
+#else
+		return false;
+#endif
+	}
+
 public:
 
-	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize) : _wrapped(w, disposeParent), _stream() {
+	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize) : _wrapped(w, disposeParent), _stream(), _checkpointSpan(0), _indexedSize(0) {
 		assert(w != nullptr);
 
 		_parentPos = w->pos();
@@ -148,7 +213,8 @@ public:
 		_stream.avail_in = 0;
 	}
 
-	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize, const byte *dict, uint dictLen) : _wrapped(w, disposeParent), _stream() {
+	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize, const byte *dict, uint dictLen, uint32 checkpointSpan = 0) :
+			_wrapped(w, disposeParent), _stream(), _checkpointSpan(checkpointSpan), _indexedSize(0) {
 		assert(w != nullptr);
 
 		_parentPos = w->pos();
@@ -177,6 +243,8 @@ public:
 
 	~GZipReadStream() {
 		inflateEnd(&_stream);
+		for (auto &cp : _checkpoints)
+			delete[] cp.window;
 	}
 
 	bool err() const override { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
@@ -196,7 +264,24 @@ public:
 				_stream.next_in = _buf;
 				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
 			}
-			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+
+			if (!_checkpointSpan || _pos + (dataSize - _stream.avail_out) < _indexedSize) {
+				_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+				if (_checkpointSpan)
+					_indexedSize = MAX(_indexedSize, _pos + (dataSize - _stream.avail_out));
+				continue;
+			}
+
+			// Decompressing new data: stop at block boundaries, so that
+			// checkpoints can be taken there.
+			_zlibErr = inflate(&_stream, Z_BLOCK);
+			uint32 outPos = _pos + (dataSize - _stream.avail_out);
+			_indexedSize = MAX(_indexedSize, outPos);
+			if (_zlibErr == Z_OK && (_stream.data_type & 128) && !(_stream.data_type & 64)) {
+				uint32 lastPos = _checkpoints.empty() ? 0 : _checkpoints.back().outPos;
+				if (outPos >= lastPos + _checkpointSpan)
+					addCheckpoint(outPos);
+			}
 		}
 
 		// Update the position counter
@@ -236,6 +321,25 @@ public:
 
 		assert(newPos >= 0);
 
+		// Resume from the closest checkpoint before the target, if that
+		// saves going backward or decompressing data we don't need.
+		if (!_checkpoints.empty()) {
+			uint lo = 0, hi = _checkpoints.size();
+			while (hi - lo > 1) {
+				uint mid = (lo + hi) / 2;
+				if (_checkpoints[mid].outPos <= (uint32)newPos)
+					lo = mid;
+				else
+					hi = mid;
+			}
+
+			const Checkpoint &cp = _checkpoints[lo];
+			if (cp.outPos <= (uint32)newPos && (cp.outPos > _pos || (uint32)newPos < _pos)) {
+				if (!restoreCheckpoint(cp))
+					return false;
+			}
+		}
+
 		if ((uint32)newPos < _pos) {
 			// To search backward, we have to restart the whole decompression
 			// from the start of the file. A rather wasteful operation, best
@@ -422,6 +526,24 @@ SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, Dispo
 	return new GZipReadStream(toBeWrapped, disposeParent, knownSize, dict, dictLen);
 }
 
+SeekableReadStream *wrapSeekableDeflateReadStream(SeekableReadStream *toBeWrapped, DisposeAfterUse::Flag disposeParent, uint64 knownSize) {
+	if (!toBeWrapped) {
+		return nullptr;
+	}
+
+	if (toBeWrapped->eos() || toBeWrapped->err()) {
+		if (disposeParent == DisposeAfterUse::YES) {
+			delete toBeWrapped;
+		}
+		return nullptr;
+	}
+
+	// Each checkpoint costs up to 32 KB, so space them at least 1 MB apart,
+	// and keep no more than about 256 of them for huge streams.
+	uint32 span = MAX<uint32>(1024 * 1024, (uint32)(knownSize / 256));
+	return new GZipReadStream(toBeWrapped, disposeParent, knownSize, nullptr, 0, span);
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 	if (!toBeWrapped)
 		return nullptr;
@@ -50,7 +50,7 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _lastFlushedValid(false), _flushScheduled(false), _flushDeadline(0) {
 }
 
 void ConfigManager::defragment() {
@@ -75,6 +75,10 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	_lastFlushed = source._lastFlushed;
+	_lastFlushedValid = source._lastFlushedValid;
+	_flushScheduled = source._flushScheduled;
+	_flushDeadline = source._flushDeadline;
 }
 
 
@@ -189,6 +193,9 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	_cloudDomain.clear();
 #endif
 
+	// The file on disk may differ from what we wrote last
+	_lastFlushedValid = false;
+
 	// TODO: Detect if a domain occurs multiple times (or likewise, if
 	// a key occurs multiple times inside one domain).
 
@@ -285,6 +292,15 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
+	_flushScheduled = false;
+
+	String contents;
+	serialize(contents);
+
+	// Rewriting the file with the same contents is pointless
+	if (_lastFlushedValid && contents == _lastFlushed)
+		return;
+
 	WriteStream *stream;
 
 	if (_filename.empty()) {
@@ -306,42 +322,83 @@ void ConfigManager::flushToDisk() {
 		stream = dump;
 	}
 
+	stream->write(contents.c_str(), contents.size());
+	stream->finalize();
+	bool success = !stream->err();
+
+	delete stream;
+
+	if (success) {
+		_lastFlushed = contents;
+		_lastFlushedValid = true;
+	}
+
+#endif // !__DC__
+}
+
+void ConfigManager::scheduleFlushToDisk() {
+	// Keep the first deadline, so that a steady stream of requests
+	// cannot postpone the write indefinitely
+	if (_flushScheduled)
+		return;
+
+	assert(g_system);
+	_flushScheduled = true;
+	_flushDeadline = g_system->getMillis() + 1000;
+}
+
+void ConfigManager::processScheduledFlush(bool force) {
+	if (!_flushScheduled)
+		return;
+
+	if (!force && (int32)(g_system->getMillis() - _flushDeadline) < 0)
+		return;
+
+	flushToDisk();
+}
+
+void ConfigManager::saveToStream(WriteStream &stream) const {
+	String contents;
+	serialize(contents);
+	stream.write(contents.c_str(), contents.size());
+}
+
+void ConfigManager::serialize(String &out) const {
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(out, kApplicationDomain, _appDomain);
 
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(out, kKeymapperDomain, _keymapperDomain);
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(out, kCloudDomain, _cloudDomain);
 #endif
 
 	// Write the miscellaneous domains next
 	for (const auto &misc : _miscDomains) {
-		writeDomain(*stream, misc._key, misc._value);
+		writeDomain(out, misc._key, misc._value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
 	// Note: It's possible for _domainSaveOrder to list domains which
 	// are not present anymore, so we validate each name.
+	HashMap<String, bool, IgnoreCase_Hash, IgnoreCase_EqualTo> written;
 	for (const auto &domain : _domainSaveOrder) {
-		if (_gameDomains.contains(domain)) {
-			writeDomain(*stream, domain, _gameDomains[domain]);
+		DomainMap::const_iterator it = _gameDomains.find(domain);
+		if (it != _gameDomains.end() && !written.contains(domain)) {
+			writeDomain(out, domain, it->_value);
+			written[domain] = true;
 		}
 	}
 
 	// Now write the domains which haven't been written yet
-	for (auto &domain : _gameDomains) {
-		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), domain._key) == _domainSaveOrder.end())
-			writeDomain(*stream, domain._key, domain._value);
+	for (const auto &domain : _gameDomains) {
+		if (!written.contains(domain._key))
+			writeDomain(out, domain._key, domain._value);
 	}
-
-	delete stream;
-
-#endif // !__DC__
 }
 
-void ConfigManager::writeDomain(WriteStream &stream, const String &name, const Domain &domain) {
+void ConfigManager::writeDomain(String &out, const String &name, const Domain &domain) const {
 	if (domain.empty())
 		return; // Don't bother writing empty domains.
 
@@ -351,35 +408,17 @@ void ConfigManager::writeDomain(WriteStream &stream, const String &name, const D
 	if (domain.contains("id_came_from_command_line"))
 		return;
 
-	String comment;
-
 	// Write domain comment (if any)
-	comment = domain.getDomainComment();
-	if (!comment.empty())
-		stream.writeString(comment);
+	out += domain.getDomainComment();
 
 	// Write domain start
-	stream.writeByte('[');
-	stream.writeString(name);
-	stream.writeByte(']');
-	stream.writeByte('\n');
+	out += '[';
+	out += name;
+	out += "]\n";
 
 	// Write all key/value pairs in this domain, including comments
-	for (const auto &x : domain) {
-		if (!x._value.empty()) {
-			// Write comment (if any)
-			if (domain.hasKVComment(x._key)) {
-				comment = domain.getKVComment(x._key);
-				stream.writeString(comment);
-			}
-			// Write the key/value pair
-			stream.writeString(x._key);
-			stream.writeByte('=');
-			stream.writeString(x._value);
-			stream.writeByte('\n');
-		}
-	}
-	stream.writeByte('\n');
+	out += domain.getSerializedEntries();
+	out += '\n';
 }
 
 
@@ -806,6 +845,7 @@ bool ConfigManager::isKeyTemporary(const String &key) const {
 #pragma mark -
 
 void ConfigManager::Domain::setDomainComment(const String &comment) {
+	invalidate();
 	_domainComment = comment;
 }
 const String &ConfigManager::Domain::getDomainComment() const {
@@ -813,6 +853,7 @@ const String &ConfigManager::Domain::getDomainComment() const {
 }
 
 void ConfigManager::Domain::setKVComment(const String &key, const String &comment) {
+	invalidate();
 	_keyValueComments[key] = comment;
 }
 const String &ConfigManager::Domain::getKVComment(const String &key) const {
@@ -822,4 +863,27 @@ bool ConfigManager::Domain::hasKVComment(const String &key) const {
 	return _keyValueComments.contains(key);
 }
 
+const String &ConfigManager::Domain::getSerializedEntries() const {
+	if (_serializedValid)
+		return _serialized;
+
+	_serialized.clear();
+	for (const auto &x : _entries) {
+		if (!x._value.empty()) {
+			// Write comment (if any)
+			StringMap::const_iterator comment = _keyValueComments.find(x._key);
+			if (comment != _keyValueComments.end())
+				_serialized += comment->_value;
+
+			// Write the key/value pair
+			_serialized += x._key;
+			_serialized += '=';
+			_serialized += x._value;
+			_serialized += '\n';
+		}
+	}
+	_serializedValid = true;
+	return _serialized;
+}
+
 } // End of namespace Common
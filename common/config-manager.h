@@ -62,6 +62,12 @@ public:
 		StringMap _keyValueComments;
 		String _domainComment;
 
+		// Serialized key/value lines, rebuilt lazily after a modification
+		mutable String _serialized;
+		mutable bool _serializedValid = false;
+
+		void invalidate() { _serializedValid = false; }
+
 	public:
 		typedef StringMap::const_iterator const_iterator;
 		const_iterator begin() const { return _entries.begin(); } /*!< Return the beginning position of configuration entries. */
@@ -76,13 +82,13 @@ public:
 		 */
 		const String &operator[](const String &key) const { return _entries[key]; }
 
-		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
+		void           setVal(const String &key, const String &value) { invalidate(); _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
 
 		/** Return the configuration value for the given key.
 		 *  If no entry exists for the given key in the configuration, it is created.
 		 */
-		String &getOrCreateVal(const String &key) { return _entries.getOrCreateVal(key); }
-		String        &getVal(const String &key) { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
+		String &getOrCreateVal(const String &key) { invalidate(); return _entries.getOrCreateVal(key); }
+		String        &getVal(const String &key) { invalidate(); return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
 		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< @overload */
 		 /**
 		  * Retrieve the value of @p key if it exists and leave the referenced variable unchanged if the key does not exist.
@@ -92,9 +98,9 @@ public:
 		bool tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(key, out); }
 		const String &getValOrDefault(const String &key) const { return _entries.getValOrDefault(key); }
 
-		void           clear() { _entries.clear(); } /*!< Clear all configuration entries in the domain. */
+		void           clear() { invalidate(); _entries.clear(); } /*!< Clear all configuration entries in the domain. */
 
-		void           erase(const String &key) { _entries.erase(key); } /*!< Remove a key from the domain. */
+		void           erase(const String &key) { invalidate(); _entries.erase(key); } /*!< Remove a key from the domain. */
 
 		void           setDomainComment(const String &comment); /*!< Add a @p comment for this configuration domain. */
 		const String  &getDomainComment() const; /*!< Retrieve the comment of this configuration domain. */
@@ -102,6 +108,13 @@ public:
 		void           setKVComment(const String &key, const String &comment); /*!< Add a key-value @p comment to a @p key. */
 		const String  &getKVComment(const String &key) const; /*!< Retrieve the key-value comment of a @p key. */
 		bool           hasKVComment(const String &key) const; /*!< Check whether a @p key has a key-value comment. */
+
+		/**
+		 * Return the key/value lines of this domain (including their comments)
+		 * as they are written to the configuration file. The text is cached
+		 * until the domain is modified.
+		 */
+		const String  &getSerializedEntries() const;
 	};
 
 	/** A hash map of existing configuration domains. */
@@ -200,7 +213,23 @@ public:
 	void                     registerDefault(const String &key, bool value); /*!< @overload */
 	void                     registerDefault(const String &key, const Path &value); /*!< @overload */
 
-	void                     flushToDisk(); /*!< Flush configuration to disk. */
+	void                     flushToDisk(); /*!< Flush configuration to disk. Nothing is written if the configuration is unchanged since the last flush. */
+
+	/**
+	 * Request a flush of the configuration to disk. Requests made in quick
+	 * succession are coalesced into one write, performed by processScheduledFlush()
+	 * once the delay has expired.
+	 */
+	void                     scheduleFlushToDisk();
+	/**
+	 * Perform a flush requested with scheduleFlushToDisk() if its delay has expired,
+	 * or immediately if @p force is true. This is called from the event loop and
+	 * on shutdown.
+	 */
+	void                     processScheduledFlush(bool force = false);
+
+	bool                     loadFromStream(SeekableReadStream &stream); /*!< Replace the configuration with the contents of @p stream. */
+	void                     saveToStream(WriteStream &stream) const; /*!< Write the configuration to @p stream in the configuration file format. */
 
 	void                     setActiveDomain(const String &domName); /*!< Set the given domain as active. */
 	Domain                  *getActiveDomain() { return _activeDomain; } /*!< Get the active domain. */
@@ -234,9 +263,9 @@ private:
 	ConfigManager();
 
 	bool			loadFallbackConfigFile(const Path &filename);
-	bool			loadFromStream(SeekableReadStream &stream);
 	void			addDomain(const String &domainName, const Domain &domain);
-	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
+	void			serialize(String &out) const;
+	void			writeDomain(String &out, const String &name, const Domain &domain) const;
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
 
 	Domain			_transientDomain;
@@ -259,6 +288,12 @@ private:
 	Domain *		_activeDomain;
 
 	Path			_filename;
+
+	String			_lastFlushed;
+	bool			_lastFlushedValid;
+
+	bool			_flushScheduled;
+	uint32			_flushDeadline;
 };
 
 /** @} */
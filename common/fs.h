@@ -252,6 +252,17 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Return the time the object referred by this node was last modified.
+	 *
+	 * This is only meant to compare it with an earlier value for the same
+	 * object, to find out whether it changed.
+	 *
+	 * @return The modification time in seconds since an arbitrary epoch,
+	 *         or 0 if it is unknown or not supported by the backend.
+	 */
+	int64 getModificationTime() const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -433,6 +444,12 @@ public:
 	 */
 	int listMembers(ArchiveMemberList &list) const override;
 
+	/**
+	 * The cache is never refreshed, so the files listed stay the same, unless
+	 * directories are listed as well.
+	 */
+	bool hasStableMemberList() const override { return !_includeDirectories; }
+
 	/**
 	 * Get an ArchiveMember representation of the specified file. A full match of relative
 	 * path and file name is needed for success.
@@ -0,0 +1,77 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/interned-str.h"
+
+namespace Common {
+
+InternedString::InternedString(const String &str) {
+	*this = AtomTable::getDefault().intern(str);
+}
+
+InternedString::InternedString(const String &str, AtomTable &table) {
+	*this = table.intern(str);
+}
+
+const String &InternedString::toString() const {
+	static const String empty;
+	return _atom ? _atom->str : empty;
+}
+
+AtomTable::AtomTable(bool ignoreCase) : _ignoreCase(ignoreCase) {
+}
+
+AtomTable::~AtomTable() {
+	for (auto &atom : _atoms)
+		delete atom._value;
+	for (auto &atom : _atomsIgnoreCase)
+		delete atom._value;
+}
+
+InternedString AtomTable::intern(const String &str) {
+	Atom *&atom = _ignoreCase ? _atomsIgnoreCase.getOrCreateVal(str) : _atoms.getOrCreateVal(str);
+	if (!atom) {
+		atom = new Atom;
+		atom->str = str;
+		atom->hash = _ignoreCase ? hashit_lower(str) : str.hash();
+	}
+	return InternedString(atom);
+}
+
+InternedString AtomTable::find(const String &str) const {
+	Atom *atom = nullptr;
+	if (_ignoreCase)
+		_atomsIgnoreCase.tryGetVal(str, atom);
+	else
+		_atoms.tryGetVal(str, atom);
+	return InternedString(atom);
+}
+
+uint AtomTable::size() const {
+	return _ignoreCase ? _atomsIgnoreCase.size() : _atoms.size();
+}
+
+AtomTable &AtomTable::getDefault() {
+	static AtomTable table;
+	return table;
+}
+
+} // End of namespace Common
@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_INTERNED_STR_H
+#define COMMON_INTERNED_STR_H
+
+#include "common/hash-str.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_interned_str Interned strings
+ * @ingroup common_str
+ *
+ * @brief Atom table and the interned string type it hands out.
+ *
+ * @{
+ */
+
+class AtomTable;
+
+/**
+ * A handle to a string stored once in an AtomTable.
+ *
+ * Two interned strings from the same table are equal if and only if they
+ * refer to the same atom, so comparison is a pointer comparison, and the
+ * hash of the string is computed once when it is interned. This makes
+ * interned strings cheap HashMap keys for tables which are looked up by
+ * name over and over, such as the symbol tables of script interpreters.
+ *
+ * Interned strings from different tables must not be mixed.
+ */
+class InternedString {
+	friend class AtomTable;
+
+public:
+	/** Construct a null interned string, which is not equal to any interned string. */
+	InternedString() : _atom(nullptr) {}
+
+	/** Intern @p str in the default (case-sensitive) atom table. */
+	explicit InternedString(const String &str);
+
+	/** Intern @p str in @p table. */
+	InternedString(const String &str, AtomTable &table);
+
+	bool isNull() const { return _atom == nullptr; } /*!< Return true if this does not refer to any string. */
+
+	const String &toString() const; /*!< Return the interned string, as first spelled when interned. */
+	const char *c_str() const { return toString().c_str(); } /*!< Return the interned string as a C string. */
+
+	uint hash() const { return _atom ? _atom->hash : 0; } /*!< Return the cached hash of the string. */
+
+	bool operator==(const InternedString &x) const { return _atom == x._atom; }
+	bool operator!=(const InternedString &x) const { return _atom != x._atom; }
+
+private:
+	struct Atom {
+		String str;
+		uint hash;
+	};
+
+	explicit InternedString(const Atom *atom) : _atom(atom) {}
+
+	const Atom *_atom;
+};
+
+/**
+ * Specialization of the Hash functor returning the hash cached in the atom.
+ */
+template<>
+struct Hash<InternedString> {
+	uint operator()(const InternedString &s) const {
+		return s.hash();
+	}
+};
+
+/**
+ * A table of unique strings.
+ *
+ * Atoms live as long as the table which created them. A table can be made
+ * case-insensitive, in which case strings differing only by case are
+ * interned as the same atom, keeping the spelling seen first.
+ */
+class AtomTable : NonCopyable {
+public:
+	explicit AtomTable(bool ignoreCase = false);
+	~AtomTable();
+
+	/** Return the atom for @p str, adding it to the table if needed. */
+	InternedString intern(const String &str);
+
+	/**
+	 * Return the atom for @p str without adding it to the table.
+	 * If @p str was never interned, a null interned string is returned; it
+	 * compares unequal to all keys, so lookups of unknown names stay cheap
+	 * and do not grow the table.
+	 */
+	InternedString find(const String &str) const;
+
+	uint size() const; /*!< Return the number of atoms in the table. */
+	bool isIgnoreCase() const { return _ignoreCase; } /*!< Return true if this table ignores case. */
+
+	static AtomTable &getDefault(); /*!< Return the process-wide case-sensitive table. */
+
+private:
+	typedef InternedString::Atom Atom;
+
+	HashMap<String, Atom *> _atoms;
+	HashMap<String, Atom *, IgnoreCase_Hash, IgnoreCase_EqualTo> _atomsIgnoreCase;
+	bool _ignoreCase;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
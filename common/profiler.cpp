@@ -0,0 +1,231 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The profiler reads the high resolution clock of the C++ library
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/profiler.h"
+
+#ifdef USE_ZONE_PROFILER
+
+#include <chrono>
+
+#include "common/stream.h"
+#include "common/str.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(ZoneProfiler);
+
+// Keep captures to a bounded size, about 32MB
+static const uint kMaxCapturedEvents = 1024 * 1024;
+
+static uint32 g_nextThreadId = 0;
+
+// Must be called with the profiler mutex held
+static uint32 getThreadId() {
+	static thread_local uint32 threadId = 0;
+	if (!threadId)
+		threadId = ++g_nextThreadId;
+	return threadId;
+}
+
+ProfileZoneInfo::ProfileZoneInfo(const char *zoneName) : name(zoneName), calls(0), totalNanos(0), maxNanos(0),
+	frameCalls(0), frameNanos(0), lastFrameCalls(0), lastFrameNanos(0), next(nullptr) {
+	ZoneProfiler::instance().registerZone(this);
+}
+
+ProfileCounterInfo::ProfileCounterInfo(const char *counterName) : name(counterName), value(0), next(nullptr) {
+	ZoneProfiler::instance().registerCounter(this);
+}
+
+ZoneProfiler::ZoneProfiler() : _zones(nullptr), _counters(nullptr), _capturing(false), _captureStart(0),
+	_frameCount(0), _lastFrameNanos(0) {
+	_frameStart = getNanos();
+}
+
+uint64 ZoneProfiler::getNanos() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ZoneProfiler::registerZone(ProfileZoneInfo *zone) {
+	StackLock lock(_mutex);
+	zone->next = _zones;
+	_zones = zone;
+}
+
+void ZoneProfiler::registerCounter(ProfileCounterInfo *counter) {
+	StackLock lock(_mutex);
+	counter->next = _counters;
+	_counters = counter;
+}
+
+void ZoneProfiler::endZone(ProfileZoneInfo *zone, uint64 start, uint64 end) {
+	uint64 duration = end - start;
+
+	StackLock lock(_mutex);
+	zone->calls++;
+	zone->totalNanos += duration;
+	zone->maxNanos = MAX(zone->maxNanos, duration);
+	zone->frameCalls++;
+	zone->frameNanos += duration;
+
+	if (_capturing) {
+		// Zones which were already open when the capture started, like the
+		// one around the console command starting it, are cut at its start
+		uint64 eventStart = MAX(start, _captureStart);
+
+		Event event;
+		event.name = zone->name;
+		event.start = eventStart;
+		event.duration = end > eventStart ? end - eventStart : 0;
+		event.thread = getThreadId();
+		event.isCounter = false;
+		addEvent(event);
+	}
+}
+
+void ZoneProfiler::setCounter(ProfileCounterInfo *counter, int64 value) {
+	StackLock lock(_mutex);
+	counter->value = value;
+
+	if (_capturing) {
+		Event event;
+		event.name = counter->name;
+		event.start = getNanos();
+		event.duration = (uint64)value;
+		event.thread = getThreadId();
+		event.isCounter = true;
+		addEvent(event);
+	}
+}
+
+void ZoneProfiler::addEvent(const Event &event) {
+	if (_events.size() >= kMaxCapturedEvents) {
+		warning("ZoneProfiler: capture buffer full, stopping the capture");
+		_capturing = false;
+		return;
+	}
+	_events.push_back(event);
+}
+
+void ZoneProfiler::endFrame() {
+	uint64 now = getNanos();
+
+	StackLock lock(_mutex);
+	for (ProfileZoneInfo *zone = _zones; zone; zone = zone->next) {
+		zone->lastFrameCalls = zone->frameCalls;
+		zone->lastFrameNanos = zone->frameNanos;
+		zone->frameCalls = 0;
+		zone->frameNanos = 0;
+	}
+
+	_lastFrameNanos = now - _frameStart;
+	_frameStart = now;
+	_frameCount++;
+}
+
+void ZoneProfiler::startCapture() {
+	StackLock lock(_mutex);
+	_events.clear();
+	_captureStart = getNanos();
+	_capturing = true;
+}
+
+void ZoneProfiler::stopCapture() {
+	StackLock lock(_mutex);
+	_capturing = false;
+}
+
+bool ZoneProfiler::isCapturing() const {
+	StackLock lock(_mutex);
+	return _capturing;
+}
+
+uint ZoneProfiler::getCapturedEventCount() const {
+	StackLock lock(_mutex);
+	return _events.size();
+}
+
+void ZoneProfiler::getStats(Array<ProfileZoneInfo> &zones, Array<ProfileCounterInfo> &counters) const {
+	StackLock lock(_mutex);
+
+	zones.clear();
+	for (const ProfileZoneInfo *zone = _zones; zone; zone = zone->next) {
+		zones.push_back(*zone);
+		zones.back().next = nullptr;
+	}
+
+	counters.clear();
+	for (const ProfileCounterInfo *counter = _counters; counter; counter = counter->next) {
+		counters.push_back(*counter);
+		counters.back().next = nullptr;
+	}
+}
+
+uint32 ZoneProfiler::getFrameCount() const {
+	StackLock lock(_mutex);
+	return _frameCount;
+}
+
+uint64 ZoneProfiler::getLastFrameNanos() const {
+	StackLock lock(_mutex);
+	return _lastFrameNanos;
+}
+
+void ZoneProfiler::resetStats() {
+	StackLock lock(_mutex);
+	for (ProfileZoneInfo *zone = _zones; zone; zone = zone->next) {
+		zone->calls = 0;
+		zone->totalNanos = 0;
+		zone->maxNanos = 0;
+	}
+	_frameCount = 0;
+}
+
+bool ZoneProfiler::writeChromeTrace(WriteStream &stream) {
+	StackLock lock(_mutex);
+
+	stream.writeString("{\"traceEvents\":[\n");
+	for (uint i = 0; i < _events.size(); i++) {
+		const Event &event = _events[i];
+		// Timestamps are in microseconds
+		double ts = (event.start - _captureStart) / 1000.0;
+		String line;
+		if (event.isCounter)
+			line = String::format("{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"value\":%lld}}",
+			                      event.name, ts, event.thread, (long long)(int64)event.duration);
+		else
+			line = String::format("{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+			                      event.name, ts, event.duration / 1000.0, event.thread);
+		if (i + 1 < _events.size())
+			line += ',';
+		line += '\n';
+		stream.writeString(line);
+	}
+	stream.writeString("],\"displayTimeUnit\":\"ns\"}\n");
+
+	return !stream.err();
+}
+
+} // End of namespace Common
+
+#endif // USE_ZONE_PROFILER
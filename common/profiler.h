@@ -0,0 +1,188 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+/**
+ * @defgroup common_profiler Zone profiler
+ * @ingroup common
+ *
+ * @brief Lightweight instrumentation of hot code paths.
+ *
+ * Code is instrumented with the PROFILE_* macros:
+ *
+ * @code
+ * void Foo::drawFrame() {
+ *     PROFILE_ZONE("Foo::drawFrame");
+ *     ...
+ *     PROFILE_COUNTER("Foo::sprites", _sprites.size());
+ * }
+ * @endcode
+ *
+ * Each zone accumulates its call count and time, both in total and per
+ * frame; frames are delimited by PROFILE_FRAME(), which the backends call
+ * from updateScreen(). While a capture is running, every zone and counter
+ * sample is also recorded and can be exported in the Chrome trace event
+ * format, to be loaded in chrome://tracing or Perfetto.
+ *
+ * The profiler is only built when configured with --enable-zone-profiler.
+ * Otherwise the macros expand to nothing and cost nothing.
+ * @{
+ */
+
+#ifdef USE_ZONE_PROFILER
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+class WriteStream;
+
+/** Statistics of a profiled zone. There is one per PROFILE_ZONE() site. */
+struct ProfileZoneInfo {
+	explicit ProfileZoneInfo(const char *zoneName);
+
+	const char *name;
+	uint32 calls;          ///< Calls since the statistics were reset
+	uint64 totalNanos;     ///< Time spent since the statistics were reset
+	uint64 maxNanos;       ///< Longest single call
+	uint32 frameCalls;     ///< Calls in the current frame
+	uint64 frameNanos;     ///< Time spent in the current frame
+	uint32 lastFrameCalls; ///< Calls in the previous frame
+	uint64 lastFrameNanos; ///< Time spent in the previous frame
+	ProfileZoneInfo *next;
+};
+
+/** Last value of a profiled counter. There is one per PROFILE_COUNTER() site. */
+struct ProfileCounterInfo {
+	explicit ProfileCounterInfo(const char *counterName);
+
+	const char *name;
+	int64 value;
+	ProfileCounterInfo *next;
+};
+
+class ZoneProfiler : public Singleton<ZoneProfiler> {
+public:
+	/** Return a monotonic timestamp in nanoseconds. */
+	static uint64 getNanos();
+
+	void registerZone(ProfileZoneInfo *zone);
+	void registerCounter(ProfileCounterInfo *counter);
+
+	void endZone(ProfileZoneInfo *zone, uint64 start, uint64 end);
+	void setCounter(ProfileCounterInfo *counter, int64 value);
+	void endFrame();
+
+	/** Start recording individual zone and counter events, dropping previous ones. */
+	void startCapture();
+	void stopCapture();
+	bool isCapturing() const;
+	uint getCapturedEventCount() const;
+
+	/** Write the events of the last capture in the Chrome trace event format. */
+	bool writeChromeTrace(WriteStream &stream);
+
+	void resetStats();
+
+	/**
+	 * Copy the statistics of all zones and counters, taken consistently
+	 * while other threads keep updating them. The next fields of the
+	 * copies are set to nullptr.
+	 */
+	void getStats(Array<ProfileZoneInfo> &zones, Array<ProfileCounterInfo> &counters) const;
+	uint32 getFrameCount() const;
+	uint64 getLastFrameNanos() const;
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	ZoneProfiler();
+
+	struct Event {
+		const char *name;
+		uint64 start;
+		uint64 duration; ///< Or the value of a counter
+		uint32 thread;
+		bool isCounter;
+	};
+
+	void addEvent(const Event &event);
+
+	mutable Mutex _mutex;
+	ProfileZoneInfo *_zones;
+	ProfileCounterInfo *_counters;
+
+	bool _capturing;
+	uint64 _captureStart;
+	Array<Event> _events;
+
+	uint32 _frameCount;
+	uint64 _frameStart;
+	uint64 _lastFrameNanos;
+};
+
+/** Times the enclosing scope. Use PROFILE_ZONE() rather than this class directly. */
+class ProfileZone {
+public:
+	explicit ProfileZone(ProfileZoneInfo &zone) : _zone(zone), _start(ZoneProfiler::getNanos()) {}
+	~ProfileZone() { ZoneProfiler::instance().endZone(&_zone, _start, ZoneProfiler::getNanos()); }
+
+private:
+	ProfileZoneInfo &_zone;
+	uint64 _start;
+};
+
+} // End of namespace Common
+
+#define PROFILE_CONCAT_INNER(a, b) a ## b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/** Profile the enclosing scope under @p name, which must be a string literal. */
+#define PROFILE_ZONE(name) \
+	static Common::ProfileZoneInfo PROFILE_CONCAT(profileZoneInfo_, __LINE__)(name); \
+	Common::ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(PROFILE_CONCAT(profileZoneInfo_, __LINE__))
+
+/** Record @p value for the counter @p name, which must be a string literal. */
+#define PROFILE_COUNTER(name, value) \
+	do { \
+		static Common::ProfileCounterInfo profileCounterInfo(name); \
+		Common::ZoneProfiler::instance().setCounter(&profileCounterInfo, (int64)(value)); \
+	} while (0)
+
+/** Mark the end of a frame. */
+#define PROFILE_FRAME() Common::ZoneProfiler::instance().endFrame()
+
+#else
+
+#define PROFILE_ZONE(name) do { } while (0)
+#define PROFILE_COUNTER(name, value) do { } while (0)
+#define PROFILE_FRAME() do { } while (0)
+
+#endif // USE_ZONE_PROFILER
+
+/** @} */
+
+#endif
@@ -23,6 +23,7 @@
 #define COMMON_PTR_H
 
 #include "common/scummsys.h"
+#include "common/atomic.h"
 #include "common/noncopyable.h"
 #include "common/safe-bool.h"
 #include "common/types.h"
@@ -48,31 +49,39 @@ public:
 	virtual ~BasePtrTrackerInternal() {}
 
 	void incWeak() {
-		_weakRefCount++;
+		atomicIncrement(_weakRefCount);
 	}
 
 	void decWeak() {
-		if (--_weakRefCount == 0)
+		if (atomicDecrement(_weakRefCount) == 0)
 			delete this;
 	}
 
 	void incStrong() {
-		_strongRefCount++;
+		atomicIncrement(_strongRefCount);
+	}
+
+	/**
+	 * Take a strong reference unless the object is already gone.
+	 * Used to promote a WeakPtr, which may race with the last SharedPtr going away.
+	 */
+	bool tryIncStrong() {
+		return atomicIncrementIfNonZero(_strongRefCount);
 	}
 
 	void decStrong() {
-		if (--_strongRefCount == 0) {
+		if (atomicDecrement(_strongRefCount) == 0) {
 			destructObject();
 			decWeak();
 		}
 	}
 
 	bool isAlive() const {
-		return _strongRefCount > 0;
+		return atomicLoad(_strongRefCount) > 0;
 	}
 
 	RefValue getStrongCount() const {
-		return _strongRefCount;
+		return atomicLoad(_strongRefCount);
 	}
 
 protected:
@@ -199,10 +208,9 @@ public:
 
 	template<class T2>
 	explicit SharedPtr(const WeakPtr<T2> &r) : _pointer(nullptr), _tracker(nullptr) {
-		if (r._tracker && r._tracker->isAlive()) {
+		if (r._tracker && r._tracker->tryIncStrong()) {
 			_pointer = r._pointer;
 			_tracker = r._tracker;
-			_tracker->incStrong();
 		}
 	}
 
@@ -305,10 +313,9 @@ public:
 	void reset(const WeakPtr<T2> &r) {
 		BasePtrTrackerInternal *oldTracker = _tracker;
 
-		if (r._tracker && r._tracker->isAlive()) {
+		if (r._tracker && r._tracker->tryIncStrong()) {
 			_tracker = r._tracker;
 			_pointer = r._pointer;
-			_tracker->incStrong();
 		} else {
 			_tracker = nullptr;
 			_pointer = nullptr;
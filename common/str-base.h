@@ -31,8 +31,6 @@ namespace Common {
 template<class T>
 class BaseString {
 public:
-	static void releaseMemoryPoolMutex();
-
 	static const uint32 npos = 0xFFFFFFFF;
 	typedef T          value_type;
 	typedef T *        iterator;
@@ -68,7 +66,9 @@ protected:
 		value_type _storage[_builtinCapacity];
 		/**
 		 * External string storage data -- the refcounter, and the
-		 * capacity of the string _str points to.
+		 * capacity of the string _str points to. The refcounter is
+		 * stored at the start of the heap block, just before the
+		 * characters.
 		 */
 		struct {
 			mutable int *_refCount;
@@ -385,6 +385,7 @@ protected:
 	void ensureCapacity(uint32 new_size, bool keep_old);
 	void incRefCount() const;
 	void decRefCount(int *oldRefCount);
+	static value_type *allocStorage(uint32 capacity, int *&refCount);
 	void initWithValueTypeChar(size_t count, value_type c);
 	void initWithValueTypeStr(const value_type *str, uint32 len);
 
@@ -131,7 +131,6 @@ void OSystem::initBackend() {
 
 void OSystem::destroy() {
 	_backendInitialized = false;
-	Common::String::releaseMemoryPoolMutex();
 	Common::releaseCJKTables();
 	delete this;
 }
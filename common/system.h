@@ -1282,6 +1282,36 @@ public:
 	 */
 	virtual void unlockScreen() = 0;
 
+	/**
+	 * Lock a rectangle of the active screen framebuffer for writing a
+	 * video frame into it.
+	 *
+	 * Video decoders can write or convert a frame straight into the
+	 * returned surface, which saves both the copy into their own frame
+	 * buffer and the one done by copyRectToScreen(). Unlike lockScreen(),
+	 * only @p rect is marked as dirty when unlocking, so the backend does
+	 * not have to redraw the whole screen.
+	 *
+	 * The previous contents of the area are preserved, but callers are
+	 * expected to overwrite all of it.
+	 * Backends may block rendering until the area is unlocked, so the
+	 * frame should be fully decoded before calling this.
+	 * Must be followed by a matching call to unlockScreenRect().
+	 *
+	 * @return 0 if the backend does not support this, in which case
+	 *         copyRectToScreen() should be used instead. Otherwise, a
+	 *         surface covering @p rect with the pixel format described by
+	 *         getScreenFormat is returned.
+	 *
+	 * @see lockScreen
+	 */
+	virtual Graphics::Surface *lockScreenRect(const Common::Rect &rect) { return nullptr; }
+
+	/**
+	 * Unlock the area locked by lockScreenRect() and mark it as dirty.
+	 */
+	virtual void unlockScreenRect() {}
+
 	/**
 	 * Fill the screen with the given color value.
 	 */
@@ -489,7 +489,7 @@ public:
 	}
 
 	virtual bool visitFuncNode(FuncNode *node) {
-		const bool isBuiltin = g_lingo->_builtinCmds.contains(*node->name);
+		const bool isBuiltin = g_lingo->_builtinCmds.contains(g_lingo->findAtom(*node->name));
 		const ImVec4 color = (ImVec4)ImColor(isBuiltin ? _state->_colors._builtin_color : _state->_colors._call_color);
 		ImGui::TextColored(color, "%s(", node->name->c_str());
 		if (!isBuiltin && ImGui::IsItemHovered() && ImGui::BeginTooltip()) {
@@ -103,14 +103,14 @@ public:
 			renderIndentation();
 		}
 
-		const ImVec4 color = (ImVec4)ImColor(g_lingo->_builtinCmds.contains(node.name) ? _state->_colors._builtin_color : _state->_colors._call_color);
+		const ImVec4 color = (ImVec4)ImColor(g_lingo->_builtinCmds.contains(g_lingo->findAtom(node.name)) ? _state->_colors._builtin_color : _state->_colors._call_color);
 		ImGui::TextColored(color, "%s", node.name.c_str());
 		// TODO: we should test Director::builtins too (but inaccessible)
-		if (!g_lingo->_builtinFuncs.contains(node.name) && ImGui::IsItemHovered() && ImGui::BeginTooltip()) {
+		if (!g_lingo->_builtinFuncs.contains(g_lingo->findAtom(node.name)) && ImGui::IsItemHovered() && ImGui::BeginTooltip()) {
 			ImGui::Text("Go to definition");
 			ImGui::EndTooltip();
 		}
-		if (!g_lingo->_builtinFuncs.contains(node.name) && ImGui::IsItemClicked()) {
+		if (!g_lingo->_builtinFuncs.contains(g_lingo->findAtom(node.name)) && ImGui::IsItemClicked()) {
 			int32 obj = 0;
 			for (uint i = 0; i < _script.bytecodeArray.size(); i++) {
 				if (node._startOffset == _script.bytecodeArray[i].pos) {
@@ -23,6 +23,7 @@
 #define DIRECTOR_DIRECTOR_H
 
 #include "common/hash-ptr.h"
+#include "common/interned-str.h"
 #include "common/gui_options.h"
 
 #include "graphics/macgui/macwindowmanager.h"
@@ -60,6 +61,7 @@ class DirectorSound;
 class Lingo;
 class Movie;
 class Window;
+struct InkBlitParams;
 struct Picture;
 class Score;
 class Channel;
@@ -372,6 +374,7 @@ struct DirectorPlotData {
 	void setApplyColor();
 	uint32 preprocessColor(uint32 src);
 	void inkBlitShape(Common::Rect &srcRect);
+	void getInkParams(InkBlitParams &params);
 	void inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask);
 
 	DirectorPlotData(DirectorEngine *d_, SpriteType s, InkType i, int a, uint32 b, uint32 f) : d(d_), sprite(s), ink(i), alpha(a), backColor(b), foreColor(f) {
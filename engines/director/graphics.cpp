@@ -29,6 +29,7 @@
 #include "director/cast.h"
 #include "director/movie.h"
 #include "director/images.h"
+#include "director/inkblit.h"
 #include "director/picture.h"
 #include "director/window.h"
 #include "director/castmember/bitmap.h"
@@ -339,179 +340,16 @@ void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
 
 			*dst = tmpDst;
 		}
-	} else if (p->alpha) {
-		// Sprite blend does not respect colourization; defaults to matte ink
-		byte rSrc, gSrc, bSrc;
-		byte rDst, gDst, bDst;
-
-		wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
-		wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
-
-		rDst = lerpByte(rSrc, rDst, p->alpha, 255);
-		gDst = lerpByte(gSrc, gDst, p->alpha, 255);
-		bDst = lerpByte(bSrc, bDst, p->alpha, 255);
-		*dst = wm->findBestColor(rDst, gDst, bDst);
-		return;
 	}
 
- 	switch (p->ink) {
-	case kInkTypeBackgndTrans:
-		if (p->oneBitImage) {
-			// One-bit images have a slightly different rendering algorithm for BackgndTrans.
-			// Foreground colour is used, and background colour is ignored.
-			*dst = (src == p->colorBlack) ? p->foreColor : *dst;
-		} else {
-			*dst = (src == p->backColor) ? *dst : src;
-		}
-		break;
-	case kInkTypeMatte:
-		// fall through
-	case kInkTypeMask:
-		// Only unmasked pixels make it here, so copy them straight
-	case kInkTypeBlend:
-		// If there's a blend factor set, it's dealt with in the alpha handling block.
-		// Otherwise, treat it like a Matte image.
-	case kInkTypeCopy: {
-		if (p->applyColor) {
-			*dst = (src == p->colorBlack) ? p->foreColor : ((src == p->colorWhite) ? p->backColor : *dst);
-		} else {
-			*dst = src;
-		}
-		break;
-	}
-	case kInkTypeNotCopy:
-		if (p->applyColor) {
-			if (sizeof(T) == 1) {
-				*dst = (src == p->colorBlack) ? p->backColor : ((src == p->colorWhite) ? p->foreColor : src);
-			} else if (sizeof(T) == 4) {
-				// In 32-bit, apply color mode seems to just return the original src
-				// with no changes. This is different to kInkTypeCopy.
-				*dst = src;
-			}
-		} else {
-			// Find the inverse of the colour and match it back to the palette if required
-			byte rSrc, gSrc, bSrc;
-			wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
+	InkBlitParams params;
+	p->getInkParams(params);
 
-			*dst = wm->findBestColor(~rSrc, ~gSrc, ~bSrc);
-		}
-		break;
-	case kInkTypeTransparent:
-		if (p->oneBitImage || p->applyColor) {
-			*dst = (src == p->colorBlack) ? p->foreColor : *dst;
-		} else {
-			if (sizeof(T) == 1) {
-				// OR dst palette index with src.
-				// Originally designed for 1-bit mode to make white pixels
-				// transparent.
-				*dst = *dst | src;
-			} else {
-				// In 32-bit mode, this is an AND.
-				*dst = *dst & src;
-			}
-		}
-		break;
-	case kInkTypeNotTrans:
-		if (p->oneBitImage || p->applyColor) {
-			*dst = (src == p->colorWhite) ? p->foreColor : *dst;
-		} else {
-			if (sizeof(T) == 1) {
-				// OR dst palette index with the inverse of src.
-				*dst = *dst | ~src;
-			} else {
-				// In 32-bit mode, this is an AND.
-				*dst = *dst & ~(src & 0xffffff00);
-			}
-		}
-		break;
-	case kInkTypeReverse:
-		if (sizeof(T) == 1) {
-			// XOR dst palette index with src.
-			// Originally designed for 1-bit mode so that
-			// black pixels would appear white on a black
-			// background.
-			*dst ^= src;
-		} else {
-			// In 32-bit mode, this is the opposite??
-			*dst ^= ~(src);
-		}
-		break;
-	case kInkTypeNotReverse:
-		if (sizeof(T) == 1) {
-			// XOR dst palette index with the inverse of src.
-			*dst ^= ~(src);
-		} else {
-			// In 32-bit mode, this is the opposite??
-			*dst ^= src & 0xffffff00;
-		}
-		break;
-	case kInkTypeGhost:
-		if (p->oneBitImage || p->applyColor) {
-			*dst = (src == p->colorBlack) ? p->backColor : *dst;
-		} else {
-			if (sizeof(T) == 1) {
-				// AND dst palette index with the inverse of src.
-				// Originally designed for 1-bit mode so that
-				// black pixels would be invisible until they were
-				// over a black background, showing as white.
-				*dst = *dst & ~src;
-			} else {
-				// In 32-bit mode, OR dst RGBA with inverse src
-				*dst = *dst | ~src;
-			}
-		}
-		break;
-	case kInkTypeNotGhost:
-		if (p->oneBitImage || p->applyColor) {
-			*dst = (src == p->colorWhite) ? p->backColor : *dst;
-		} else {
-			if (sizeof(T) == 1) {
-				// AND dst palette index with src.
-				*dst = *dst & src;
-			} else {
-				// In 32-bit mode, OR dst RGBA with src
-				*dst = *dst | src;
-			}
-		}
-		break;
-	default: {
-		// Arithmetic ink types, based on real color values
-		byte rSrc, gSrc, bSrc;
-		byte rDst, gDst, bDst;
-
-		wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
-		wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
-
-		switch (p->ink) {
-		case kInkTypeAddPin:
-			// Add src to dst, but pinning each channel so it can't go above 0xff.
-			*dst = wm->findBestColor(rDst + MIN(0xff - rDst, (int)rSrc), gDst + MIN(0xff - gDst, (int)gSrc), bDst + MIN(0xff - bDst, (int)bSrc));
-			break;
-		case kInkTypeAdd:
-			// Add src to dst, allowing each channel to overflow and wrap around.
-			*dst = wm->findBestColor(rDst + rSrc, gDst + gSrc, bDst + bSrc);
-			break;
-		case kInkTypeSubPin:
-			// Subtract src from dst, but pinning each channel so it can't go below 0x00.
-			*dst = wm->findBestColor(MAX(rDst - rSrc, 1) - 1, MAX(gDst - gSrc, 1) - 1, MAX(bDst - bSrc, 1) - 1);
-			break;
-		case kInkTypeLight:
-			// Pick the higher of src and dst for each channel, lightening the image.
-			*dst = wm->findBestColor(MAX(rSrc, rDst), MAX(gSrc, gDst), MAX(bSrc, bDst));
-			break;
-		case kInkTypeSub:
-			// Subtract src from dst, allowing each channel to underflow and wrap around.
-			*dst = wm->findBestColor(rDst - rSrc, gDst - gSrc, bDst - bSrc);
-			break;
-		case kInkTypeDark:
-			// Pick the lower of src and dst for each channel, darkening the image.
-			*dst = wm->findBestColor(MIN(rSrc, rDst), MIN(gSrc, gDst), MIN(bSrc, bDst));
-			break;
-		default:
-			break;
-		}
-	}
-	}
+	// Shapes are not blended
+	if (p->ms)
+		params.alpha = 0;
+
+	inkPixel(dst, src, params);
 }
 
 Graphics::Primitives *DirectorEngine::getInkPrimitives() {
@@ -711,6 +549,22 @@ void DirectorPlotData::inkBlitShape(Common::Rect &srcRect) {
 	}
 }
 
+void DirectorPlotData::getInkParams(InkBlitParams &params) {
+	Graphics::MacWindowManager *wm = d->_wm;
+
+	params.ink = ink;
+	params.alpha = alpha;
+	params.foreColor = foreColor;
+	params.backColor = backColor;
+	params.colorBlack = colorBlack;
+	params.colorWhite = colorWhite;
+	params.applyColor = applyColor;
+	params.oneBitImage = oneBitImage;
+	params.palette = wm->getPalette();
+	params.paletteLookup = wm->getPaletteLookup();
+	params.format = wm->_pixelformat;
+}
+
 void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask) {
 	if (!srf)
 		return;
@@ -747,6 +601,27 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
 
+	// If the whole sprite is inside the source surface, draw it a row at
+	// a time with a kernel picked for its ink. Text-like sprites have their
+	// colors remapped by preprocessColor(), so they stay on the per-pixel path.
+	Common::Point srcOrigin(abs(srcRect.left - destRect.left), abs(srcRect.top - destRect.top));
+	Common::Rect srcArea(srcOrigin.x, srcOrigin.y, srcOrigin.x + destRect.width(), srcOrigin.y + destRect.height());
+	bool textLike = sprite == kTextSprite || sprite == kButtonSprite || sprite == kCheckboxSprite || sprite == kRadioButtonSprite;
+
+	if (!ms && !textLike && (!mask || mask->format.bytesPerPixel == 1) && srfClip.contains(srcArea)) {
+		InkBlitParams params;
+		getInkParams(params);
+		InkRowFunc inkRow = getInkRowFunc(params, d->_wm->_pixelformat.bytesPerPixel);
+
+		for (int i = 0; i < destRect.height(); i++) {
+			inkRow((byte *)dst->getBasePtr(destRect.left, destRect.top + i),
+				   (const byte *)srf->getBasePtr(srcOrigin.x, srcOrigin.y + i),
+				   mask ? (const byte *)mask->getBasePtr(srcOrigin.x, srcOrigin.y + i) : nullptr,
+				   destRect.width(), params);
+		}
+		return;
+	}
+
 	Graphics::Primitives *primitives = g_director->getInkPrimitives();
 
 	srcPoint.y = abs(srcRect.top - destRect.top);
@@ -0,0 +1,458 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/language.h"
+#include "common/platform.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/util.h"
+#include "graphics/palette.h"
+
+#include "director/inkblit.h"
+#include "director/util.h"
+
+namespace Director {
+
+template<typename T>
+struct InkColors;
+
+template<>
+struct InkColors<byte> {
+	static FORCEINLINE void decompose(uint32 color, byte &r, byte &g, byte &b, const InkBlitParams &p) {
+		const byte *c = p.palette + 3 * (byte)color;
+		r = c[0];
+		g = c[1];
+		b = c[2];
+	}
+
+	static FORCEINLINE uint32 findBest(byte r, byte g, byte b, const InkBlitParams &p) {
+		return p.paletteLookup->findBestColor(r, g, b);
+	}
+};
+
+template<>
+struct InkColors<uint32> {
+	static FORCEINLINE void decompose(uint32 color, byte &r, byte &g, byte &b, const InkBlitParams &p) {
+		p.format.colorToRGB(color, r, g, b);
+	}
+
+	static FORCEINLINE uint32 findBest(byte r, byte g, byte b, const InkBlitParams &p) {
+		return p.format.RGBToColor(r, g, b);
+	}
+};
+
+static inline bool isArithmeticInk(InkType ink) {
+	switch (ink) {
+	case kInkTypeAddPin:
+	case kInkTypeAdd:
+	case kInkTypeSubPin:
+	case kInkTypeLight:
+	case kInkTypeSub:
+	case kInkTypeDark:
+		return true;
+	default:
+		return false;
+	}
+}
+
+// The ink and blend amount are passed separately from p, so that the row
+// kernels can pass constants and have the switch folded away.
+template<typename T>
+static FORCEINLINE void inkApply(T *dst, uint32 src, InkType ink, int alpha, const InkBlitParams &p) {
+	typedef InkColors<T> Colors;
+
+	if (alpha) {
+		// Sprite blend does not respect colourization; defaults to matte ink
+		byte rSrc, gSrc, bSrc;
+		byte rDst, gDst, bDst;
+
+		Colors::decompose(src, rSrc, gSrc, bSrc, p);
+		Colors::decompose(*dst, rDst, gDst, bDst, p);
+
+		rDst = lerpByte(rSrc, rDst, alpha, 255);
+		gDst = lerpByte(gSrc, gDst, alpha, 255);
+		bDst = lerpByte(bSrc, bDst, alpha, 255);
+		*dst = Colors::findBest(rDst, gDst, bDst, p);
+		return;
+	}
+
+	switch (ink) {
+	case kInkTypeBackgndTrans:
+		if (p.oneBitImage) {
+			// One-bit images have a slightly different rendering algorithm for BackgndTrans.
+			// Foreground colour is used, and background colour is ignored.
+			*dst = (src == p.colorBlack) ? p.foreColor : *dst;
+		} else {
+			*dst = (src == p.backColor) ? *dst : src;
+		}
+		break;
+	case kInkTypeMatte:
+		// fall through
+	case kInkTypeMask:
+		// Only unmasked pixels make it here, so copy them straight
+	case kInkTypeBlend:
+		// If there's a blend factor set, it's dealt with in the alpha handling block.
+		// Otherwise, treat it like a Matte image.
+	case kInkTypeCopy: {
+		if (p.applyColor) {
+			*dst = (src == p.colorBlack) ? p.foreColor : ((src == p.colorWhite) ? p.backColor : *dst);
+		} else {
+			*dst = src;
+		}
+		break;
+	}
+	case kInkTypeNotCopy:
+		if (p.applyColor) {
+			if (sizeof(T) == 1) {
+				*dst = (src == p.colorBlack) ? p.backColor : ((src == p.colorWhite) ? p.foreColor : src);
+			} else if (sizeof(T) == 4) {
+				// In 32-bit, apply color mode seems to just return the original src
+				// with no changes. This is different to kInkTypeCopy.
+				*dst = src;
+			}
+		} else {
+			// Find the inverse of the colour and match it back to the palette if required
+			byte rSrc, gSrc, bSrc;
+			Colors::decompose(src, rSrc, gSrc, bSrc, p);
+
+			*dst = Colors::findBest(~rSrc, ~gSrc, ~bSrc, p);
+		}
+		break;
+	case kInkTypeTransparent:
+		if (p.oneBitImage || p.applyColor) {
+			*dst = (src == p.colorBlack) ? p.foreColor : *dst;
+		} else {
+			if (sizeof(T) == 1) {
+				// OR dst palette index with src.
+				// Originally designed for 1-bit mode to make white pixels
+				// transparent.
+				*dst = *dst | src;
+			} else {
+				// In 32-bit mode, this is an AND.
+				*dst = *dst & src;
+			}
+		}
+		break;
+	case kInkTypeNotTrans:
+		if (p.oneBitImage || p.applyColor) {
+			*dst = (src == p.colorWhite) ? p.foreColor : *dst;
+		} else {
+			if (sizeof(T) == 1) {
+				// OR dst palette index with the inverse of src.
+				*dst = *dst | ~src;
+			} else {
+				// In 32-bit mode, this is an AND.
+				*dst = *dst & ~(src & 0xffffff00);
+			}
+		}
+		break;
+	case kInkTypeReverse:
+		if (sizeof(T) == 1) {
+			// XOR dst palette index with src.
+			// Originally designed for 1-bit mode so that
+			// black pixels would appear white on a black
+			// background.
+			*dst ^= src;
+		} else {
+			// In 32-bit mode, this is the opposite??
+			*dst ^= ~(src);
+		}
+		break;
+	case kInkTypeNotReverse:
+		if (sizeof(T) == 1) {
+			// XOR dst palette index with the inverse of src.
+			*dst ^= ~(src);
+		} else {
+			// In 32-bit mode, this is the opposite??
+			*dst ^= src & 0xffffff00;
+		}
+		break;
+	case kInkTypeGhost:
+		if (p.oneBitImage || p.applyColor) {
+			*dst = (src == p.colorBlack) ? p.backColor : *dst;
+		} else {
+			if (sizeof(T) == 1) {
+				// AND dst palette index with the inverse of src.
+				// Originally designed for 1-bit mode so that
+				// black pixels would be invisible until they were
+				// over a black background, showing as white.
+				*dst = *dst & ~src;
+			} else {
+				// In 32-bit mode, OR dst RGBA with inverse src
+				*dst = *dst | ~src;
+			}
+		}
+		break;
+	case kInkTypeNotGhost:
+		if (p.oneBitImage || p.applyColor) {
+			*dst = (src == p.colorWhite) ? p.backColor : *dst;
+		} else {
+			if (sizeof(T) == 1) {
+				// AND dst palette index with src.
+				*dst = *dst & src;
+			} else {
+				// In 32-bit mode, OR dst RGBA with src
+				*dst = *dst | src;
+			}
+		}
+		break;
+	default: {
+		// Arithmetic ink types, based on real color values
+		byte rSrc, gSrc, bSrc;
+		byte rDst, gDst, bDst;
+
+		Colors::decompose(src, rSrc, gSrc, bSrc, p);
+		Colors::decompose(*dst, rDst, gDst, bDst, p);
+
+		switch (ink) {
+		case kInkTypeAddPin:
+			// Add src to dst, but pinning each channel so it can't go above 0xff.
+			*dst = Colors::findBest(rDst + MIN(0xff - rDst, (int)rSrc), gDst + MIN(0xff - gDst, (int)gSrc), bDst + MIN(0xff - bDst, (int)bSrc), p);
+			break;
+		case kInkTypeAdd:
+			// Add src to dst, allowing each channel to overflow and wrap around.
+			*dst = Colors::findBest(rDst + rSrc, gDst + gSrc, bDst + bSrc, p);
+			break;
+		case kInkTypeSubPin:
+			// Subtract src from dst, but pinning each channel so it can't go below 0x00.
+			*dst = Colors::findBest(MAX(rDst - rSrc, 1) - 1, MAX(gDst - gSrc, 1) - 1, MAX(bDst - bSrc, 1) - 1, p);
+			break;
+		case kInkTypeLight:
+			// Pick the higher of src and dst for each channel, lightening the image.
+			*dst = Colors::findBest(MAX(rSrc, rDst), MAX(gSrc, gDst), MAX(bSrc, bDst), p);
+			break;
+		case kInkTypeSub:
+			// Subtract src from dst, allowing each channel to underflow and wrap around.
+			*dst = Colors::findBest(rDst - rSrc, gDst - gSrc, bDst - bSrc, p);
+			break;
+		case kInkTypeDark:
+			// Pick the lower of src and dst for each channel, darkening the image.
+			*dst = Colors::findBest(MIN(rSrc, rDst), MIN(gSrc, gDst), MIN(bSrc, bDst), p);
+			break;
+		default:
+			break;
+		}
+	}
+	}
+}
+
+void inkPixel(byte *dst, uint32 src, const InkBlitParams &p) {
+	inkApply<byte>(dst, src, p.ink, p.alpha, p);
+}
+
+void inkPixel(uint32 *dst, uint32 src, const InkBlitParams &p) {
+	inkApply<uint32>(dst, src, p.ink, p.alpha, p);
+}
+
+template<typename T, InkType ink, bool blend>
+static void inkRow(byte *dst, const byte *src, const byte *mask, int width, const InkBlitParams &p) {
+	T *d = (T *)dst;
+	const T *s = (const T *)src;
+	const int alpha = blend ? p.alpha : 0;
+
+	for (int i = 0; i < width; i++) {
+		if (!mask || mask[i])
+			inkApply<T>(&d[i], s[i], ink, alpha, p);
+	}
+}
+
+// Palette matching is the expensive part of the 8-bit blend and arithmetic
+// inks. Neighbouring pixels often have the same colors, so the last match
+// is kept for the next pixel.
+template<InkType ink, bool blend>
+static void inkRowMatched8(byte *dst, const byte *src, const byte *mask, int width, const InkBlitParams &p) {
+	const int alpha = blend ? p.alpha : 0;
+	uint lastKey = 0xffffffff;
+	byte lastColor = 0;
+
+	for (int i = 0; i < width; i++) {
+		if (mask && !mask[i])
+			continue;
+
+		const uint key = (src[i] << 8) | dst[i];
+		if (key != lastKey) {
+			inkApply<byte>(&dst[i], src[i], ink, alpha, p);
+			lastKey = key;
+			lastColor = dst[i];
+		} else {
+			dst[i] = lastColor;
+		}
+	}
+}
+
+// Copy inks without colourization just move the pixels.
+template<typename T>
+static void inkRowCopy(byte *dst, const byte *src, const byte *mask, int width, const InkBlitParams &p) {
+	if (!mask) {
+		memcpy(dst, src, width * sizeof(T));
+		return;
+	}
+
+	T *d = (T *)dst;
+	const T *s = (const T *)src;
+	for (int i = 0; i < width; i++) {
+		if (mask[i])
+			d[i] = s[i];
+	}
+}
+
+static void inkRowNone(byte *dst, const byte *src, const byte *mask, int width, const InkBlitParams &p) {
+}
+
+template<typename T>
+static InkRowFunc getGenericRowFunc(const InkBlitParams &p) {
+	if (p.alpha)
+		return inkRow<T, kInkTypeBlend, true>;
+
+	switch (p.ink) {
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+		if (!p.applyColor)
+			return inkRowCopy<T>;
+		return inkRow<T, kInkTypeCopy, false>;
+	case kInkTypeTransparent:
+		return inkRow<T, kInkTypeTransparent, false>;
+	case kInkTypeReverse:
+		return inkRow<T, kInkTypeReverse, false>;
+	case kInkTypeGhost:
+		return inkRow<T, kInkTypeGhost, false>;
+	case kInkTypeNotCopy:
+		return inkRow<T, kInkTypeNotCopy, false>;
+	case kInkTypeNotTrans:
+		return inkRow<T, kInkTypeNotTrans, false>;
+	case kInkTypeNotReverse:
+		return inkRow<T, kInkTypeNotReverse, false>;
+	case kInkTypeNotGhost:
+		return inkRow<T, kInkTypeNotGhost, false>;
+	case kInkTypeBackgndTrans:
+		return inkRow<T, kInkTypeBackgndTrans, false>;
+	case kInkTypeAddPin:
+		return inkRow<T, kInkTypeAddPin, false>;
+	case kInkTypeAdd:
+		return inkRow<T, kInkTypeAdd, false>;
+	case kInkTypeSubPin:
+		return inkRow<T, kInkTypeSubPin, false>;
+	case kInkTypeLight:
+		return inkRow<T, kInkTypeLight, false>;
+	case kInkTypeSub:
+		return inkRow<T, kInkTypeSub, false>;
+	case kInkTypeDark:
+		return inkRow<T, kInkTypeDark, false>;
+	default:
+		return inkRowNone;
+	}
+}
+
+static InkRowFunc getMatchedRowFunc8(const InkBlitParams &p) {
+	if (p.alpha)
+		return inkRowMatched8<kInkTypeBlend, true>;
+
+	switch (p.ink) {
+	case kInkTypeAddPin:
+		return inkRowMatched8<kInkTypeAddPin, false>;
+	case kInkTypeAdd:
+		return inkRowMatched8<kInkTypeAdd, false>;
+	case kInkTypeSubPin:
+		return inkRowMatched8<kInkTypeSubPin, false>;
+	case kInkTypeLight:
+		return inkRowMatched8<kInkTypeLight, false>;
+	case kInkTypeSub:
+		return inkRowMatched8<kInkTypeSub, false>;
+	case kInkTypeDark:
+		return inkRowMatched8<kInkTypeDark, false>;
+	default:
+		return nullptr;
+	}
+}
+
+static InkRowFunc getArithmeticRowFunc(const InkArithmeticKernels *kernels, const InkBlitParams &p) {
+	if (p.alpha)
+		return kernels->blend;
+
+	switch (p.ink) {
+	case kInkTypeAddPin:
+		return kernels->addPin;
+	case kInkTypeAdd:
+		return kernels->add;
+	case kInkTypeSubPin:
+		return kernels->subPin;
+	case kInkTypeLight:
+		return kernels->light;
+	case kInkTypeSub:
+		return kernels->sub;
+	case kInkTypeDark:
+		return kernels->dark;
+	default:
+		return nullptr;
+	}
+}
+
+InkRowFunc getInkRowFunc(const InkBlitParams &p, int bytesPerPixel) {
+	if (bytesPerPixel == 1) {
+		if (p.alpha || isArithmeticInk(p.ink))
+			return getMatchedRowFunc8(p);
+		return getGenericRowFunc<byte>(p);
+	}
+
+	if ((p.alpha || isArithmeticInk(p.ink)) && inkFormatIsByteAligned(p.format))
+		return getArithmeticRowFunc(getInkArithmeticKernels(), p);
+	return getGenericRowFunc<uint32>(p);
+}
+
+bool inkFormatIsByteAligned(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel != 4 || format.rLoss || format.gLoss || format.bLoss)
+		return false;
+	if (format.rShift % 8 || format.gShift % 8 || format.bShift % 8)
+		return false;
+	return format.aLoss == 8 || (format.aLoss == 0 && format.aShift % 8 == 0);
+}
+
+const InkArithmeticKernels inkArithmeticKernelsGeneric = {
+	inkRow<uint32, kInkTypeBlend, true>,
+	inkRow<uint32, kInkTypeAddPin, false>,
+	inkRow<uint32, kInkTypeAdd, false>,
+	inkRow<uint32, kInkTypeSubPin, false>,
+	inkRow<uint32, kInkTypeLight, false>,
+	inkRow<uint32, kInkTypeSub, false>,
+	inkRow<uint32, kInkTypeDark, false>
+};
+
+const InkArithmeticKernels *inkArithmeticKernels = nullptr;
+
+const InkArithmeticKernels *getInkArithmeticKernels() {
+	if (inkArithmeticKernels)
+		return inkArithmeticKernels;
+
+	inkArithmeticKernels = &inkArithmeticKernelsGeneric;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		inkArithmeticKernels = &inkArithmeticKernelsSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		inkArithmeticKernels = &inkArithmeticKernelsNEON;
+#endif
+	return inkArithmeticKernels;
+}
+
+} // End of namespace Director
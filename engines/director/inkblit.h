@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DIRECTOR_INKBLIT_H
+#define DIRECTOR_INKBLIT_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/str.h"
+#include "graphics/pixelformat.h"
+
+#include "director/types.h"
+
+namespace Graphics {
+class PaletteLookup;
+}
+
+namespace Director {
+
+/**
+ * Everything needed to apply a sprite ink to a pixel, without going
+ * through the window manager. This mirrors the ink related fields of
+ * DirectorPlotData.
+ *
+ * 8-bit pixels are palette indices: arithmetic inks look their colors
+ * up in palette and match the result back with paletteLookup.
+ * 32-bit pixels are in format.
+ */
+struct InkBlitParams {
+	InkType ink = kInkTypeCopy;
+	int alpha = 0;
+
+	uint32 foreColor = 0;
+	uint32 backColor = 0;
+	uint32 colorBlack = 0;
+	uint32 colorWhite = 0;
+	bool applyColor = false;
+	bool oneBitImage = false;
+
+	const byte *palette = nullptr;
+	Graphics::PaletteLookup *paletteLookup = nullptr;
+	Graphics::PixelFormat format;
+};
+
+/**
+ * Applies the ink to one pixel. This is the reference for the row
+ * kernels below, and what InkPrimitives::drawPoint uses for sprites.
+ */
+void inkPixel(byte *dst, uint32 src, const InkBlitParams &p);
+void inkPixel(uint32 *dst, uint32 src, const InkBlitParams &p);
+
+/**
+ * Applies an ink to a row of width pixels. If mask is set, it holds one
+ * byte per pixel and only pixels with a non-zero mask byte are drawn.
+ */
+typedef void (*InkRowFunc)(byte *dst, const byte *src, const byte *mask, int width, const InkBlitParams &p);
+
+/**
+ * Returns the row kernel for the ink, blend amount and bit depth in p.
+ * It is picked once per sprite, so the kernels do not need to check the
+ * ink for every pixel.
+ */
+InkRowFunc getInkRowFunc(const InkBlitParams &p, int bytesPerPixel);
+
+/**
+ * Row kernels for the 32-bit blend and arithmetic inks. They work on
+ * the color channels directly, so they are only used when each channel
+ * takes a whole byte of the pixel (see inkFormatIsByteAligned()).
+ */
+struct InkArithmeticKernels {
+	InkRowFunc blend;
+	InkRowFunc addPin;
+	InkRowFunc add;
+	InkRowFunc subPin;
+	InkRowFunc light;
+	InkRowFunc sub;
+	InkRowFunc dark;
+};
+
+bool inkFormatIsByteAligned(const Graphics::PixelFormat &format);
+
+/**
+ * The 32-bit arithmetic kernels. They are picked based on the CPU
+ * features on first use, unless they have been set before.
+ */
+extern const InkArithmeticKernels *inkArithmeticKernels;
+
+const InkArithmeticKernels *getInkArithmeticKernels();
+
+extern const InkArithmeticKernels inkArithmeticKernelsGeneric;
+#ifdef SCUMMVM_NEON
+extern const InkArithmeticKernels inkArithmeticKernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+extern const InkArithmeticKernels inkArithmeticKernelsSSE2;
+#endif
+
+} // End of namespace Director
+
+#endif
@@ -0,0 +1,160 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "common/util.h"
+
+#include "director/inkblit.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Director {
+
+struct BlendNEON {
+	uint8x8_t alpha, invAlpha;
+
+	BlendNEON(const InkBlitParams &p) {
+		const int a = CLIP<int>(p.alpha, 0, 255);
+		alpha = vdup_n_u8((uint8)a);
+		invAlpha = vdup_n_u8((uint8)(255 - a));
+	}
+
+	// (dst * alpha + src * (255 - alpha)) / 255, rounded down like lerpByte()
+	FORCEINLINE uint8x8_t lerp(uint8x8_t s, uint8x8_t d) const {
+		uint16x8_t x = vmlal_u8(vmull_u8(d, alpha), s, invAlpha);
+		x = vaddq_u16(x, vaddq_u16(vshrq_n_u16(x, 8), vdupq_n_u16(1)));
+		return vshrn_n_u16(x, 8);
+	}
+
+	FORCEINLINE uint8x16_t operator()(uint8x16_t s, uint8x16_t d) const {
+		return vcombine_u8(lerp(vget_low_u8(s), vget_low_u8(d)), lerp(vget_high_u8(s), vget_high_u8(d)));
+	}
+};
+
+struct AddPinNEON {
+	AddPinNEON(const InkBlitParams &p) {}
+	FORCEINLINE uint8x16_t operator()(uint8x16_t s, uint8x16_t d) const { return vqaddq_u8(d, s); }
+};
+
+struct AddNEON {
+	AddNEON(const InkBlitParams &p) {}
+	FORCEINLINE uint8x16_t operator()(uint8x16_t s, uint8x16_t d) const { return vaddq_u8(d, s); }
+};
+
+struct SubPinNEON {
+	SubPinNEON(const InkBlitParams &p) {}
+	// Matches MAX(dst - src, 1) - 1
+	FORCEINLINE uint8x16_t operator()(uint8x16_t s, uint8x16_t d) const {
+		return vqsubq_u8(vqsubq_u8(d, s), vdupq_n_u8(1));
+	}
+};
+
+struct LightNEON {
+	LightNEON(const InkBlitParams &p) {}
+	FORCEINLINE uint8x16_t operator()(uint8x16_t s, uint8x16_t d) const { return vmaxq_u8(d, s); }
+};
+
+struct SubNEON {
+	SubNEON(const InkBlitParams &p) {}
+	FORCEINLINE uint8x16_t operator()(uint8x16_t s, uint8x16_t d) const { return vsubq_u8(d, s); }
+};
+
+struct DarkNEON {
+	DarkNEON(const InkBlitParams &p) {}
+	FORCEINLINE uint8x16_t operator()(uint8x16_t s, uint8x16_t d) const { return vminq_u8(d, s); }
+};
+
+// Same as the SSE2 version: four pixels at a time, with the alpha channel
+// set like PixelFormat::RGBToColor() and masked out pixels left alone.
+template<typename Op, InkRowFunc InkArithmeticKernels::*generic>
+static void arithmeticRowNEON(byte *dst, const byte *src, const byte *mask, int width, const InkBlitParams &p) {
+	const Op op(p);
+	const uint32 alphaBits = p.format.RGBToColor(0, 0, 0);
+	const uint32x4_t alpha = vdupq_n_u32(alphaBits);
+	const uint32x4_t rgb = vdupq_n_u32(p.format.RGBToColor(0xff, 0xff, 0xff) & ~alphaBits);
+
+	int i = 0;
+	for (; i + 4 <= width; i += 4) {
+		uint32 m = 0xffffffff;
+		if (mask) {
+			memcpy(&m, mask + i, 4);
+			if (!m)
+				continue;
+		}
+
+		const uint8x16_t s = vld1q_u8(src + i * 4);
+		const uint8x16_t d = vld1q_u8(dst + i * 4);
+		uint32x4_t px = vorrq_u32(vandq_u32(vreinterpretq_u32_u8(op(s, d)), rgb), alpha);
+
+		if (mask) {
+			const uint32 lanes[4] = {
+				mask[i] ? 0xffffffffU : 0,
+				mask[i + 1] ? 0xffffffffU : 0,
+				mask[i + 2] ? 0xffffffffU : 0,
+				mask[i + 3] ? 0xffffffffU : 0
+			};
+			px = vbslq_u32(vld1q_u32(lanes), px, vreinterpretq_u32_u8(d));
+		}
+
+		vst1q_u8(dst + i * 4, vreinterpretq_u8_u32(px));
+	}
+
+	if (i < width)
+		(inkArithmeticKernelsGeneric.*generic)(dst + i * 4, src + i * 4, mask ? mask + i : nullptr, width - i, p);
+}
+
+const InkArithmeticKernels inkArithmeticKernelsNEON = {
+	arithmeticRowNEON<BlendNEON, &InkArithmeticKernels::blend>,
+	arithmeticRowNEON<AddPinNEON, &InkArithmeticKernels::addPin>,
+	arithmeticRowNEON<AddNEON, &InkArithmeticKernels::add>,
+	arithmeticRowNEON<SubPinNEON, &InkArithmeticKernels::subPin>,
+	arithmeticRowNEON<LightNEON, &InkArithmeticKernels::light>,
+	arithmeticRowNEON<SubNEON, &InkArithmeticKernels::sub>,
+	arithmeticRowNEON<DarkNEON, &InkArithmeticKernels::dark>
+};
+
+} // End of namespace Director
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
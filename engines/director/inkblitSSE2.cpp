@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include "common/util.h"
+
+#include "director/inkblit.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Director {
+
+struct BlendSSE2 {
+	__m128i alpha, invAlpha;
+
+	BlendSSE2(const InkBlitParams &p) {
+		const int a = CLIP<int>(p.alpha, 0, 255);
+		alpha = _mm_set1_epi16((short)a);
+		invAlpha = _mm_set1_epi16((short)(255 - a));
+	}
+
+	// (dst * alpha + src * (255 - alpha)) / 255, rounded down like lerpByte()
+	FORCEINLINE __m128i lerp(__m128i s, __m128i d) const {
+		__m128i x = _mm_add_epi16(_mm_mullo_epi16(d, alpha), _mm_mullo_epi16(s, invAlpha));
+		x = _mm_add_epi16(x, _mm_add_epi16(_mm_srli_epi16(x, 8), _mm_set1_epi16(1)));
+		return _mm_srli_epi16(x, 8);
+	}
+
+	FORCEINLINE __m128i operator()(__m128i s, __m128i d) const {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i lo = lerp(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+		const __m128i hi = lerp(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+		return _mm_packus_epi16(lo, hi);
+	}
+};
+
+struct AddPinSSE2 {
+	AddPinSSE2(const InkBlitParams &p) {}
+	FORCEINLINE __m128i operator()(__m128i s, __m128i d) const { return _mm_adds_epu8(d, s); }
+};
+
+struct AddSSE2 {
+	AddSSE2(const InkBlitParams &p) {}
+	FORCEINLINE __m128i operator()(__m128i s, __m128i d) const { return _mm_add_epi8(d, s); }
+};
+
+struct SubPinSSE2 {
+	SubPinSSE2(const InkBlitParams &p) {}
+	// Matches MAX(dst - src, 1) - 1
+	FORCEINLINE __m128i operator()(__m128i s, __m128i d) const {
+		return _mm_subs_epu8(_mm_subs_epu8(d, s), _mm_set1_epi8(1));
+	}
+};
+
+struct LightSSE2 {
+	LightSSE2(const InkBlitParams &p) {}
+	FORCEINLINE __m128i operator()(__m128i s, __m128i d) const { return _mm_max_epu8(d, s); }
+};
+
+struct SubSSE2 {
+	SubSSE2(const InkBlitParams &p) {}
+	FORCEINLINE __m128i operator()(__m128i s, __m128i d) const { return _mm_sub_epi8(d, s); }
+};
+
+struct DarkSSE2 {
+	DarkSSE2(const InkBlitParams &p) {}
+	FORCEINLINE __m128i operator()(__m128i s, __m128i d) const { return _mm_min_epu8(d, s); }
+};
+
+// Applies Op to each color channel of four pixels at a time. The alpha
+// channel is then set the way PixelFormat::RGBToColor() would, and masked
+// out pixels keep their old value. The last few pixels of a row go through
+// the generic kernel.
+template<typename Op, InkRowFunc InkArithmeticKernels::*generic>
+static void arithmeticRowSSE2(byte *dst, const byte *src, const byte *mask, int width, const InkBlitParams &p) {
+	const Op op(p);
+	const uint32 alphaBits = p.format.RGBToColor(0, 0, 0);
+	const __m128i alpha = _mm_set1_epi32((int)alphaBits);
+	const __m128i rgb = _mm_set1_epi32((int)(p.format.RGBToColor(0xff, 0xff, 0xff) & ~alphaBits));
+	const __m128i zero = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 4 <= width; i += 4) {
+		uint32 m = 0xffffffff;
+		if (mask) {
+			memcpy(&m, mask + i, 4);
+			if (!m)
+				continue;
+		}
+
+		const __m128i s = _mm_loadu_si128((const __m128i *)(src + i * 4));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i * 4));
+		__m128i px = _mm_or_si128(_mm_and_si128(op(s, d), rgb), alpha);
+
+		if (mask) {
+			__m128i keep = _mm_cvtsi32_si128((int)m);
+			keep = _mm_unpacklo_epi16(_mm_unpacklo_epi8(keep, zero), zero);
+			keep = _mm_cmpeq_epi32(keep, zero);
+			px = _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, px));
+		}
+
+		_mm_storeu_si128((__m128i *)(dst + i * 4), px);
+	}
+
+	if (i < width)
+		(inkArithmeticKernelsGeneric.*generic)(dst + i * 4, src + i * 4, mask ? mask + i : nullptr, width - i, p);
+}
+
+const InkArithmeticKernels inkArithmeticKernelsSSE2 = {
+	arithmeticRowSSE2<BlendSSE2, &InkArithmeticKernels::blend>,
+	arithmeticRowSSE2<AddPinSSE2, &InkArithmeticKernels::addPin>,
+	arithmeticRowSSE2<AddSSE2, &InkArithmeticKernels::add>,
+	arithmeticRowSSE2<SubPinSSE2, &InkArithmeticKernels::subPin>,
+	arithmeticRowSSE2<LightSSE2, &InkArithmeticKernels::light>,
+	arithmeticRowSSE2<SubSSE2, &InkArithmeticKernels::sub>,
+	arithmeticRowSSE2<DarkSSE2, &InkArithmeticKernels::dark>
+};
+
+} // End of namespace Director
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // SCUMMVM_SSE2
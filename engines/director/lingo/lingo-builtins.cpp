@@ -461,23 +461,25 @@ void Lingo::initBuiltIns(const BuiltinProto protos[]) {
 
 		sym.u.bltin = blt->func;
 
+		Common::InternedString name = intern(blt->name);
+
 		switch (blt->type) {
 		case CBLTIN:
-			_builtinCmds[blt->name] = sym;
+			_builtinCmds[name] = sym;
 			break;
 		case FBLTIN_LIST:
-			_builtinListHandlers[blt->name] = sym; // fall-through
+			_builtinListHandlers[name] = sym; // fall-through
 		case FBLTIN:
-			_builtinFuncs[blt->name] = sym;
+			_builtinFuncs[name] = sym;
 			break;
 		case HBLTIN_LIST:
-			_builtinListHandlers[blt->name] = sym; // fall-through
+			_builtinListHandlers[name] = sym; // fall-through
 		case HBLTIN:
-			_builtinCmds[blt->name] = sym;
-			_builtinFuncs[blt->name] = sym;
+			_builtinCmds[name] = sym;
+			_builtinFuncs[name] = sym;
 			break;
 		case KBLTIN:
-			_builtinConsts[blt->name] = sym;
+			_builtinConsts[name] = sym;
 		default:
 			break;
 		}
@@ -492,19 +494,21 @@ void Lingo::cleanupBuiltIns() {
 
 void Lingo::cleanupBuiltIns(const BuiltinProto protos[]) {
 	for (const BuiltinProto *blt = protos; blt->name; blt++) {
+		Common::InternedString name = findAtom(blt->name);
+
 		switch (blt->type) {
 		case CBLTIN:
-			_builtinCmds.erase(blt->name);
+			_builtinCmds.erase(name);
 			break;
 		case FBLTIN:
-			_builtinFuncs.erase(blt->name);
+			_builtinFuncs.erase(name);
 			break;
 		case HBLTIN:
-			_builtinCmds.erase(blt->name);
-			_builtinFuncs.erase(blt->name);
+			_builtinCmds.erase(name);
+			_builtinFuncs.erase(name);
 			break;
 		case KBLTIN:
-			_builtinConsts.erase(blt->name);
+			_builtinConsts.erase(name);
 		default:
 			break;
 		}
@@ -2489,6 +2493,8 @@ void LB::b_clearGlobals(int nargs) {
 			g_lingo->_globalvars.erase(it._key);
 		}
 	}
+	// Drop any slots cached by c_globalpush and friends
+	g_lingo->_globalvarsGeneration++;
 }
 
 void LB::b_cursor(int nargs) {
@@ -77,14 +77,14 @@ static const LingoV4Bytecode lingoV4[] = {
 	// 0x44, push a constant
 	{ 0x45, LC::c_namepush,		"bN" },
 	{ 0x46, LC::cb_varrefpush,  "bN" },
-	{ 0x48, LC::cb_globalpush,	"bN" }, // used in event scripts
-	{ 0x49, LC::cb_globalpush,	"bN" },
-	{ 0x4a, LC::cb_thepush,		"bN" },
+	{ 0x48, LC::cb_globalpush,	"bcN" }, // used in event scripts
+	{ 0x49, LC::cb_globalpush,	"bcN" },
+	{ 0x4a, LC::cb_thepush,		"bcN" },
 	{ 0x4b, LC::cb_varpush,		"bpaN" },
 	{ 0x4c, LC::cb_varpush,		"bpvN" },
-	{ 0x4e, LC::cb_globalassign,"bN" }, // used in event scripts
-	{ 0x4f, LC::cb_globalassign,"bN" },
-	{ 0x50, LC::cb_theassign,	"bN" },
+	{ 0x4e, LC::cb_globalassign,"bcN" }, // used in event scripts
+	{ 0x4f, LC::cb_globalassign,"bcN" },
+	{ 0x50, LC::cb_theassign,	"bcN" },
 	{ 0x51, LC::cb_varassign,	"bpaN" },
 	{ 0x52, LC::cb_varassign,	"bpvN" },
 	{ 0x53, LC::c_jump,			"jb" },
@@ -113,14 +113,14 @@ static const LingoV4Bytecode lingoV4[] = {
 	// 0x84, push a constant
 	{ 0x85, LC::c_namepush,		"wN" },
 	{ 0x86, LC::cb_varrefpush,  "wN" },
-	{ 0x88, LC::cb_globalpush,	"wN" }, // used in event scripts
-	{ 0x89, LC::cb_globalpush,	"wN" },
-	{ 0x8a, LC::cb_thepush,		"wN" },
+	{ 0x88, LC::cb_globalpush,	"wcN" }, // used in event scripts
+	{ 0x89, LC::cb_globalpush,	"wcN" },
+	{ 0x8a, LC::cb_thepush,		"wcN" },
 	{ 0x8b, LC::cb_varpush,		"wpaN" },
 	{ 0x8c, LC::cb_varpush,		"wpvN" },
-	{ 0x8e, LC::cb_globalassign,"wN" }, // used in event scripts
-	{ 0x8f, LC::cb_globalassign,"wN" },
-	{ 0x90, LC::cb_theassign, 	"wN" },
+	{ 0x8e, LC::cb_globalassign,"wcN" }, // used in event scripts
+	{ 0x8f, LC::cb_globalassign,"wcN" },
+	{ 0x90, LC::cb_theassign, 	"wcN" },
 	{ 0x91, LC::cb_varassign,	"wpaN" },
 	{ 0x92, LC::cb_varassign,	"wpvN" },
 	{ 0x93, LC::c_jump,			"jw" },
@@ -568,22 +568,29 @@ void LC::cb_call() {
 
 
 void LC::cb_globalpush() {
+	uint cachePc = g_lingo->readVarCache();
 	Common::String name = g_lingo->readString();
+	debugC(3, kDebugLingoExec, "cb_globalpush: pushing %s to stack", name.c_str());
+	Datum *slot = g_lingo->lookupGlobalCached(cachePc, name, false);
+	if (slot) {
+		g_debugger->varReadHook(name);
+		g_lingo->push(*slot);
+		return;
+	}
 	Datum target(name);
 	target.type = GLOBALREF;
-	debugC(3, kDebugLingoExec, "cb_globalpush: pushing %s to stack", name.c_str());
 	Datum result = g_lingo->varFetch(target);
 	g_lingo->push(result);
 }
 
 
 void LC::cb_globalassign() {
+	uint cachePc = g_lingo->readVarCache();
 	Common::String name = g_lingo->readString();
-	Datum target(name);
-	target.type = GLOBALREF;
 	debugC(3, kDebugLingoExec, "cb_globalassign: assigning to %s", name.c_str());
 	Datum source = g_lingo->pop();
-	g_lingo->varAssign(target, source);
+	// Same as varAssign() with a GLOBALREF, globals are created on assignment
+	*g_lingo->lookupGlobalCached(cachePc, name, true) = source;
 }
 
 void LC::cb_objectfieldassign() {
@@ -608,9 +615,14 @@ void LC::cb_varrefpush() {
 
 void LC::cb_theassign() {
 	// cb_theassign is for setting script/factory-level properties
+	uint cachePc = g_lingo->readVarCache();
 	Common::String name = g_lingo->readString();
 	Datum value = g_lingo->pop();
-	if (g_lingo->_state->me.type == OBJECT) {
+	Datum *slot = g_lingo->lookupPropCached(cachePc, name);
+	if (slot) {
+		g_debugger->propWriteHook(name);
+		*slot = value;
+	} else if (g_lingo->_state->me.type == OBJECT) {
 		// Don't bother checking if the property is defined, leave that to the object.
 		// For D3-style anonymous objects/factories, you are allowed to define whatever properties you like.
 		g_debugger->propWriteHook(name);
@@ -641,7 +653,14 @@ void LC::cb_theassign2() {
 }
 
 void LC::cb_thepush() {
+	uint cachePc = g_lingo->readVarCache();
 	Common::String name = g_lingo->readString();
+	Datum *slot = g_lingo->lookupPropCached(cachePc, name);
+	if (slot) {
+		g_lingo->push(*slot);
+		g_debugger->propReadHook(name);
+		return;
+	}
 	if (g_lingo->_state->me.type == OBJECT) {
 		if (g_lingo->_state->me.u.obj->hasProp(name)) {
 			g_lingo->push(g_lingo->_state->me.u.obj->getProp(name));
@@ -680,21 +699,35 @@ void LC::cb_thepush2() {
 }
 
 void LC::cb_varpush() {
+	int slotId = g_lingo->readInt();
 	Common::String name = g_lingo->readString();
+	debugC(3, kDebugLingoExec, "cb_varpush: pushing %s to stack", name.c_str());
+	Datum *slot = g_lingo->lookupLocalSlot(slotId, name);
+	if (slot) {
+		g_debugger->varReadHook(name);
+		g_lingo->push(*slot);
+		return;
+	}
 	Datum target(name);
 	target.type = LOCALREF;
-	debugC(3, kDebugLingoExec, "cb_varpush: pushing %s to stack", name.c_str());
 	Datum result = g_lingo->varFetch(target);
 	g_lingo->push(result);
 }
 
 
 void LC::cb_varassign() {
+	int slotId = g_lingo->readInt();
 	Common::String name = g_lingo->readString();
-	Datum target(name);
-	target.type = LOCALREF;
 	debugC(3, kDebugLingoExec, "cb_varassign: assigning to %s", name.c_str());
 	Datum source = g_lingo->pop();
+	Datum *slot = g_lingo->lookupLocalSlot(slotId, name);
+	if (slot) {
+		*slot = source;
+		g_debugger->varWriteHook(name);
+		return;
+	}
+	Datum target(name);
+	target.type = LOCALREF;
 	// Local variables should be initialised by the script, no varCreate here
 	g_lingo->varAssign(target, source);
 }
@@ -1513,7 +1546,10 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 				size_t argc = strlen(g_lingo->_lingoV4[opcode]->proto);
 				if (argc) {
 					bool codeName = false;
+					bool codeSlot = false;
+					bool codeCache = false;
 					int arg = 0;
+					int slot = -1;
 					for (uint c = 0; c < argc; c++) {
 						switch (g_lingo->_lingoV4[opcode]->proto[c]) {
 						case 'b':
@@ -1561,7 +1597,9 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 							break;
 						case 'a':
 							// argument is a function argument ID
+							codeSlot = true;
 							if (argMap.contains(arg)) {
+								slot = arg;
 								arg = argMap[arg];
 							} else {
 								warning("No argument name found for ID %d", arg);
@@ -1570,13 +1608,19 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 							break;
 						case 'v':
 							// argument is a local variable ID
+							codeSlot = true;
 							if (varMap.contains(arg)) {
+								slot = argNames->size() + arg;
 								arg = varMap[arg];
 							} else {
 								warning("No variable name found for ID %d", arg);
 								arg = -1;
 							}
 							break;
+						case 'c':
+							// lookup gets an inline cache
+							codeCache = true;
+							break;
 						case 'j':
 							// argument refers to a code offset; fix alignment in post
 							jumpList.push_back(offsetList.size());
@@ -1589,6 +1633,11 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 							break;
 						}
 					}
+					// frame slot as bound by Lingo::pushContext(), -1 to look up by name
+					if (codeSlot)
+						codeInt(slot);
+					if (codeCache)
+						codeVarCache();
 					if (codeName) {
 						codeString(_assemblyArchive->getName(arg).c_str());
 					} else {
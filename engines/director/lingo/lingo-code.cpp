@@ -74,12 +74,12 @@ static const struct FuncDescr {
 	{ LC::c_argcpush,		"c_argcpush",		"i" },
 	{ LC::c_arraypush,		"c_arraypush",		"i" },
 	{ LC::c_assign,			"c_assign",			""  },
-	{ LC::c_callcmd,		"c_callcmd",		"si" },
-	{ LC::c_callfunc,		"c_callfunc",		"si" },
+	{ LC::c_callcmd,		"c_callcmd",		"sia" },
+	{ LC::c_callfunc,		"c_callfunc",		"sia" },
 	{ LC::c_charToOf,		"c_charToOf",		"" },	// D3
 	{ LC::c_charToOfRef,	"c_charToOfRef",	"" },	// D3
 	{ LC::c_concat,			"c_concat",			"" },
-	{ LC::c_constpush,		"c_constpush",		"s" },
+	{ LC::c_constpush,		"c_constpush",		"sa" },
 	{ LC::c_contains,		"c_contains",		"" },
 	{ LC::c_delete,			"c_delete", 		"" },
 	{ LC::c_div,			"c_div",			"" },
@@ -87,8 +87,9 @@ static const struct FuncDescr {
 	{ LC::c_field,			"c_field",			"" },
 	{ LC::c_fieldref,		"c_fieldref",		"" },
 	{ LC::c_floatpush,		"c_floatpush",		"f" },
+	{ LC::c_globalassign,	"c_globalassign",	"cs" },
 	{ LC::c_globalinit,		"c_globalinit",		"s" },
-	{ LC::c_globalpush,		"c_globalpush",		"s" },
+	{ LC::c_globalpush,		"c_globalpush",		"cs" },
 	{ LC::c_globalrefpush,	"c_globalrefpush",	"s" },
 	{ LC::c_ge,				"c_ge",				"" },
 	{ LC::c_gt,				"c_gt",				"" },
@@ -104,6 +105,8 @@ static const struct FuncDescr {
 	{ LC::c_lineToOfRef,	"c_lineToOfRef",	"" },	// D3
 	{ LC::c_localpush,		"c_localpush",		"s" },
 	{ LC::c_localrefpush,	"c_localrefpush",	"s" },
+	{ LC::c_localslotassign,"c_localslotassign","is" },
+	{ LC::c_localslotpush,	"c_localslotpush",	"is" },
 	{ LC::c_lt,				"c_lt",				"" },
 	{ LC::c_mod,			"c_mod",			"" },
 	{ LC::c_mul,			"c_mul",			"" },
@@ -117,7 +120,8 @@ static const struct FuncDescr {
 	{ LC::c_or,				"c_or",				"" },
 	{ LC::c_procret,		"c_procret",		"" },
 	{ LC::c_proparraypush,	"c_proparraypush",	"i" },
-	{ LC::c_proppush,		"c_proppush",		"s" },
+	{ LC::c_propassign,		"c_propassign",		"cs" },
+	{ LC::c_proppush,		"c_proppush",		"cs" },
 	{ LC::c_proprefpush,	"c_proprefpush",	"s" },
 	{ LC::c_putafter,		"c_putafter",		"" },	// D3
 	{ LC::c_putbefore,		"c_putbefore",		"" },	// D3
@@ -142,8 +146,8 @@ static const struct FuncDescr {
 	{ LC::cb_call,			"cb_call",			"s" },
 	{ LC::cb_delete,		"cb_delete",		"i" },
 	{ LC::cb_hilite,		"cb_hilite",		"" },
-	{ LC::cb_globalassign,	"cb_globalassign",	"s" },
-	{ LC::cb_globalpush,	"cb_globalpush",	"s" },
+	{ LC::cb_globalassign,	"cb_globalassign",	"cs" },
+	{ LC::cb_globalpush,	"cb_globalpush",	"cs" },
 	{ LC::cb_list,			"cb_list",			"" },
 	{ LC::cb_proplist,		"cb_proplist",		"" },
 	{ LC::cb_localcall,		"cb_localcall",		"i" },
@@ -151,15 +155,15 @@ static const struct FuncDescr {
 	{ LC::cb_objectfieldassign, "cb_objectfieldassign", "s" },
 	{ LC::cb_objectfieldpush, "cb_objectfieldpush", "s" },
 	{ LC::cb_varrefpush,	"cb_varrefpush",	"s" },
-	{ LC::cb_theassign,		"cb_theassign",		"s" },
+	{ LC::cb_theassign,		"cb_theassign",		"cs" },
 	{ LC::cb_theassign2,	"cb_theassign2",	"s" },
-	{ LC::cb_thepush,		"cb_thepush",		"s" },
+	{ LC::cb_thepush,		"cb_thepush",		"cs" },
 	{ LC::cb_thepush2,		"cb_thepush2",		"s" },
 	{ LC::cb_unk,			"cb_unk",			"i" },
 	{ LC::cb_unk1,			"cb_unk1",			"ii" },
 	{ LC::cb_unk2,			"cb_unk2",			"iii" },
-	{ LC::cb_varassign,		"cb_varassign",		"s" },
-	{ LC::cb_varpush,		"cb_varpush",		"s" },
+	{ LC::cb_varassign,		"cb_varassign",		"is" },
+	{ LC::cb_varpush,		"cb_varpush",		"is" },
 	{ LC::cb_v4assign,		"cb_v4assign",		"i" },
 	{ LC::cb_v4assign2,		"cb_v4assign2",		"i" },
 	{ LC::cb_v4theentitypush,"cb_v4theentitypush","i" },
@@ -296,6 +300,18 @@ void Lingo::pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRet
 	}
 	_state->localVars = localvars;
 
+	// Bind the slots used by c_localslotpush and friends. Nodes of a
+	// HashMap do not move when it grows, so the pointers stay valid until
+	// the frame is popped.
+	if (funcSym.argNames) {
+		for (auto &it : *funcSym.argNames)
+			fp->localSlots.push_back(&localvars->getVal(it));
+	}
+	if (funcSym.varNames) {
+		for (auto &it : *funcSym.varNames)
+			fp->localSlots.push_back(&localvars->getVal(it));
+	}
+
 	fp->stackSizeBefore = _state->stack.size();
 
 	callstack.push_back(fp);
@@ -382,12 +398,11 @@ void Lingo::freezePlayState() {
 }
 
 void LC::c_constpush() {
-	Common::String name(g_lingo->readString());
+	g_lingo->readString();
+	Common::InternedString atom = g_lingo->readAtom();
 
 	Symbol funcSym;
-	if (g_lingo->_builtinConsts.contains(name)) {
-		funcSym = g_lingo->_builtinConsts[name];
-	}
+	g_lingo->_builtinConsts.tryGetVal(atom, funcSym);
 
 	LC::call(funcSym, 0, true);
 }
@@ -523,23 +538,90 @@ void LC::c_varpush() {
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
+	uint cachePc = g_lingo->readVarCache();
+	Common::String name(g_lingo->readString());
+	Datum *slot = g_lingo->lookupGlobalCached(cachePc, name, false);
+	if (slot) {
+		g_debugger->varReadHook(name);
+		g_lingo->push(*slot);
+		return;
+	}
+	Datum d(name);
+	d.type = GLOBALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
+void LC::c_globalassign() {
+	uint cachePc = g_lingo->readVarCache();
+	Common::String name(g_lingo->readString());
+	Datum value = g_lingo->pop();
+	*g_lingo->lookupGlobalCached(cachePc, name, true) = value;
+}
+
 void LC::c_localpush() {
 	LC::c_localrefpush();
 	Datum d = g_lingo->pop();
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
+void LC::c_localslotpush() {
+	int slotId = g_lingo->readInt();
+	Common::String name(g_lingo->readString());
+	Datum *slot = g_lingo->lookupLocalSlot(slotId, name);
+	if (slot) {
+		g_debugger->varReadHook(name);
+		g_lingo->push(*slot);
+		return;
+	}
+	Datum d(name);
+	d.type = LOCALREF;
+	g_lingo->push(g_lingo->varFetch(d));
+}
+
+void LC::c_localslotassign() {
+	int slotId = g_lingo->readInt();
+	Common::String name(g_lingo->readString());
+	Datum value = g_lingo->pop();
+	Datum *slot = g_lingo->lookupLocalSlot(slotId, name);
+	if (slot) {
+		*slot = value;
+		g_debugger->varWriteHook(name);
+		return;
+	}
+	Datum d(name);
+	d.type = LOCALREF;
+	g_lingo->varAssign(d, value);
+}
+
 void LC::c_proppush() {
-	LC::c_proprefpush();
-	Datum d = g_lingo->pop();
+	uint cachePc = g_lingo->readVarCache();
+	Common::String name(g_lingo->readString());
+	Datum *slot = g_lingo->lookupPropCached(cachePc, name);
+	if (slot) {
+		g_debugger->varReadHook(name);
+		g_lingo->push(*slot);
+		return;
+	}
+	Datum d(name);
+	d.type = PROPREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
+void LC::c_propassign() {
+	uint cachePc = g_lingo->readVarCache();
+	Common::String name(g_lingo->readString());
+	Datum value = g_lingo->pop();
+	Datum *slot = g_lingo->lookupPropCached(cachePc, name);
+	if (slot) {
+		*slot = value;
+		g_debugger->varWriteHook(name);
+		return;
+	}
+	Datum d(name);
+	d.type = PROPREF;
+	g_lingo->varAssign(d, value);
+}
+
 void LC::c_stackpeek() {
 	int peekOffset = g_lingo->readInt();
 	g_lingo->push(g_lingo->peek(peekOffset));
@@ -1578,19 +1660,25 @@ void LC::c_callcmd() {
 	Common::String name(g_lingo->readString());
 
 	int nargs = g_lingo->readInt();
+	Common::InternedString atom = g_lingo->readAtom();
 
-	LC::call(name, nargs, false);
+	LC::call(name, atom, nargs, false);
 }
 
 void LC::c_callfunc() {
 	Common::String name(g_lingo->readString());
 
 	int nargs = g_lingo->readInt();
+	Common::InternedString atom = g_lingo->readAtom();
 
-	LC::call(name, nargs, true);
+	LC::call(name, atom, nargs, true);
 }
 
 void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
+	call(name, g_lingo->findAtom(name), nargs, allowRetVal);
+}
+
+void LC::call(const Common::String &name, Common::InternedString atom, int nargs, bool allowRetVal) {
 	if (debugChannelSet(3, kDebugLingoExec))
 		g_lingo->printArgs(name.c_str(), nargs, "call:");
 
@@ -1658,27 +1746,23 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 	// Handler
 	funcSym = g_lingo->getHandler(name);
 
-	if (g_lingo->_builtinListHandlers.contains(name) && nargs >= 1) {
+	if (nargs >= 1 && g_lingo->_builtinListHandlers.contains(atom)) {
 		// Lingo builtin functions in the "List" category have very strange override mechanics.
 		// If the first argument is an ARRAY or PARRAY, it will use the builtin.
 		// Otherwise, it will fall back to whatever handler is defined globally.
 		Datum firstArg = g_lingo->peek(nargs - 1);
 		if (firstArg.type == ARRAY || firstArg.type == PARRAY ||
 				firstArg.type == POINT || firstArg.type == RECT) {
-			funcSym = g_lingo->_builtinListHandlers[name];
+			funcSym = g_lingo->_builtinListHandlers[atom];
 		}
 	}
 
 	if (funcSym.type == VOIDSYM) { // The built-ins could be overridden
 		// Builtin
 		if (allowRetVal) {
-			if (g_lingo->_builtinFuncs.contains(name)) {
-				funcSym = g_lingo->_builtinFuncs[name];
-			}
+			g_lingo->_builtinFuncs.tryGetVal(atom, funcSym);
 		} else {
-			if (g_lingo->_builtinCmds.contains(name)) {
-				funcSym = g_lingo->_builtinCmds[name];
-			}
+			g_lingo->_builtinCmds.tryGetVal(atom, funcSym);
 		}
 	}
 
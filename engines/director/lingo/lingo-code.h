@@ -82,8 +82,12 @@ void c_proprefpush();
 void c_varpush();
 void c_globalinit();
 void c_globalpush();
+void c_globalassign();
 void c_localpush();
+void c_localslotpush();
+void c_localslotassign();
 void c_proppush();
+void c_propassign();
 void c_argcpush();
 void c_argcnoretpush();
 void c_arraypush();
@@ -125,6 +129,7 @@ void c_callfunc();
 
 void call(const Symbol &targetSym, int nargs, bool allowRetVal);
 void call(const Common::String &name, int nargs, bool allowRetVal);
+void call(const Common::String &name, Common::InternedString atom, int nargs, bool allowRetVal);
 
 void c_procret();
 void procret();
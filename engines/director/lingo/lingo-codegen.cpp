@@ -110,6 +110,8 @@ LingoCompiler::LingoCompiler() {
 
 	_indef = false;
 	_methodVars = nullptr;
+	_methodLocals = nullptr;
+	_methodArgCount = 0;
 
 	_linenumber = _colnumber = _bytenumber = 0;
 	_lines[0] = _lines[1] = _lines[2] = nullptr;
@@ -305,6 +307,32 @@ int LingoCompiler::codeFloat(double f) {
 	return _currentAssembly->size();
 }
 
+int LingoCompiler::codeAtom(const Common::String &s) {
+	// The name is interned once here, so the call does not have to hash
+	// it again to look up the builtin tables, see LC::call()
+	int numInsts = calcCodeAlignment(sizeof(Common::InternedString));
+
+	int pos = _currentAssembly->size();
+
+	for (int i = 0; i < numInsts; i++)
+		_currentAssembly->push_back(0);
+
+	Common::InternedString *dst = (Common::InternedString *)((byte *)&_currentAssembly->front() + pos * sizeof(inst));
+
+	*dst = g_lingo->intern(s);
+
+	return _currentAssembly->size();
+}
+
+int LingoCompiler::codeVarCache() {
+	// Filled in on first execution, see Lingo::lookupGlobalCached()
+	// and Lingo::lookupPropCached()
+	for (int i = 0; i < kVarCacheSize; i++)
+		code1(STOP);
+
+	return _currentAssembly->size();
+}
+
 int LingoCompiler::codeInt(int val) {
 	inst i = nullptr;
 	WRITE_UINT32(&i, val);
@@ -322,6 +350,8 @@ int LingoCompiler::codeCmd(const Common::String &s, int numpar) {
 	WRITE_UINT32(&num, numpar);
 	code1(num);
 
+	codeAtom(s);
+
 	return ret;
 }
 
@@ -334,13 +364,49 @@ int LingoCompiler::codeFunc(const Common::String &s, int numpar) {
 	WRITE_UINT32(&num, numpar);
 	code1(num);
 
+	codeAtom(s);
+
 	return ret;
 }
 
 void LingoCompiler::codeVarSet(const Common::String &name) {
 	registerMethodVar(name);
-	codeVarRef(name);
-	code1(LC::c_assign);
+
+	VarType type = (*_methodVars)[name];
+	if (type == kVarGlobal) {
+		code1(LC::c_globalassign);
+		codeVarCache();
+	} else if ((type == kVarLocal || type == kVarArgument) && _indef && _methodSlots.contains(name)) {
+		code1(LC::c_localslotassign);
+		codeInt(_methodSlots[name]);
+	} else if (type == kVarProperty || type == kVarInstance) {
+		code1(LC::c_propassign);
+		codeVarCache();
+	} else {
+		codeVarRef(name);
+		code1(LC::c_assign);
+		return;
+	}
+	codeString(name.c_str());
+}
+
+bool LingoCompiler::codeVarAssign(Node *var) {
+	// Plain variable targets skip the reference and assign directly,
+	// anything visitVarNode() would turn into a constant keeps c_assign
+	if (var->type != kVarNode)
+		return false;
+
+	VarNode *node = static_cast<VarNode *>(var);
+	if (g_director->getVersion() < 400 || (g_director->getCurrentMovie() && g_director->getCurrentMovie()->_allowOutdatedLingo)) {
+		if (castNumToNum(node->name->c_str()) != -1)
+			return false;
+	}
+	if (g_lingo->_builtinConsts.contains(g_lingo->findAtom(*node->name)))
+		return false;
+
+	NodeStore store(node);
+	codeVarSet(*node->name);
+	return true;
 }
 
 void LingoCompiler::codeVarRef(const Common::String &name) {
@@ -384,14 +450,21 @@ void LingoCompiler::codeVarGet(const Common::String &name) {
 		break;
 	case kVarGlobal:
 		code1(LC::c_globalpush);
+		codeVarCache();
 		break;
 	case kVarLocal:
 	case kVarArgument:
-		code1(LC::c_localpush);
+		if (_indef && _methodSlots.contains(name)) {
+			code1(LC::c_localslotpush);
+			codeInt(_methodSlots[name]);
+		} else {
+			code1(LC::c_localpush);
+		}
 		break;
 	case kVarProperty:
 	case kVarInstance:
 		code1(LC::c_proppush);
+		codeVarCache();
 		break;
 	}
 	codeString(name.c_str());
@@ -403,6 +476,10 @@ void LingoCompiler::registerMethodVar(const Common::String &name, VarType type)
 			type = kVarLocal;
 		}
 		(*_methodVars)[name] = type;
+		if (type == kVarLocal && _methodLocals) {
+			_methodSlots[name] = _methodArgCount + _methodLocals->size();
+			_methodLocals->push_back(name);
+		}
 		if (type == kVarProperty || type == kVarInstance) {
 			if (!_assemblyContext->hasProp(name))
 				_assemblyContext->setProp(name, Datum(), true);
@@ -481,11 +558,25 @@ bool LingoCompiler::visitHandlerNode(HandlerNode *node) {
 	VarTypeHash *mainMethodVars = _methodVars;
 	_methodVars = new VarTypeHash;
 
+	Common::Array<Common::String> *argNames = new Common::Array<Common::String>;
 	if (_inFactory) {
-		registerMethodVar("me", kVarArgument);
+		argNames->push_back("me");
 	}
 	for (uint i = 0; i < node->args->size(); i++) {
-		registerMethodVar(*(*node->args)[i], kVarArgument);
+		argNames->push_back(Common::String((*node->args)[i]->c_str()));
+	}
+	Common::Array<Common::String> *varNames = new Common::Array<Common::String>;
+
+	_methodSlots.clear();
+	for (uint i = 0; i < argNames->size(); i++) {
+		if (!_methodSlots.contains((*argNames)[i]))
+			_methodSlots[(*argNames)[i]] = i;
+	}
+	_methodArgCount = argNames->size();
+	_methodLocals = varNames;
+
+	for (uint i = 0; i < argNames->size(); i++) {
+		registerMethodVar((*argNames)[i], kVarArgument);
 	}
 	for (auto &i : *mainMethodVars) {
 		if (i._value == kVarGlobal)
@@ -501,18 +592,7 @@ bool LingoCompiler::visitHandlerNode(HandlerNode *node) {
 	if (debugChannelSet(1, kDebugCompile))
 		debug("define handler \"%s\" (len: %d)", node->name->c_str(), _currentAssembly->size() - 1);
 
-	Common::Array<Common::String> *argNames = new Common::Array<Common::String>;
-	if (_inFactory) {
-		argNames->push_back("me");
-	}
-	for (uint i = 0; i < node->args->size(); i++) {
-		argNames->push_back(Common::String((*node->args)[i]->c_str()));
-	}
-	Common::Array<Common::String> *varNames = new Common::Array<Common::String>;
-	for (auto &it : *_methodVars) {
-		if (it._value == kVarLocal)
-			varNames->push_back(Common::String(it._key));
-	}
+	_methodLocals = nullptr;
 
 	if (debugChannelSet(1, kDebugCompile)) {
 		debug("Function vars");
@@ -622,8 +702,10 @@ bool LingoCompiler::visitPutIntoNode(PutIntoNode *node) {
 		registerMethodVar(*static_cast<VarNode *>(node->var)->name);
 	}
 	COMPILE(node->val);
-	COMPILE_REF(node->var);
-	code1(LC::c_assign);
+	if (!codeVarAssign(node->var)) {
+		COMPILE_REF(node->var);
+		code1(LC::c_assign);
+	}
 	return true;
 }
 
@@ -822,8 +904,10 @@ bool LingoCompiler::visitSetNode(SetNode *node) {
 		registerMethodVar(*static_cast<VarNode *>(node->var)->name);
 	}
 	COMPILE(node->val);
-	COMPILE_REF(node->var);
-	code1(LC::c_assign);
+	if (!codeVarAssign(node->var)) {
+		COMPILE_REF(node->var);
+		code1(LC::c_assign);
+	}
 	return true;
 }
 
@@ -1265,9 +1349,10 @@ bool LingoCompiler::visitVarNode(VarNode *node) {
 			return true;
 		}
 	}
-	if (g_lingo->_builtinConsts.contains(*node->name)) {
+	if (g_lingo->_builtinConsts.contains(g_lingo->findAtom(*node->name))) {
 		code1(LC::c_constpush);
 		codeString(node->name->c_str());
+		codeAtom(*node->name);
 		return true;
 	}
 	if (_refMode) {
@@ -1483,7 +1568,7 @@ bool LingoCompiler::visitTheOfNode(TheOfNode *node) {
 		return true;
 	}
 
-	if (g_lingo->_builtinFuncs.contains(*node->prop)) {
+	if (g_lingo->_builtinFuncs.contains(g_lingo->findAtom(*node->prop))) {
 		COMPILE(node->obj);
 		codeFunc(*node->prop, 1);
 		return true;
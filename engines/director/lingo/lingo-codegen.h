@@ -40,12 +40,15 @@ public:
 	int code2(inst code_1, inst code_2) { int o = code1(code_1); code1(code_2); return o; }
 	int code3(inst code_1, inst code_2, inst code_3) { int o = code1(code_1); code1(code_2); code1(code_3); return o; }
 	int code4(inst code_1, inst code_2, inst code_3, inst code_4) { int o = code1(code_1); code1(code_2); code1(code_3); code1(code_4); return o; }
+	int codeAtom(const Common::String &s);
 	int codeCmd(const Common::String &s, int numpar);
 	int codeFloat(double f);
 	int codeFunc(const Common::String &s, int numpar);
 	int codeInt(int val);
 	int codeString(const char *s);
+	int codeVarCache();
 	void codeVarSet(const Common::String &name);
+	bool codeVarAssign(Node *var);
 	void codeVarRef(const Common::String &name);
 	void codeVarGet(const Common::String &name);
 	int getTheFieldID(int entity, const Common::String &field, bool silent = false);
@@ -68,6 +71,11 @@ public:
 	bool _refMode;
 
 	Common::HashMap<Common::String, VarType, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> *_methodVars;
+	// Frame slots of the handler being compiled: args first, then locals in
+	// order of first use. See Lingo::pushContext()
+	Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _methodSlots;
+	Common::Array<Common::String> *_methodLocals;
+	uint _methodArgCount;
 
 	bool _hadError;
 
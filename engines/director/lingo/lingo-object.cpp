@@ -537,12 +537,16 @@ void LM::m_dispose(int nargs) {
 
 /* ScriptContext */
 
+uint32 ScriptContext::_nextSerial = 1;
+
 ScriptContext::ScriptContext(Common::String name, ScriptType type, int id, uint16 castLibHint, uint16 parentNumber, int scriptId)
 	: Object<ScriptContext>(name), _scriptType(type), _id(id), _castLibHint(castLibHint), _parentNumber(parentNumber), _scriptId(scriptId) {
 	_objType = kScriptObj;
+	_serial = _nextSerial++;
 }
 
 ScriptContext::ScriptContext(const ScriptContext &sc) : Object<ScriptContext>(sc) {
+	_serial = _nextSerial++;
 	_scriptType = sc._scriptType;
 	_functionNames = sc._functionNames;
 	for (auto &it : sc._functionHandlers) {
@@ -665,6 +669,15 @@ Datum ScriptContext::getProp(const Common::String &propName) {
 	return _properties[propName]; // return new property
 }
 
+Datum *ScriptContext::getOwnPropSlot(const Common::String &propName) {
+	// Properties are never removed, so the returned pointer stays valid
+	// for the lifetime of the object
+	DatumHash::iterator it = _properties.find(propName);
+	if (it == _properties.end())
+		return nullptr;
+	return &it->_value;
+}
+
 Common::String ScriptContext::getPropAt(uint32 index) {
 	uint32 target = 1;
 	for (auto &it : _propertyNames) {
@@ -230,6 +230,8 @@ private:
 	DatumHash _properties;
 	Common::Array<Common::String> _propertyNames;
 	bool _onlyInLctxContexts = false;
+	uint32 _serial;		// unique per instance, keys the call-site property caches
+	static uint32 _nextSerial;
 
 public:
 	ScriptContext(Common::String name, ScriptType type = kNoneScript, int id = 0, uint16 castLibHint = 0, uint16 parentNumber = 0, int scriptId = 0);
@@ -250,6 +252,9 @@ public:
 	uint32 getPropCount() override;
 	void setProp(const Common::String &propName, const Datum &value, bool force = false) override;
 
+	uint32 getSerial() const { return _serial; }
+	Datum *getOwnPropSlot(const Common::String &propName);
+
 	Symbol define(const Common::String &name, ScriptData *code, Common::Array<Common::String> *argNames, Common::Array<Common::String> *varNames);
 
 	Common::String formatFunctionList(const char *prefix);
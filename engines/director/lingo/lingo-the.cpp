@@ -2617,9 +2617,10 @@ void Lingo::getObjectProp(Datum &obj, Common::String &propName) {
 		return;
 	}
 
-	if (_builtinFuncs.contains(propName) && _builtinFuncs[propName].nargs == 1) {
+	Common::InternedString propAtom = findAtom(propName);
+	if (_builtinFuncs.contains(propAtom) && _builtinFuncs[propAtom].nargs == 1) {
 		push(obj);
-		LC::call(_builtinFuncs[propName], 1, true);
+		LC::call(_builtinFuncs[propAtom], 1, true);
 		return;
 	}
 	g_lingo->lingoError("Lingo::getObjectProp: Invalid object: %s", obj.asString(true).c_str());
@@ -170,12 +170,13 @@ LingoState::~LingoState() {
 
 }
 
-Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
+Lingo::Lingo(DirectorEngine *vm) : _vm(vm), _atoms(true) {
 	g_lingo = this;
 
 	_state = nullptr;
 	_currentChannelId = -1;
 	_globalCounter = 0;
+	_globalvarsGeneration = 1;
 	_freezeState = false;
 	_freezePlay = false;
 	_playDone = false;
@@ -563,11 +564,20 @@ Common::String Lingo::decodeInstruction(ScriptData *sd, uint pc, uint *newPc) {
 					res += Common::String::format(" %s", field2str(v));
 					break;
 				}
+			case 'c':
+				// inline variable cache, not part of the listing
+				pc += kVarCacheSize;
+				continue;
+			case 'a':
+				// interned copy of the preceding name
+				pc += calcCodeAlignment(sizeof(Common::InternedString));
+				continue;
 			default:
 				warning("Lingo::decodeInstruction(): Unknown parameter type: %c", pars[-1]);
 			}
 
-			if (*pars)
+			// interned names are not listed either
+			if (*pars && *pars != 'a')
 				res += ',';
 		}
 	} else {
@@ -1896,6 +1906,68 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 	return result;
 }
 
+Datum *Lingo::lookupLocalSlot(int slot, const Common::String &name) {
+	// Slots are bound by pushContext() in the order of the handler's
+	// argNames followed by its varNames.
+	if (slot >= 0 && !_state->callstack.empty()) {
+		CFrame *fp = _state->callstack.back();
+		if (fp->sp.u.defn == _state->script && slot < (int)fp->localSlots.size())
+			return fp->localSlots[slot];
+	}
+	if (_state->localVars) {
+		DatumHash::iterator it = _state->localVars->find(name);
+		if (it != _state->localVars->end())
+			return &it->_value;
+	}
+	return nullptr;
+}
+
+Datum *Lingo::lookupGlobalCached(uint cachePc, const Common::String &name, bool create) {
+	inst *cache = &(*_state->script)[cachePc];
+	Datum **slot = (Datum **)&cache[kVarCacheSlot];
+	if (*slot && READ_UINT32(&cache[kVarCacheStamp]) == _globalvarsGeneration)
+		return *slot;
+
+	Datum *res = nullptr;
+	if (create) {
+		res = &_globalvars.getOrCreateVal(name);
+	} else {
+		DatumHash::iterator it = _globalvars.find(name);
+		if (it != _globalvars.end())
+			res = &it->_value;
+	}
+	if (res) {
+		WRITE_UINT32(&cache[kVarCacheStamp], _globalvarsGeneration);
+		*slot = res;
+	}
+	return res;
+}
+
+Datum *Lingo::lookupPropCached(uint cachePc, const Common::String &name) {
+	if (_state->me.type != OBJECT || !(_state->me.u.obj->getObjType() & (kFactoryObj | kScriptObj)))
+		return nullptr;
+
+	ScriptContext *me = static_cast<ScriptContext *>(_state->me.u.obj);
+	if (me->isDisposed())
+		return nullptr;
+
+	inst *cache = &(*_state->script)[cachePc];
+	ScriptContext **owner = (ScriptContext **)&cache[kVarCacheOwner];
+	Datum **slot = (Datum **)&cache[kVarCacheSlot];
+	if (*owner == me && READ_UINT32(&cache[kVarCacheStamp]) == me->getSerial())
+		return *slot;
+
+	// Only the object's own properties are cached, anything reached through
+	// an ancestor or computed on the fly goes through getProp()/setProp()
+	Datum *res = me->getOwnPropSlot(name);
+	if (res) {
+		*owner = me;
+		WRITE_UINT32(&cache[kVarCacheStamp], me->getSerial());
+		*slot = res;
+	}
+	return res;
+}
+
 Common::U32String Lingo::evalChunkRef(const Datum &var) {
 	Common::U32String result;
 
@@ -58,6 +58,15 @@ int calcCodeAlignment(int l);
 
 typedef Common::Array<inst> ScriptData;
 
+// Inline cache for a variable lookup, stored in the code stream right after
+// the opcode: owner object, owner serial or globals generation, Datum pointer
+enum {
+	kVarCacheOwner = 0,
+	kVarCacheStamp = 1,
+	kVarCacheSlot = 2,
+	kVarCacheSize = 3
+};
+
 struct FuncDesc {
 	Common::String name;
 	const char *proto;
@@ -236,6 +245,7 @@ typedef Common::HashMap<int32, ScriptContext *> ScriptContextHash;
 typedef Common::HashMap<int32, Common::HashMap<Common::String, ScriptContext *> *> FactoryContextHash;
 typedef Common::Array<Datum> StackData;
 typedef Common::HashMap<Common::String, Symbol, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SymbolHash;
+typedef Common::HashMap<Common::InternedString, Symbol> AtomSymbolHash;
 typedef Common::HashMap<Common::String, Datum, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> DatumHash;
 typedef Common::HashMap<Common::String, Builtin *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> BuiltinHash;
 typedef Common::HashMap<Common::String, VarType, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> VarTypeHash;
@@ -262,6 +272,7 @@ struct CFrame {	/* proc/func call stack frame */
 	Datum			defaultRetVal;		/* default return value */
 	int				paramCount;			/* original number of arguments submitted */
 	Common::Array<Datum> paramList;		/* original argument list */
+	Common::Array<Datum *> localSlots;	/* args then local vars, bound by pushContext */
 };
 
 struct LingoEvent {
@@ -425,6 +436,9 @@ public:
 	void cleanLocalVars();
 	void varAssign(const Datum &var, const Datum &value);
 	Datum varFetch(const Datum &var, bool silent = false);
+	Datum *lookupLocalSlot(int slot, const Common::String &name);
+	Datum *lookupGlobalCached(uint cachePc, const Common::String &name, bool create);
+	Datum *lookupPropCached(uint cachePc, const Common::String &name);
 	Common::U32String evalChunkRef(const Datum &var);
 	Datum findVarV4(int varType, const Datum &id);
 	CastMemberID resolveCastMember(const Datum &memberID, const Datum &castLib, CastType type);
@@ -444,6 +458,9 @@ public:
 	double getFloat(uint pc) { return *(double *)(&((*_state->script)[_state->pc])); }
 	char *readString() { char *s = getString(_state->pc); _state->pc += calcStringAlignment(s); return s; }
 	char *getString(uint pc) { return (char *)(&((*_state->script)[_state->pc])); }
+	uint readVarCache() { uint pc = _state->pc; _state->pc += kVarCacheSize; return pc; }
+	Common::InternedString readAtom() { Common::InternedString a = getAtom(_state->pc); _state->pc += calcCodeAlignment(sizeof(Common::InternedString)); return a; }
+	Common::InternedString getAtom(uint pc) { return *(Common::InternedString *)(&((*_state->script)[pc])); }
 
 	Datum getVoid();
 	void pushVoid();
@@ -527,10 +544,17 @@ public:
 
 	int _objectEntityId;
 
-	SymbolHash _builtinCmds;
-	SymbolHash _builtinFuncs;
-	SymbolHash _builtinConsts;
-	SymbolHash _builtinListHandlers;
+	// Lingo names are case-insensitive. Must be declared before the
+	// tables keyed by its atoms.
+	Common::AtomTable _atoms;
+
+	Common::InternedString intern(const Common::String &name) { return _atoms.intern(name); }
+	Common::InternedString findAtom(const Common::String &name) const { return _atoms.find(name); }
+
+	AtomSymbolHash _builtinCmds;
+	AtomSymbolHash _builtinFuncs;
+	AtomSymbolHash _builtinConsts;
+	AtomSymbolHash _builtinListHandlers;
 	SymbolHash _methods;
 	XLibOpenerFuncHash _xlibOpeners;
 	XLibCloserFuncHash _xlibClosers;
@@ -555,6 +579,7 @@ public:
 	Common::HashMap<Common::String, Audio::AudioStream *> _audioAliases;
 
 	DatumHash _globalvars;
+	uint32 _globalvarsGeneration;	// bumped whenever globals are removed, invalidates call-site caches
 
 	FuncHash _functions;
 
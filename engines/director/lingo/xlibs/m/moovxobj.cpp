@@ -137,14 +137,10 @@ void MoovXObj::m_fondler(int nargs) {
 	MoovXObject *me = static_cast<MoovXObject *>(g_lingo->_state->me.u.obj);
 
 	debug(10, "MoovXObj::m_fondler");
-	Graphics::Surface const *frame;
 
 	if (me->_video && me->_video->needsUpdate()) {
-		frame = me->_video->decodeNextFrame();
-		if (frame) {
-			g_system->copyRectToScreen(frame->getPixels(), frame->pitch, me->_x, me->_y, frame->w, frame->h);
+		if (me->_video->decodeNextFrameToScreen(me->_x, me->_y))
 			g_system->updateScreen();
-		}
 	}
 }
 
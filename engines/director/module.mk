@@ -14,6 +14,7 @@ MODULE_OBJS = \
 	game-quirks.o \
 	graphics.o \
 	images.o \
+	inkblit.o \
 	metaengine.o \
 	movie.o \
 	picture.o \
@@ -220,6 +221,15 @@ MODULE_OBJS += \
 
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	inkblitNEON.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	inkblitSSE2.o
+endif
+
 # HACK: Skip this when including the file for detection objects.
 ifeq "$(LOAD_RULES_MK)" "1"
 director-grammar:
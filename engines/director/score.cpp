@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/rational.h"
 #include "common/memstream.h"
+#include "common/profiler.h"
 #include "common/punycode.h"
 #include "common/substream.h"
 
@@ -634,6 +635,8 @@ void Score::updateNextFrameTime() {
 }
 
 void Score::update() {
+	PROFILE_ZONE("Score::update");
+
 	if (_activeFade) {
 		_activeFade = _soundManager->fadeChannels();
 	}
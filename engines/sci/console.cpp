@@ -33,6 +33,7 @@
 #include "sci/engine/selector.h"
 #include "sci/engine/savegame.h"
 #include "sci/engine/gc.h"
+#include "sci/engine/kpathing.h"
 #include "sci/engine/features.h"
 #include "sci/engine/scriptdebug.h"
 #include "sci/sound/midiparser_sci.h"
@@ -120,6 +121,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
+	registerCmd("resource_stats",		WRAP_METHOD(Console, cmdResourceStats));
+	registerCmd("prefetch",			WRAP_METHOD(Console, cmdPrefetch));
 	// Game
 	registerCmd("save_game",			WRAP_METHOD(Console, cmdSaveGame));
 	registerCmd("restore_game",		WRAP_METHOD(Console, cmdRestoreGame));
@@ -128,6 +131,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("room",				WRAP_METHOD(Console, cmdRoomNumber));
 	registerCmd("quit",				WRAP_METHOD(Console, cmdQuit));
 	registerCmd("list_saves",			WRAP_METHOD(Console, cmdListSaves));
+	registerCmd("path_stats",			WRAP_METHOD(Console, cmdPathStats));
+	registerCmd("path_bench",			WRAP_METHOD(Console, cmdPathBench));
 	// Graphics
 	registerCmd("show_map",			WRAP_METHOD(Console, cmdShowMap));
 	registerCmd("set_palette",		WRAP_METHOD(Console, cmdSetPalette));
@@ -163,6 +168,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_mode",			WRAP_METHOD(Console, cmdGCMode));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -233,6 +240,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("send_stats",		WRAP_METHOD(Console, cmdSendStats));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -360,6 +368,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
+	debugPrintf(" resource_stats - Shows load and decompression times per resource type\n");
+	debugPrintf(" prefetch - Enables or disables prefetching of room resources\n");
 	debugPrintf("\n");
 	debugPrintf("Game:\n");
 	debugPrintf(" save_game - Saves the current game state to the hard disk\n");
@@ -369,6 +379,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" version - Shows the resource and interpreter versions\n");
 	debugPrintf(" room - Gets or sets the current room number\n");
 	debugPrintf(" quit - Quits the game\n");
+	debugPrintf(" path_stats - Shows pathfinding cache statistics\n");
+	debugPrintf(" path_bench - Records pathfinding calls and replays them as a benchmark\n");
 	debugPrintf("\n");
 	debugPrintf("Graphics:\n");
 	debugPrintf(" show_map - Switches to visual, priority, control or display screen\n");
@@ -398,6 +410,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_mode - Switches between full and incremental garbage collection\n");
+	debugPrintf(" gc_stats - Shows garbage collection pause times\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -447,6 +461,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" send_stats - Shows the message send rate and selector cache statistics\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -1134,6 +1149,55 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceStats(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1 && !scumm_stricmp(argv[1], "reset")) {
+		resMan->resetLoadStats();
+		debugPrintf("Resource statistics reset\n");
+		return true;
+	}
+
+	debugPrintf("Type          Loads      KB  Load ms  Unpack ms  Reloads  Prefetched  Used\n");
+	for (int i = 0; i < kResourceTypeInvalid; ++i) {
+		const ResourceManager::LoadStats &stats = resMan->getLoadStats((ResourceType)i);
+
+		if (!stats.loads && !stats.reloads)
+			continue;
+
+		debugPrintf("%-12s %6u %7u %8u %10u %8u %11u %5u\n", getResourceTypeName((ResourceType)i),
+			stats.loads, stats.bytes / 1024, stats.loadTime, stats.decompressTime,
+			stats.reloads, stats.prefetched, stats.prefetchHits);
+	}
+
+	debugPrintf("LRU: %d KB used, budget %d KB (initially %d KB), %d KB locked\n",
+		resMan->getMemoryLRU() / 1024, resMan->getMaxMemoryLRU() / 1024,
+		resMan->getBaseMemoryLRU() / 1024, resMan->getMemoryLocked() / 1024);
+	debugPrintf("Prefetching %s, %u resources queued, %u room manifests\n",
+		resMan->isPrefetchEnabled() ? "enabled" : "disabled",
+		resMan->getPrefetchQueueSize(), resMan->getRoomManifestCount());
+	debugPrintf("Use \"%s reset\" to clear these statistics\n", argv[0]);
+	return true;
+}
+
+bool Console::cmdPrefetch(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "on")) {
+			resMan->setPrefetchEnabled(true);
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			resMan->setPrefetchEnabled(false);
+		} else {
+			debugPrintf("Usage: %s [on|off]\n", argv[0]);
+			return true;
+		}
+	}
+
+	debugPrintf("Prefetching of room resources is %s\n", resMan->isPrefetchEnabled() ? "enabled" : "disabled");
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -1163,6 +1227,70 @@ bool Console::cmdRoomNumber(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdPathStats(int argc, const char **argv) {
+	AvoidPathCache *cache = _engine->_gamestate->_avoidPathCache;
+
+	if (argc > 1 && !scumm_stricmp(argv[1], "reset")) {
+		cache->resetStats();
+		debugPrintf("Pathfinding statistics reset\n");
+		return true;
+	}
+
+	const AvoidPathCache::Stats &stats = cache->getStats();
+	debugPrintf("Searches: %u\n", stats.searches);
+	debugPrintf("Visibility graphs: %u hits, %u misses, %u bypassed\n",
+		stats.graphHits, stats.graphMisses, stats.graphBypassed);
+	debugPrintf("Vertex pairs: %u cached, %u computed\n", stats.pairHits, stats.pairMisses);
+	debugPrintf("Use \"%s reset\" to clear these statistics\n", argv[0]);
+	return true;
+}
+
+bool Console::cmdPathBench(int argc, const char **argv) {
+	AvoidPathCache *cache = _engine->_gamestate->_avoidPathCache;
+
+	if (argc < 2) {
+		debugPrintf("Records pathfinding calls and replays them as a benchmark.\n");
+		debugPrintf("Usage: %s record|stop|clear|run [<iterations>]\n", argv[0]);
+		debugPrintf("%u calls recorded%s\n", cache->getRecordedCalls().size(), cache->isRecording() ? ", recording" : "");
+		return true;
+	}
+
+	if (!scumm_stricmp(argv[1], "record")) {
+		cache->setRecording(true);
+		debugPrintf("Recording pathfinding calls (up to %d)\n", AvoidPathCache::kMaxRecordedCalls);
+	} else if (!scumm_stricmp(argv[1], "stop")) {
+		cache->setRecording(false);
+		debugPrintf("%u calls recorded\n", cache->getRecordedCalls().size());
+	} else if (!scumm_stricmp(argv[1], "clear")) {
+		cache->clearRecordedCalls();
+		debugPrintf("Recorded calls cleared\n");
+	} else if (!scumm_stricmp(argv[1], "run")) {
+		int iterations = argc > 2 ? atoi(argv[2]) : 10;
+
+		if (iterations <= 0) {
+			debugPrintf("Invalid number of iterations\n");
+			return true;
+		}
+
+		if (cache->getRecordedCalls().empty()) {
+			debugPrintf("No calls recorded, use \"%s record\" first\n", argv[0]);
+			return true;
+		}
+
+		AvoidPathBenchmark result = benchmarkAvoidPath(_engine->_gamestate, iterations);
+		debugPrintf("%u searches\n", result.searches);
+		debugPrintf("Without visibility graph cache: %u ms\n", result.uncachedTime);
+		debugPrintf("With visibility graph cache: %u ms (%u graph hits, %u misses, %u bypassed)\n",
+			result.cachedTime, result.cacheStats.graphHits, result.cacheStats.graphMisses, result.cacheStats.graphBypassed);
+		if (result.mismatches)
+			debugPrintf("WARNING: %u searches returned different paths\n", result.mismatches);
+	} else {
+		debugPrintf("Unknown subcommand %s\n", argv[1]);
+	}
+
+	return true;
+}
+
 bool Console::cmdResourceInfo(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Shows information about a resource\n");
@@ -2828,6 +2956,50 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCMode(int argc, const char **argv) {
+	IncrementalGC *gc = _engine->_gamestate->_incrementalGC;
+
+	if (argc != 2) {
+		debugPrintf("Garbage collection mode: %s\n", gc->isEnabled() ? "incremental" : "full");
+		debugPrintf("Usage: %s full|incremental\n", argv[0]);
+		return true;
+	}
+
+	if (!scumm_stricmp(argv[1], "full")) {
+		gc->cancel(_engine->_gamestate->_segMan);
+		gc->setEnabled(false);
+	} else if (!scumm_stricmp(argv[1], "incremental")) {
+		gc->setEnabled(true);
+	} else {
+		debugPrintf("Unknown garbage collection mode '%s'\n", argv[1]);
+		return true;
+	}
+
+	debugPrintf("Garbage collection mode set to %s\n", argv[1]);
+	return true;
+}
+
+bool Console::cmdGCStats(int argc, const char **argv) {
+	IncrementalGC *gc = _engine->_gamestate->_incrementalGC;
+
+	if (argc > 1 && !scumm_stricmp(argv[1], "reset")) {
+		gc->resetStats();
+		debugPrintf("Garbage collection statistics reset\n");
+		return true;
+	}
+
+	const GCStats &stats = gc->getStats();
+	debugPrintf("Mode: %s%s\n", gc->isEnabled() ? "incremental" : "full", gc->isMarking() ? " (marking)" : "");
+	debugPrintf("Full collections: %u\n", stats.fullRuns);
+	debugPrintf("Incremental collections: %u, in %u marking slices (longest %u ms)\n",
+		stats.incrementalRuns, stats.slices, stats.maxSlice);
+	debugPrintf("Pauses: last %u ms, longest %u ms, total %u ms\n", stats.lastPause, stats.maxPause, stats.totalPause);
+	debugPrintf("Last collection: %u addresses marked, %u rescanned, %u entries freed\n",
+		stats.lastMarked, stats.lastRescanned, stats.lastFreed);
+	debugPrintf("Use \"%s reset\" to clear these statistics\n", argv[0]);
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -3436,6 +3608,34 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdSendStats(int argc, const char **argv) {
+	DispatchCache &cache = _engine->_gamestate->_segMan->getDispatchCache();
+
+	if (argc > 1 && !scumm_stricmp(argv[1], "reset")) {
+		cache.resetStats();
+		debugPrintf("Send statistics reset\n");
+		return true;
+	}
+
+	const DispatchCache::Stats &stats = cache.getStats();
+	uint32 elapsed = g_system->getMillis() - stats.startTime;
+	uint32 lookups = stats.siteHits + stats.tableHits + stats.misses;
+
+	debugPrintf("Sends: %u in %u ms", stats.sends, elapsed);
+	if (elapsed)
+		debugPrintf(" (%u sends/s)", (uint32)((uint64)stats.sends * 1000 / elapsed));
+	debugPrintf("\n");
+	debugPrintf("Selector lookups: %u\n", lookups);
+	if (lookups) {
+		debugPrintf(" inline cache hits: %u (%u%%)\n", stats.siteHits, (uint32)((uint64)stats.siteHits * 100 / lookups));
+		debugPrintf(" class table hits: %u (%u%%)\n", stats.tableHits, (uint32)((uint64)stats.tableHits * 100 / lookups));
+		debugPrintf(" full lookups: %u (%u%%)\n", stats.misses, (uint32)((uint64)stats.misses * 100 / lookups));
+	}
+	debugPrintf("Cache flushes: %u\n", stats.flushes);
+	debugPrintf("Use \"%s reset\" to restart the measurement\n", argv[0]);
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("Shows all objects inside a specified script.\n");
@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/system.h"
+
+#include "sci/engine/dispatch_cache.h"
+#include "sci/engine/object.h"
+
+namespace Sci {
+
+DispatchCache::DispatchCache() {
+	flush();
+	resetStats();
+}
+
+void DispatchCache::makeKey(const Object *obj, Selector selector, Key &key) {
+	key.base = obj->getBaseObjData();
+	key.superClass = obj->getSuperClassSelector();
+	key.selector = selector;
+	key.isClass = obj->isClass();
+}
+
+const DispatchCache::Entry *DispatchCache::find(const Object *obj, Selector selector, uint32 site) {
+	Key key;
+	makeKey(obj, selector, key);
+
+	Entry *siteEntry = nullptr;
+	if (site) {
+		siteEntry = &_sites[siteIndex(site, selector)];
+		if (matches(*siteEntry, key)) {
+			_stats.siteHits++;
+			return siteEntry;
+		}
+	}
+
+	EntryMap::const_iterator it = _entries.find(key);
+	if (it == _entries.end()) {
+		_stats.misses++;
+		return nullptr;
+	}
+
+	_stats.tableHits++;
+	if (siteEntry) {
+		*siteEntry = it->_value;
+		return siteEntry;
+	}
+	return &it->_value;
+}
+
+const DispatchCache::Entry *DispatchCache::store(const Object *obj, Selector selector, uint32 site, SelectorType type, int varIndex, reg_t func) {
+	Key key;
+	makeKey(obj, selector, key);
+
+	Entry &entry = _entries.getOrCreateVal(key);
+	entry.base = key.base;
+	entry.superClass = key.superClass;
+	entry.selector = key.selector;
+	entry.isClass = key.isClass;
+	entry.type = type;
+	entry.varIndex = varIndex;
+	entry.func = func;
+
+	if (site) {
+		Entry &siteEntry = _sites[siteIndex(site, selector)];
+		siteEntry = entry;
+		return &siteEntry;
+	}
+	return &entry;
+}
+
+void DispatchCache::flush() {
+	_entries.clear();
+	for (uint i = 0; i < kNumSites; i++) {
+		_sites[i].base = nullptr;
+	}
+	_stats.flushes++;
+}
+
+void DispatchCache::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+	_stats.startTime = g_system->getMillis();
+}
+
+} // End of namespace Sci
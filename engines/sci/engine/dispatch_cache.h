@@ -0,0 +1,135 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCI_ENGINE_DISPATCH_CACHE_H
+#define SCI_ENGINE_DISPATCH_CACHE_H
+
+#include "common/hashmap.h"
+
+#include "sci/engine/vm.h"
+#include "sci/engine/vm_types.h"
+
+namespace Sci {
+
+class Object;
+
+/**
+ * Caches the results of lookupSelector().
+ *
+ * What a selector resolves to only depends on the object's definition in
+ * its script, on whether it is a class and on its superclass, so all the
+ * instances and clones of an object share the same entries. Resolved
+ * selectors are kept in a hash table, and a small direct-mapped table
+ * indexed by the sending script location sits in front of it, acting as a
+ * monomorphic inline cache for the send opcodes.
+ *
+ * Entries point into script data, so the whole cache is flushed whenever a
+ * script is loaded or unloaded.
+ */
+class DispatchCache {
+public:
+	struct Entry {
+		const byte *base;
+		reg_t superClass;
+		Selector selector;
+		bool isClass;
+
+		SelectorType type;
+		int varIndex;
+		reg_t func;
+	};
+
+	struct Stats {
+		uint32 sends;
+		uint32 siteHits;
+		uint32 tableHits;
+		uint32 misses;
+		uint32 flushes;
+		uint32 startTime;
+	};
+
+	DispatchCache();
+
+	/**
+	 * Finds a previously resolved selector.
+	 * @param obj		the object the selector is sent to
+	 * @param selector	the selector
+	 * @param site		the sending script location, or 0 if unknown
+	 * @return the entry, or nullptr if the selector has not been resolved
+	 *         for this kind of object yet
+	 */
+	const Entry *find(const Object *obj, Selector selector, uint32 site);
+
+	/**
+	 * Records the result of a full selector lookup.
+	 */
+	const Entry *store(const Object *obj, Selector selector, uint32 site, SelectorType type, int varIndex, reg_t func);
+
+	/** Drops all the resolved selectors. */
+	void flush();
+
+	void countSend() { _stats.sends++; }
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	enum {
+		kNumSites = 1024
+	};
+
+	struct Key {
+		const byte *base;
+		reg_t superClass;
+		Selector selector;
+		bool isClass;
+
+		bool operator==(const Key &other) const {
+			return base == other.base && superClass == other.superClass &&
+				selector == other.selector && isClass == other.isClass;
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return (uint)(uintptr)key.base ^ (key.superClass.getSegment() << 20) ^
+				(key.superClass.getOffset() << 4) ^ ((uint)key.selector << 8) ^ key.isClass;
+		}
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	static void makeKey(const Object *obj, Selector selector, Key &key);
+	static uint siteIndex(uint32 site, Selector selector) {
+		return (site ^ (site >> 10) ^ (selector * 31)) & (kNumSites - 1);
+	}
+	static bool matches(const Entry &entry, const Key &key) {
+		return entry.base == key.base && entry.superClass == key.superClass &&
+			entry.selector == key.selector && entry.isClass == key.isClass;
+	}
+
+	EntryMap _entries;
+	Entry _sites[kNumSites];
+	Stats _stats;
+};
+
+} // End of namespace Sci
+
+#endif // SCI_ENGINE_DISPATCH_CACHE_H
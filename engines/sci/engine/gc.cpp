@@ -21,6 +21,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -83,26 +84,35 @@ static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_
 	return normal_map;
 }
 
-static void processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap) {
+static uint processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap, uint budget = 0, bool skipInvalid = false) {
 	SegmentId stackSegment = segMan->findSegmentByType(SEG_TYPE_STACK);
+	uint processed = 0;
 	while (!wm._worklist.empty()) {
+		if (budget && processed >= budget)
+			break;
+
 		reg_t reg = wm._worklist.back();
 		wm._worklist.pop_back();
+		processed++;
 		if (reg.getSegment() != stackSegment) { // No need to repeat this one
 			debugC(kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
 			if (reg.getSegment() < heap.size() && heap[reg.getSegment()]) {
+				// Entries may have been freed by the scripts since they were
+				// queued by an earlier marking slice
+				if (skipInvalid && !heap[reg.getSegment()]->isValidOffset(reg.getOffset()))
+					continue;
+
 				// Valid heap object? Find its outgoing references!
 				wm.pushArray(heap[reg.getSegment()]->listAllOutgoingReferences(reg));
 			}
 		}
 	}
+	return processed;
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
+static void pushRoots(EngineState *s, WorklistManager &wm) {
 	assert(!s->_executionStack.empty());
 
-	WorklistManager wm;
-
 	// Initialize registers
 	wm.push(s->r_acc);
 	wm.push(s->r_prev);
@@ -169,8 +179,14 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	}
 
 	debugC(kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
+}
 
-	processWorkList(s->_segMan, wm, heap);
+AddrSet *findAllActiveReferences(EngineState *s) {
+	WorklistManager wm;
+
+	pushRoots(s, wm);
+
+	processWorkList(s->_segMan, wm, s->_segMan->getSegments());
 
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->processEngineHunkList(wm);
@@ -178,20 +194,14 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
-	SegManager *segMan = s->_segMan;
-
-	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
+static uint sweep(SegManager *segMan, const AddrSet &activeRefs) {
 #ifdef GC_DEBUG_CODE
 	const char *segnames[SEG_TYPE_MAX + 1];
 	int segcount[SEG_TYPE_MAX + 1];
 	memset(segnames, 0, sizeof(segnames));
 	memset(segcount, 0, sizeof(segcount));
 #endif
-
-	// Compute the set of all segments references currently in use.
-	AddrSet *activeRefs = findAllActiveReferences(s);
+	uint freed = 0;
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
@@ -210,10 +220,11 @@ void run_gc(EngineState *s) {
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
-				if (!activeRefs->contains(addr)) {
+				if (!activeRefs.contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					freed++;
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -223,8 +234,6 @@ void run_gc(EngineState *s) {
 		}
 	}
 
-	delete activeRefs;
-
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -232,6 +241,181 @@ void run_gc(EngineState *s) {
 		if (segcount[i])
 			debugC(kDebugLevelGC, "\t%d\t* %s", segcount[i], segnames[i]);
 #endif
+
+	return freed;
+}
+
+void run_gc(EngineState *s) {
+	SegManager *segMan = s->_segMan;
+	IncrementalGC *incrementalGC = s->_incrementalGC;
+	uint32 startTime = g_system->getMillis();
+
+	// Some debug stuff
+	debugC(kDebugLevelGC, "[GC] Running...");
+
+	// A full collection supersedes the incremental one in progress
+	incrementalGC->cancel(segMan);
+
+	// Compute the set of all segments references currently in use.
+	AddrSet *activeRefs = findAllActiveReferences(s);
+
+	GCStats &stats = incrementalGC->getStats();
+	stats.lastMarked = activeRefs->size();
+	stats.lastRescanned = 0;
+	stats.lastFreed = sweep(segMan, *activeRefs);
+	stats.fullRuns++;
+
+	delete activeRefs;
+
+	incrementalGC->recordPause(g_system->getMillis() - startTime);
+}
+
+IncrementalGC::IncrementalGC() : _enabled(false), _marking(false), _sliceCountDown(0) {
+	resetStats();
+}
+
+void IncrementalGC::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void IncrementalGC::recordPause(uint32 duration) {
+	_stats.lastPause = duration;
+	_stats.maxPause = MAX(_stats.maxPause, duration);
+	_stats.totalPause += duration;
+}
+
+static bool isKernelCallActive(EngineState *s) {
+	for (Common::List<ExecStack>::const_iterator it = s->_executionStack.begin(); it != s->_executionStack.end(); ++it) {
+		if (it->type == EXEC_STACK_TYPE_KERNEL)
+			return true;
+	}
+	return false;
+}
+
+void IncrementalGC::kernelCall(EngineState *s) {
+	if (!_marking) {
+		if (s->gcCountDown-- > 0)
+			return;
+
+		s->gcCountDown = s->scriptGCInterval;
+		if (!_enabled) {
+			run_gc(s);
+			return;
+		}
+
+		start(s);
+		return;
+	}
+
+	if (!s->_segMan->hasGCWriteBarrier()) {
+		// The segment manager has been reset behind our back, e.g. when
+		// restoring a saved game
+		cancel(s->_segMan);
+		return;
+	}
+
+	if (--_sliceCountDown > 0)
+		return;
+
+	// Kernel functions which call back into scripts may hold on to lists
+	// and nodes they looked up before marking started, so don't mark while
+	// one of them is active
+	if (isKernelCallActive(s))
+		return;
+
+	_sliceCountDown = kSliceInterval;
+
+	uint32 startTime = g_system->getMillis();
+	processWorkList(s->_segMan, _wm, s->_segMan->getSegments(), kSliceBudget, true);
+	uint32 duration = g_system->getMillis() - startTime;
+
+	_stats.slices++;
+	_stats.maxSlice = MAX(_stats.maxSlice, duration);
+	_stats.totalPause += duration;
+
+	if (_wm._worklist.empty())
+		finish(s);
+}
+
+void IncrementalGC::start(EngineState *s) {
+	debugC(kDebugLevelGC, "[GC] Starting incremental collection");
+
+	_wm._worklist.clear();
+	_wm._map.clear();
+	s->_segMan->setGCWriteBarrier(true);
+	pushRoots(s, _wm);
+	_marking = true;
+	_sliceCountDown = kSliceInterval;
+}
+
+void IncrementalGC::finish(EngineState *s) {
+	SegManager *segMan = s->_segMan;
+	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
+	uint32 startTime = g_system->getMillis();
+
+	debugC(kDebugLevelGC, "[GC] Finishing incremental collection");
+
+	// The roots may have changed since marking started
+	pushRoots(s, _wm);
+
+	// Rescan everything marked which may have been modified while marking:
+	// objects, clones and locals are written to without going through the
+	// write barrier, lists, nodes and arrays have been recorded by it
+	Common::Array<reg_t> rescan;
+	for (AddrSet::const_iterator it = _wm._map.begin(); it != _wm._map.end(); ++it) {
+		const reg_t addr = it->_key;
+		if (addr.getSegment() >= heap.size() || !heap[addr.getSegment()])
+			continue;
+
+		const SegmentType type = heap[addr.getSegment()]->getType();
+		if (type == SEG_TYPE_SCRIPT || type == SEG_TYPE_CLONES || type == SEG_TYPE_LOCALS)
+			rescan.push_back(addr);
+	}
+
+	const Common::Array<reg_t> &dirtyRefs = segMan->getGCDirtyRefs();
+	for (uint i = 0; i < dirtyRefs.size(); i++) {
+		if (_wm._map.contains(dirtyRefs[i]))
+			rescan.push_back(dirtyRefs[i]);
+	}
+
+	for (uint i = 0; i < rescan.size(); i++) {
+		const reg_t addr = rescan[i];
+		SegmentObj *mobj = heap[addr.getSegment()];
+		if (mobj && mobj->isValidOffset(addr.getOffset()))
+			_wm.pushArray(mobj->listAllOutgoingReferences(addr));
+	}
+
+	processWorkList(segMan, _wm, heap, 0, true);
+
+	if (g_sci->_gfxPorts)
+		g_sci->_gfxPorts->processEngineHunkList(_wm);
+
+	segMan->setGCWriteBarrier(false);
+	_marking = false;
+
+	AddrSet *activeRefs = normalizeAddresses(segMan, _wm._map);
+	_wm._map.clear();
+
+	_stats.lastMarked = activeRefs->size();
+	_stats.lastRescanned = rescan.size();
+	_stats.lastFreed = sweep(segMan, *activeRefs);
+	_stats.incrementalRuns++;
+
+	delete activeRefs;
+
+	recordPause(g_system->getMillis() - startTime);
+}
+
+void IncrementalGC::cancel(SegManager *segMan) {
+	if (!_marking)
+		return;
+
+	debugC(kDebugLevelGC, "[GC] Aborting incremental collection");
+
+	_wm._worklist.clear();
+	_wm._map.clear();
+	segMan->setGCWriteBarrier(false);
+	_marking = false;
 }
 
 } // End of namespace Sci
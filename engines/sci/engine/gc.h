@@ -23,6 +23,7 @@
 #ifndef SCI_ENGINE_GC_H
 #define SCI_ENGINE_GC_H
 
+#include "common/array.h"
 #include "common/hashmap.h"
 #include "sci/engine/vm_types.h"
 #include "sci/engine/state.h"
@@ -62,6 +63,71 @@ struct WorklistManager {
 	void pushArray(const Common::Array<reg_t> &tmp);
 };
 
+/**
+ * Pause time statistics of the garbage collector, shown by the gc_stats
+ * console command.
+ */
+struct GCStats {
+	uint32 fullRuns;        ///< Number of full (stop-the-world) collections
+	uint32 incrementalRuns; ///< Number of completed incremental collections
+	uint32 slices;          ///< Number of incremental marking slices
+	uint32 maxSlice;        ///< Longest marking slice, in ms
+	uint32 lastPause;       ///< Last full collection or final pause, in ms
+	uint32 maxPause;        ///< Longest full collection or final pause, in ms
+	uint32 totalPause;      ///< Time spent in full collections, final pauses and slices, in ms
+	uint32 lastMarked;      ///< Addresses marked by the last collection
+	uint32 lastRescanned;   ///< Addresses rescanned in the last final pause
+	uint32 lastFreed;       ///< Entries freed by the last collection
+};
+
+/**
+ * Incremental garbage collector.
+ *
+ * Marking is spread over bounded slices, which run between kernel calls.
+ * While marking, the segment manager records the lists, nodes and arrays
+ * it hands out (see SegManager::setGCWriteBarrier()). Objects, clones and
+ * local variables are written to directly by the VM, so all the marked
+ * ones are rescanned along with the roots and the recorded entries in a
+ * short final pause, right before sweeping.
+ */
+class IncrementalGC {
+public:
+	enum {
+		kSliceBudget = 512,  ///< Addresses traced per marking slice
+		kSliceInterval = 64  ///< Kernel calls between two marking slices
+	};
+
+	IncrementalGC();
+
+	bool isEnabled() const { return _enabled; }
+	void setEnabled(bool enabled) { _enabled = enabled; }
+	bool isMarking() const { return _marking; }
+
+	/**
+	 * Called for each kernel call. Starts a new collection when the
+	 * countdown expires, runs the next marking slice when one is due, and
+	 * finishes the collection once there is nothing left to mark.
+	 */
+	void kernelCall(EngineState *s);
+
+	/** Drops the collection in progress, if any. */
+	void cancel(SegManager *segMan);
+
+	GCStats &getStats() { return _stats; }
+	void resetStats();
+	void recordPause(uint32 duration);
+
+private:
+	void start(EngineState *s);
+	void finish(EngineState *s);
+
+	WorklistManager _wm;
+	bool _enabled;
+	bool _marking;
+	int _sliceCountDown;
+	GCStats _stats;
+};
+
 
 } // End of namespace Sci
 
@@ -23,6 +23,7 @@
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
 #include "sci/engine/kernel.h"
+#include "sci/engine/kpathing.h"
 #include "sci/graphics/paint16.h"
 #include "sci/graphics/palette16.h"
 #include "sci/graphics/screen.h"
@@ -116,10 +117,21 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// A* set membership
+	bool inOpenSet;
+	bool inClosedSet;
+
+	// Index of the vertex in the visibility graph, or -1 for vertices
+	// that were added for the start and end points
+	int graphIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = nullptr;
+		inOpenSet = false;
+		inClosedSet = false;
+		graphIndex = -1;
 	}
 };
 
@@ -241,6 +253,34 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+// Visibility between the polygon vertices of a polygon set
+struct VisibilityGraph {
+	enum {
+		kPairUnknown = 0,
+		kPairVisible = 1,
+		kPairObstructed = 2
+	};
+
+	// Vertex count and vertices of each polygon
+	Common::Array<int16> geometry;
+
+	// Number of vertices
+	int vertices;
+
+	// Visibility of each pair of vertices, filled in on demand
+	Common::Array<byte> pairs;
+
+	uint32 lastUse;
+};
+
+// Edge bounding box, for the edge grid
+struct EdgeBounds {
+	Vertex *vertex;
+	int16 left, top, right, bottom;
+};
+
+#define EDGE_GRID_SIZE 8
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -262,6 +302,19 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Visibility graph of the polygon set, or NULL if it can't be used
+	VisibilityGraph *_graph;
+	AvoidPathCache *_cache;
+
+	// Grid of the edges overlapping each cell, used to find the edges
+	// that may obstruct a line segment
+	Common::Array<EdgeBounds> _edges;
+	Common::Array<uint16> _edgeGrid[EDGE_GRID_SIZE * EDGE_GRID_SIZE];
+	int16 _gridLeft, _gridTop;
+	int _cellWidth, _cellHeight;
+	Common::Array<uint32> _edgeQueries;
+	uint32 _edgeQuery;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = nullptr;
 		vertex_end = nullptr;
@@ -269,6 +322,11 @@ struct PathfindingState {
 		_prependPoint = nullptr;
 		_appendPoint = nullptr;
 		vertices = 0;
+		_graph = nullptr;
+		_cache = nullptr;
+		_gridLeft = _gridTop = 0;
+		_cellWidth = _cellHeight = 1;
+		_edgeQuery = 0;
 	}
 
 	~PathfindingState() {
@@ -285,6 +343,9 @@ struct PathfindingState {
 	bool pointOnScreenBorder(const Common::Point &p);
 	bool edgeOnScreenBorder(const Common::Point &p, const Common::Point &q);
 	int findNearPoint(const Common::Point &p, Polygon *polygon, Common::Point *ret);
+	void buildEdgeGrid();
+	bool isObstructed(const Common::Point &p, const Common::Point &q);
+	bool isVisible(Vertex *vertex1, Vertex *vertex2);
 };
 
 static Common::Point readPoint(SegmentRef list_r, int offset) {
@@ -698,6 +759,158 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Sorts the edges of the polygon set into a grid of cells covering their
+ * bounding box, so that obstruction tests only need to look at the edges
+ * near the line segment being tested
+ */
+void PathfindingState::buildEdgeGrid() {
+	_edges.clear();
+
+	for (int i = 0; i < vertices; i++) {
+		Vertex *vertex = vertex_index[i];
+
+		if (!VERTEX_HAS_EDGES(vertex))
+			continue;
+
+		const Common::Point &p1 = vertex->v;
+		const Common::Point &p2 = CLIST_NEXT(vertex)->v;
+		EdgeBounds edge;
+
+		edge.vertex = vertex;
+		edge.left = MIN(p1.x, p2.x);
+		edge.top = MIN(p1.y, p2.y);
+		edge.right = MAX(p1.x, p2.x);
+		edge.bottom = MAX(p1.y, p2.y);
+		_edges.push_back(edge);
+	}
+
+	for (int i = 0; i < EDGE_GRID_SIZE * EDGE_GRID_SIZE; i++)
+		_edgeGrid[i].clear();
+
+	_edgeQueries.resize(_edges.size());
+	for (uint i = 0; i < _edges.size(); i++)
+		_edgeQueries[i] = 0;
+	_edgeQuery = 0;
+
+	if (_edges.empty())
+		return;
+
+	int16 right = _edges[0].right, bottom = _edges[0].bottom;
+	_gridLeft = _edges[0].left;
+	_gridTop = _edges[0].top;
+
+	for (uint i = 1; i < _edges.size(); i++) {
+		_gridLeft = MIN(_gridLeft, _edges[i].left);
+		_gridTop = MIN(_gridTop, _edges[i].top);
+		right = MAX(right, _edges[i].right);
+		bottom = MAX(bottom, _edges[i].bottom);
+	}
+
+	_cellWidth = (right - _gridLeft) / EDGE_GRID_SIZE + 1;
+	_cellHeight = (bottom - _gridTop) / EDGE_GRID_SIZE + 1;
+
+	for (uint i = 0; i < _edges.size(); i++) {
+		const EdgeBounds &edge = _edges[i];
+		int x1 = (edge.left - _gridLeft) / _cellWidth;
+		int x2 = (edge.right - _gridLeft) / _cellWidth;
+		int y1 = (edge.top - _gridTop) / _cellHeight;
+		int y2 = (edge.bottom - _gridTop) / _cellHeight;
+
+		for (int y = y1; y <= y2; y++) {
+			for (int x = x1; x <= x2; x++)
+				_edgeGrid[y * EDGE_GRID_SIZE + x].push_back(i);
+		}
+	}
+}
+
+/**
+ * Determines whether or not a line segment is obstructed by the edges of
+ * the polygon set. Edges whose bounding box doesn't overlap that of the
+ * segment can neither contain a vertex on the segment nor properly
+ * intersect it, so only the edges in the grid cells overlapping the
+ * segment are tested
+ * Parameters: (const Common::Point &) p, q: The line segment (p, q)
+ * Returns   : (bool) true if the segment is obstructed, false otherwise
+ */
+bool PathfindingState::isObstructed(const Common::Point &p, const Common::Point &q) {
+	if (_edges.empty())
+		return false;
+
+	int16 left = MIN(p.x, q.x), right = MAX(p.x, q.x);
+	int16 top = MIN(p.y, q.y), bottom = MAX(p.y, q.y);
+
+	// between() treats all points sharing a coordinate with a degenerate
+	// segment as lying on it, so those have to be tested against all edges
+	if (p == q) {
+		left = top = -0x8000;
+		right = bottom = 0x7fff;
+	}
+
+	int x1 = CLIP<int>((left - _gridLeft) / _cellWidth, 0, EDGE_GRID_SIZE - 1);
+	int x2 = CLIP<int>((right - _gridLeft) / _cellWidth, 0, EDGE_GRID_SIZE - 1);
+	int y1 = CLIP<int>((top - _gridTop) / _cellHeight, 0, EDGE_GRID_SIZE - 1);
+	int y2 = CLIP<int>((bottom - _gridTop) / _cellHeight, 0, EDGE_GRID_SIZE - 1);
+
+	// Edges spanning several cells are only tested once per query
+	_edgeQuery++;
+
+	for (int y = y1; y <= y2; y++) {
+		for (int x = x1; x <= x2; x++) {
+			const Common::Array<uint16> &cell = _edgeGrid[y * EDGE_GRID_SIZE + x];
+
+			for (uint i = 0; i < cell.size(); i++) {
+				const EdgeBounds &edge = _edges[cell[i]];
+
+				if (_edgeQueries[cell[i]] == _edgeQuery)
+					continue;
+				_edgeQueries[cell[i]] = _edgeQuery;
+
+				if (edge.right < left || edge.left > right || edge.bottom < top || edge.top > bottom)
+					continue;
+
+				if (between(p, q, edge.vertex->v)) {
+					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+					if ((inside(p, edge.vertex)) || (inside(q, edge.vertex)))
+						return true;
+
+					// This edge won't properly intersect, so we continue
+					continue;
+				}
+
+				if (intersect_proper(p, q, edge.vertex->v, CLIST_NEXT(edge.vertex)->v))
+					return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Determines whether or not the line segment between two vertices is
+ * obstructed, using the visibility graph when both are polygon vertices
+ * Parameters: (Vertex *) vertex1, vertex2: The vertices
+ * Returns   : (bool) true if vertex2 can be seen from vertex1, false otherwise
+ */
+bool PathfindingState::isVisible(Vertex *vertex1, Vertex *vertex2) {
+	if (!_graph || vertex1->graphIndex < 0 || vertex2->graphIndex < 0)
+		return !isObstructed(vertex1->v, vertex2->v);
+
+	const int n = _graph->vertices;
+	byte &pair = _graph->pairs[vertex1->graphIndex * n + vertex2->graphIndex];
+
+	if (pair == VisibilityGraph::kPairUnknown) {
+		pair = isObstructed(vertex1->v, vertex2->v) ? VisibilityGraph::kPairObstructed : VisibilityGraph::kPairVisible;
+		_graph->pairs[vertex2->graphIndex * n + vertex1->graphIndex] = pair;
+		_cache->getStats().pairMisses++;
+	} else {
+		_cache->getStats().pairHits++;
+	}
+
+	return pair == VisibilityGraph::kPairVisible;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -715,25 +928,7 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 			continue;
 
 		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
-		}
-
-		if (j == s->vertices)
+		if (s->isVisible(vertex_cur, vertex))
 			visVerts->push_front(vertex);
 	}
 
@@ -1236,40 +1431,47 @@ static void change_polygons_opt_0(PathfindingState *s) {
 }
 
 /**
- * Converts the SCI input data for pathfinding
- * Parameters: (EngineState *) s: The game state
- *             (reg_t) poly_list: Polygon list
- *             (Common::Point) start: The start point
- *             (Common::Point) end: The end point
- *             (int) opt: Optimization level (0, 1 or 2)
- * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
- *                            NULL otherwise
+ * Looks up the visibility graph of the polygon set in the cache, and
+ * numbers the polygon vertices accordingly
+ * Parameters: (PathfindingState *) s: The pathfinding state
+ *             (AvoidPathCache *) cache: The cache
  */
-static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
-	SegManager *segMan = s->_segMan;
-	Polygon *polygon;
+static void find_visibility_graph(PathfindingState *s, AvoidPathCache *cache) {
+	Common::Array<int16> geometry;
 	int count = 0;
-	PathfindingState *pf_s = new PathfindingState(width, height);
 
-	// Convert all polygons
-	if (poly_list.getSegment()) {
-		List *list = s->_segMan->lookupList(poly_list);
-		Node *node = s->_segMan->lookupNode(list->first);
-
-		while (node) {
-			// The node value might be null, in which case there's no polygon to parse.
-			// Happens in LB2 floppy - refer to bug #5195
-			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : nullptr;
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
 
-			if (polygon) {
-				pf_s->polygons.push_back(polygon);
-				count += readSelectorValue(segMan, node->value, SELECTOR(size));
-			}
+		geometry.push_back(polygon->vertices.size());
 
-			node = s->_segMan->lookupNode(node->succ);
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			geometry.push_back(vertex->v.x);
+			geometry.push_back(vertex->v.y);
+			vertex->graphIndex = count++;
 		}
 	}
 
+	s->_cache = cache;
+	s->_graph = cache->getGraph(geometry, count);
+}
+
+/**
+ * Prepares a pathfinding state holding the polygons of a polygon set for
+ * pathfinding
+ * Parameters: (PathfindingState *) pf_s: The pathfinding state
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ *             (AvoidPathCache *) cache: Visibility graph cache, or NULL
+ * Returns   : (bool) true on success, false otherwise
+ */
+static bool prepare_polygon_set(PathfindingState *pf_s, Common::Point start, Common::Point end, int opt, AvoidPathCache *cache) {
+	EngineState *s = g_sci->getEngineState();
+	Polygon *polygon;
+	int count = 0;
+
 	if (opt == 0)
 		change_polygons_opt_0(pf_s);
 
@@ -1277,8 +1479,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 
 	if (!new_start) {
 		warning("AvoidPath: Couldn't fixup start position for pathfinding");
-		delete pf_s;
-		return nullptr;
+		return false;
 	}
 
 	Common::Point *new_end = fixup_end_point(pf_s, end);
@@ -1286,8 +1487,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	if (!new_end) {
 		warning("AvoidPath: Couldn't fixup end position for pathfinding");
 		delete new_start;
-		delete pf_s;
-		return nullptr;
+		return false;
 	}
 
 	if (opt == 0) {
@@ -1309,8 +1509,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 				warning("AvoidPath: error finding nearest intersection");
 				delete new_start;
 				delete new_end;
-				delete pf_s;
-				return nullptr;
+				return false;
 			}
 
 			if (err == PF_OK)
@@ -1326,6 +1525,9 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	if (cache)
+		find_visibility_graph(pf_s, cache);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1333,8 +1535,24 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	delete new_start;
 	delete new_end;
 
+	if (cache) {
+		// Points that were merged into an edge split it, which changes
+		// visibility between the other vertices as well
+		if ((pf_s->vertex_start->graphIndex < 0 && VERTEX_HAS_EDGES(pf_s->vertex_start))
+		        || (pf_s->vertex_end->graphIndex < 0 && VERTEX_HAS_EDGES(pf_s->vertex_end)))
+			pf_s->_graph = nullptr;
+
+		AvoidPathCache::Stats &stats = cache->getStats();
+		stats.searches++;
+		if (!pf_s->_graph)
+			stats.graphBypassed++;
+	}
+
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it)
+		count += (*it)->vertices.size();
+
 	// Allocate and build vertex index
-	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
+	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * count);
 
 	count = 0;
 
@@ -1349,6 +1567,69 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 
 	pf_s->vertices = count;
 
+	pf_s->buildEdgeGrid();
+
+	return true;
+}
+
+/**
+ * Converts the SCI input data for pathfinding
+ * Parameters: (EngineState *) s: The game state
+ *             (reg_t) poly_list: Polygon list
+ *             (Common::Point) start: The start point
+ *             (Common::Point) end: The end point
+ *             (int) opt: Optimization level (0, 1 or 2)
+ * Returns   : (PathfindingState *) On success a newly allocated pathfinding state,
+ *                            NULL otherwise
+ */
+static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Common::Point start, Common::Point end, int width, int height, int opt) {
+	AvoidPathCache *cache = s->_avoidPathCache;
+	Polygon *polygon;
+	PathfindingState *pf_s = new PathfindingState(width, height);
+
+	// Convert all polygons
+	if (poly_list.getSegment()) {
+		List *list = s->_segMan->lookupList(poly_list);
+		Node *node = s->_segMan->lookupNode(list->first);
+
+		while (node) {
+			// The node value might be null, in which case there's no polygon to parse.
+			// Happens in LB2 floppy - refer to bug #5195
+			polygon = !node->value.isNull() ? convert_polygon(s, node->value) : nullptr;
+
+			if (polygon)
+				pf_s->polygons.push_back(polygon);
+
+			node = s->_segMan->lookupNode(node->succ);
+		}
+	}
+
+	if (cache->isRecording()) {
+		AvoidPathCache::RecordedCall call;
+
+		for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+			AvoidPathCache::RecordedPolygon recorded;
+			Vertex *vertex;
+
+			recorded.type = (*it)->type;
+			CLIST_FOREACH(vertex, &(*it)->vertices)
+				recorded.points.push_back(vertex->v);
+			call.polygons.push_back(recorded);
+		}
+
+		call.start = start;
+		call.end = end;
+		call.width = width;
+		call.height = height;
+		call.opt = opt;
+		cache->record(call);
+	}
+
+	if (!prepare_polygon_set(pf_s, start, end, opt, cache)) {
+		delete pf_s;
+		return nullptr;
+	}
+
 	return pf_s;
 }
 
@@ -1366,7 +1647,27 @@ static void AStar(PathfindingState *s) {
 	// The remaining vertices
 	VertexList openSet;
 
+	// WORKAROUND: The screen border penalty below is needed in SCI1.1 games,
+	// such as LB2. Until our algorithm matches better what SSCI is doing, we
+	// exempt certain rooms where the check fails.
+	bool penaltyWorkaround =
+		// QFG1VGA room 81 - Hero gets stuck when walking to the SE corner (bug #6140).
+		(g_sci->getGameId() == GID_QFG1VGA && g_sci->getEngineState()->currentRoomNumber() == 81) ||
+#ifdef ENABLE_SCI32
+		// QFG4 room 563 - Hero zig-zags into the room (bug #10858).
+		// Entering from the south (564) off-screen behind an obstacle, hero
+		// fails to turn at a point on the screen edge, passes the poly's corner,
+		// then approaches the destination from deeper in the room.
+		(g_sci->getGameId() == GID_QFG4 && g_sci->getEngineState()->currentRoomNumber() == 563) ||
+
+		// QFG4 room 580 - Hero zig-zags into the room (bug #10870).
+		// Entering from the south (581) off-screen behind an obstacle, as above.
+		(g_sci->getGameId() == GID_QFG4 && g_sci->getEngineState()->currentRoomNumber() == 580) ||
+#endif
+		false;
+
 	openSet.push_front(s->vertex_start);
+	s->vertex_start->inOpenSet = true;
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
 
@@ -1393,7 +1694,9 @@ static void AStar(PathfindingState *s) {
 
 		// Move vertex from set open to set closed
 		closedSet.push_front(vertex_min);
+		vertex_min->inClosedSet = true;
 		openSet.erase(vertex_min_it);
+		vertex_min->inOpenSet = false;
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
 
@@ -1401,11 +1704,13 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->inClosedSet)
 				continue;
 
-			if (!openSet.contains(vertex))
+			if (!vertex->inOpenSet) {
 				openSet.push_front(vertex);
+				vertex->inOpenSet = true;
+			}
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
@@ -1416,26 +1721,6 @@ static void AStar(PathfindingState *s) {
 			// other, while we apply a penalty to paths traversing it.
 			// This difference might lead to problems, but none are
 			// known at the time of writing.
-
-			// WORKAROUND: This check is needed in SCI1.1 games, such as LB2. Until our
-			// algorithm matches better what SSCI is doing, we exempt certain rooms where
-			// the check fails.
-			bool penaltyWorkaround =
-				// QFG1VGA room 81 - Hero gets stuck when walking to the SE corner (bug #6140).
-				(g_sci->getGameId() == GID_QFG1VGA && g_sci->getEngineState()->currentRoomNumber() == 81) ||
-#ifdef ENABLE_SCI32
-				// QFG4 room 563 - Hero zig-zags into the room (bug #10858).
-				// Entering from the south (564) off-screen behind an obstacle, hero
-				// fails to turn at a point on the screen edge, passes the poly's corner,
-				// then approaches the destination from deeper in the room.
-				(g_sci->getGameId() == GID_QFG4 && g_sci->getEngineState()->currentRoomNumber() == 563) ||
-
-				// QFG4 room 580 - Hero zig-zags into the room (bug #10870).
-				// Entering from the south (581) off-screen behind an obstacle, as above.
-				(g_sci->getGameId() == GID_QFG4 && g_sci->getEngineState()->currentRoomNumber() == 580) ||
-#endif
-				false;
-
 			if (s->pointOnScreenBorder(vertex->v) && !penaltyWorkaround)
 				new_dist += 10000;
 
@@ -1644,6 +1929,145 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 	}
 }
 
+AvoidPathCache::AvoidPathCache() : _useCounter(0), _recording(false) {
+	for (int i = 0; i < kMaxGraphs; i++)
+		_graphs[i] = nullptr;
+
+	resetStats();
+}
+
+AvoidPathCache::~AvoidPathCache() {
+	clear();
+}
+
+VisibilityGraph *AvoidPathCache::getGraph(const Common::Array<int16> &geometry, int vertices) {
+	if (vertices > kMaxGraphVertices)
+		return nullptr;
+
+	_useCounter++;
+
+	for (int i = 0; i < kMaxGraphs; i++) {
+		VisibilityGraph *graph = _graphs[i];
+
+		if (graph && graph->vertices == vertices && graph->geometry == geometry) {
+			graph->lastUse = _useCounter;
+			_stats.graphHits++;
+			return graph;
+		}
+	}
+
+	_stats.graphMisses++;
+
+	// Replace an empty slot, or else the least recently used graph
+	int slot = 0;
+	for (int i = 0; i < kMaxGraphs; i++) {
+		if (!_graphs[i]) {
+			slot = i;
+			break;
+		}
+
+		if (_graphs[i]->lastUse < _graphs[slot]->lastUse)
+			slot = i;
+	}
+
+	delete _graphs[slot];
+
+	VisibilityGraph *graph = new VisibilityGraph();
+	graph->geometry = geometry;
+	graph->vertices = vertices;
+	graph->pairs.resize(vertices * vertices);
+	for (uint i = 0; i < graph->pairs.size(); i++)
+		graph->pairs[i] = VisibilityGraph::kPairUnknown;
+	graph->lastUse = _useCounter;
+
+	_graphs[slot] = graph;
+	return graph;
+}
+
+void AvoidPathCache::clear() {
+	for (int i = 0; i < kMaxGraphs; i++) {
+		delete _graphs[i];
+		_graphs[i] = nullptr;
+	}
+}
+
+void AvoidPathCache::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void AvoidPathCache::record(const RecordedCall &call) {
+	if (_recordedCalls.size() < kMaxRecordedCalls)
+		_recordedCalls.push_back(call);
+}
+
+/**
+ * Runs a recorded kAvoidPath call
+ * Parameters: (const AvoidPathCache::RecordedCall &) call: The call
+ *             (AvoidPathCache *) cache: Visibility graph cache, or NULL
+ * Returns   : (bool) true on success, false otherwise
+ *             (Common::Array<Common::Point>) path: The path, from end to start
+ */
+static bool replay_call(const AvoidPathCache::RecordedCall &call, AvoidPathCache *cache, Common::Array<Common::Point> &path) {
+	PathfindingState *p = new PathfindingState(call.width, call.height);
+
+	for (uint i = 0; i < call.polygons.size(); i++) {
+		const AvoidPathCache::RecordedPolygon &recorded = call.polygons[i];
+		Polygon *polygon = new Polygon(recorded.type);
+
+		for (uint j = 0; j < recorded.points.size(); j++)
+			polygon->vertices.insertAtEnd(new Vertex(recorded.points[j]));
+
+		p->polygons.push_back(polygon);
+	}
+
+	path.clear();
+
+	if (!prepare_polygon_set(p, call.start, call.end, call.opt, cache)) {
+		delete p;
+		return false;
+	}
+
+	AStar(p);
+
+	for (Vertex *vertex = p->vertex_end; vertex; vertex = vertex->path_prev)
+		path.push_back(vertex->v);
+
+	delete p;
+	return true;
+}
+
+AvoidPathBenchmark benchmarkAvoidPath(EngineState *s, uint iterations) {
+	const Common::Array<AvoidPathCache::RecordedCall> &calls = s->_avoidPathCache->getRecordedCalls();
+	Common::Array<Common::Array<Common::Point> > paths(calls.size());
+	Common::Array<Common::Point> path;
+	AvoidPathCache cache;
+	AvoidPathBenchmark result;
+	uint32 startTime;
+
+	result.searches = calls.size() * iterations;
+	result.mismatches = 0;
+
+	startTime = g_system->getMillis();
+	for (uint i = 0; i < iterations; i++) {
+		for (uint j = 0; j < calls.size(); j++)
+			replay_call(calls[j], nullptr, paths[j]);
+	}
+	result.uncachedTime = g_system->getMillis() - startTime;
+
+	startTime = g_system->getMillis();
+	for (uint i = 0; i < iterations; i++) {
+		for (uint j = 0; j < calls.size(); j++) {
+			replay_call(calls[j], &cache, path);
+			if (path != paths[j])
+				result.mismatches++;
+		}
+	}
+	result.cachedTime = g_system->getMillis() - startTime;
+
+	result.cacheStats = cache.getStats();
+	return result;
+}
+
 static bool PointInRect(const Common::Point &point, int16 rectX1, int16 rectY1, int16 rectX2, int16 rectY2) {
 	int16 top = MIN<int16>(rectY1, rectY2);
 	int16 left = MIN<int16>(rectX1, rectX2);
@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCI_ENGINE_KPATHING_H
+#define SCI_ENGINE_KPATHING_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Sci {
+
+struct EngineState;
+struct VisibilityGraph;
+
+/**
+ * State kept by kAvoidPath between calls.
+ *
+ * Games usually run many searches against the same obstacle polygons, and
+ * most of the time of a search is spent checking which pairs of polygon
+ * vertices can see each other. Those answers only depend on the polygons,
+ * so they are kept in a visibility graph per polygon set and filled in
+ * lazily as searches need them. Polygon sets are recognized by their
+ * vertices, so a room that moves or replaces its polygons simply gets a
+ * new graph, and the least recently used graphs are dropped.
+ *
+ * Calls can also be recorded, so that they can be replayed from the
+ * console to benchmark the pathfinder.
+ */
+class AvoidPathCache {
+public:
+	enum {
+		kMaxGraphs = 4,
+		kMaxGraphVertices = 384,
+		kMaxRecordedCalls = 512
+	};
+
+	struct Stats {
+		uint32 searches;
+		uint32 graphHits;
+		uint32 graphMisses;
+		uint32 graphBypassed;
+		uint32 pairHits;
+		uint32 pairMisses;
+	};
+
+	struct RecordedPolygon {
+		int type;
+		Common::Array<Common::Point> points;
+	};
+
+	struct RecordedCall {
+		Common::Array<RecordedPolygon> polygons;
+		Common::Point start, end;
+		int width, height, opt;
+	};
+
+	AvoidPathCache();
+	~AvoidPathCache();
+
+	/**
+	 * Finds the visibility graph of a polygon set, creating an empty one
+	 * if the set has not been seen recently.
+	 * @param geometry	the vertex count and vertices of each polygon
+	 * @param vertices	the total number of vertices
+	 * @return the graph, or nullptr if the set is too large to be cached
+	 */
+	VisibilityGraph *getGraph(const Common::Array<int16> &geometry, int vertices);
+	void clear();
+
+	Stats &getStats() { return _stats; }
+	void resetStats();
+
+	bool isRecording() const { return _recording; }
+	void setRecording(bool recording) { _recording = recording; }
+	void record(const RecordedCall &call);
+	const Common::Array<RecordedCall> &getRecordedCalls() const { return _recordedCalls; }
+	void clearRecordedCalls() { _recordedCalls.clear(); }
+
+private:
+	VisibilityGraph *_graphs[kMaxGraphs];
+	uint32 _useCounter;
+	Stats _stats;
+
+	bool _recording;
+	Common::Array<RecordedCall> _recordedCalls;
+};
+
+struct AvoidPathBenchmark {
+	uint32 searches;
+	uint32 uncachedTime;
+	uint32 cachedTime;
+	uint32 mismatches;
+	AvoidPathCache::Stats cacheStats;
+};
+
+/**
+ * Replays the recorded kAvoidPath calls, once without and once with a
+ * fresh visibility graph cache, and checks that both produce the same
+ * paths.
+ * @param s				the game state
+ * @param iterations	the number of times each call is replayed
+ */
+AvoidPathBenchmark benchmarkAvoidPath(EngineState *s, uint iterations);
+
+} // End of namespace Sci
+
+#endif // SCI_ENGINE_KPATHING_H
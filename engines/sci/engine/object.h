@@ -279,6 +279,12 @@ public:
 	uint16 getMethodCount() const { return _methodCount; }
 	reg_t getPos() const { return _pos; }
 
+	/**
+	 * Returns the object's raw data within its owner script. Clones share it
+	 * with the object they were cloned from.
+	 */
+	const byte *getBaseObjData() const { return _baseObj.data(); }
+
 	void saveLoadWithSerializer(Common::Serializer &ser) override;
 
 	void cloneFromObject(const Object *obj) {
@@ -42,6 +42,8 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
+	_gcWriteBarrier = false;
+
 #ifdef ENABLE_SCI32
 	_arraysSegId = 0;
 	_bitmapSegId = 0;
@@ -79,6 +81,13 @@ void SegManager::resetSegMan() {
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
+
+	setGCWriteBarrier(false);
+}
+
+void SegManager::setGCWriteBarrier(bool enable) {
+	_gcWriteBarrier = enable;
+	_gcDirtyRefs.clear();
 }
 
 void SegManager::initSysStrings() {
@@ -164,6 +173,7 @@ void SegManager::deallocate(SegmentId seg) {
 
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
+		_dispatchCache.flush();
 		_scriptSegMap.erase(scr->getScriptNumber());
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
@@ -510,6 +520,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	int offset = table->allocEntry();
 
 	*addr = make_reg(_listsSegId, offset);
+	recordGCWrite(*addr);
 	return &table->at(offset);
 }
 
@@ -526,6 +537,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	int offset = table->allocEntry();
 
 	*addr = make_reg(_nodesSegId, offset);
+	recordGCWrite(*addr);
 	return &table->at(offset);
 }
 
@@ -552,6 +564,7 @@ List *SegManager::lookupList(reg_t addr) {
 		return nullptr;
 	}
 
+	recordGCWrite(addr);
 	return &(lt[addr.getOffset()]);
 }
 
@@ -576,6 +589,7 @@ Node *SegManager::lookupNode(reg_t addr, bool stopOnDiscarded) {
 		return nullptr;
 	}
 
+	recordGCWrite(addr);
 	return &(nt[addr.getOffset()]);
 }
 
@@ -589,6 +603,10 @@ SegmentRef SegManager::dereference(reg_t pointer) {
 	}
 
 	SegmentObj *mobj = _heap[pointer.getSegment()];
+#ifdef ENABLE_SCI32
+	if (mobj->getType() == SEG_TYPE_ARRAY)
+		recordGCWrite(pointer);
+#endif
 	return mobj->dereference(pointer);
 }
 
@@ -952,6 +970,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 	int offset = table->allocEntry();
 
 	*addr = make_reg(_arraysSegId, offset);
+	recordGCWrite(*addr);
 
 	SciArray *array = &table->at(offset);
 	array->setType(type);
@@ -968,6 +987,7 @@ SciArray *SegManager::lookupArray(reg_t addr) {
 	if (!arrayTable.isValidEntry(addr.getOffset()))
 		error("Attempt to use non-array %04x:%04x as array", PRINT_REG(addr));
 
+	recordGCWrite(addr);
 	return &(arrayTable[addr.getOffset()]);
 }
 
@@ -1106,6 +1126,10 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
 
+	// Any cached selector lookup may refer to the previous contents of the
+	// script buffer
+	_dispatchCache.flush();
+
 	return segmentId;
 }
 
@@ -1136,6 +1160,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		_dispatchCache.flush();
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/serializer.h"
+#include "sci/engine/dispatch_cache.h"
 #include "sci/engine/script.h"
 #include "sci/engine/vm.h"
 #include "sci/engine/vm_types.h"
@@ -460,8 +461,28 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	DispatchCache &getDispatchCache() { return _dispatchCache; }
+
+	/**
+	 * Enables or disables the write barrier of the incremental garbage
+	 * collector. While it is enabled, all the lists, nodes and arrays which
+	 * are allocated or looked up, and may thus be modified, are recorded.
+	 */
+	void setGCWriteBarrier(bool enable);
+	bool hasGCWriteBarrier() const { return _gcWriteBarrier; }
+	const Common::Array<reg_t> &getGCDirtyRefs() const { return _gcDirtyRefs; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
+	DispatchCache _dispatchCache; /**< Resolved selectors, see lookupSelector() */
+
+	bool _gcWriteBarrier; /**< Whether incremental garbage collection is marking */
+	Common::Array<reg_t> _gcDirtyRefs; /**< Entries possibly modified while marking */
+
+	void recordGCWrite(reg_t addr) {
+		if (_gcWriteBarrier && (_gcDirtyRefs.empty() || _gcDirtyRefs.back() != addr))
+			_gcDirtyRefs.push_back(addr);
+	}
 	Common::Array<Class> _classTable; /**< Table of all classes */
 	/** Map script ids to segment ids. */
 	Common::HashMap<int, SegmentId> _scriptSegMap;
@@ -323,7 +323,29 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
-SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
+static SelectorType resolveSelector(SegManager *segMan, const Object *obj, Selector selectorId, int &varIndex, reg_t &func) {
+	varIndex = obj->locateVarSelector(segMan, selectorId);
+
+	if (varIndex >= 0) {
+		// Found it as a variable
+		return kSelectorVariable;
+	}
+
+	// Check if it's a method, with recursive lookup in superclasses
+	while (obj) {
+		int index = obj->funcSelectorPosition(selectorId);
+		if (index >= 0) {
+			func = obj->getFunction(index);
+			return kSelectorMethod;
+		}
+
+		obj = segMan->getObject(obj->getSuperClassSelector());
+	}
+
+	return kSelectorNone;
+}
+
+SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr, uint32 site) {
 	const Object *obj = segMan->getObject(obj_location);
 	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
 
@@ -336,31 +358,26 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
 	}
 
-	int index = obj->locateVarSelector(segMan, selectorId);
+	DispatchCache &cache = segMan->getDispatchCache();
+	const DispatchCache::Entry *entry = cache.find(obj, selectorId, site);
+	if (!entry) {
+		int varIndex = -1;
+		reg_t func = NULL_REG;
+		SelectorType type = resolveSelector(segMan, obj, selectorId, varIndex, func);
+		entry = cache.store(obj, selectorId, site, type, varIndex, func);
+	}
 
-	if (index >= 0) {
-		// Found it as a variable
+	if (entry->type == kSelectorVariable) {
 		if (varp) {
 			varp->obj = obj_location;
-			varp->varindex = index;
+			varp->varindex = entry->varIndex;
 		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
-			}
-		}
-
-		return kSelectorNone;
+	} else if (entry->type == kSelectorMethod) {
+		if (fptr)
+			*fptr = entry->func;
 	}
+
+	return entry->type;
 }
 
 } // End of namespace Sci
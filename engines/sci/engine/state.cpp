@@ -24,8 +24,10 @@
 #include "sci/debug.h"	// for g_debug_sleeptime_factor
 #include "sci/engine/features.h"
 #include "sci/engine/file.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/guest_additions.h"
 #include "sci/engine/kernel.h"
+#include "sci/engine/kpathing.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
 #include "sci/engine/vm.h"
@@ -70,12 +72,16 @@ EngineState::EngineState(SegManager *segMan) :
 	_segMan(segMan),
 	_msgState(nullptr),
 	_dirseeker() {
+	_incrementalGC = new IncrementalGC();
+	_avoidPathCache = new AvoidPathCache();
 
 	reset(false);
 }
 
 EngineState::~EngineState() {
 	delete _msgState;
+	delete _incrementalGC;
+	delete _avoidPathCache;
 }
 
 void EngineState::reset(bool isRestoring) {
@@ -122,6 +128,9 @@ void EngineState::reset(bool isRestoring) {
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
+	// This is called once per game cycle
+	g_sci->getResMan()->updateRoom(currentRoomNumber());
+
 	if (_throttleTrigger) {
 		uint32 curTime = g_system->getMillis();
 		uint32 duration = curTime - _throttleLastTime;
@@ -48,6 +48,8 @@ class EventManager;
 class MessageState;
 class SoundCommandParser;
 class VirtualIndexFile;
+class IncrementalGC;
+class AvoidPathCache;
 
 enum AbortGameState {
 	kAbortNone = 0,
@@ -188,6 +190,9 @@ struct EngineState : public Common::Serializable {
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	IncrementalGC *_incrementalGC;
+
+	AvoidPathCache *_avoidPathCache; /**< Pathfinding state kept between kAvoidPath calls */
 
 	MessageState *_msgState;
 	void initMessageState();
@@ -247,6 +247,15 @@ ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPt
 	int origin = s->_executionStack.size() - 1; // Origin: Used for debugging
 	int activeBreakpointTypes = g_sci->_debugState._activeBreakpointTypes;
 	ObjVarRef varp;
+	DispatchCache &dispatchCache = s->_segMan->getDispatchCache();
+
+	// The sending script location indexes the inline caches of the selector
+	// lookups below
+	uint32 site = 0;
+	if (!s->_executionStack.empty() && s->_executionStack.back().type == EXEC_STACK_TYPE_CALL) {
+		const reg_t &pc = s->_executionStack.back().addr.pc;
+		site = (pc.getSegment() << 16) ^ pc.getOffset();
+	}
 
 	Common::List<ExecStack>::iterator prevElementIterator = s->_executionStack.end();
 
@@ -262,7 +271,8 @@ ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPt
 		g_sci->_guestAdditions->sendSelectorHook(send_obj, selector, argp);
 #endif
 
-		SelectorType selectorType = lookupSelector(s->_segMan, send_obj, selector, &varp, &funcp);
+		dispatchCache.countSend();
+		SelectorType selectorType = lookupSelector(s->_segMan, send_obj, selector, &varp, &funcp, site);
 		if (selectorType == kSelectorNone)
 			error("Send to invalid selector 0x%x (%s) of object at %04x:%04x", 0xffff & selector, g_sci->getKernel()->getSelectorName(0xffff & selector).c_str(), PRINT_REG(send_obj));
 
@@ -852,10 +862,7 @@ void run_vm(EngineState *s) {
 
 		case op_callk: { // 0x21 (33)
 			// Run the garbage collector, if needed
-			if (s->gcCountDown-- <= 0) {
-				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
-			}
+			s->_incrementalGC->kernelCall(s);
 
 			// Call kernel function
 			s->xs->sp -= (opparams[1] >> 1) + 1;
@@ -388,6 +388,9 @@ void run_vm(EngineState *s);
  * 							fptr is written to iff it is non-NULL and the
  * 							selector indicates a member function of that
  * 							object.
+ * @param[in] site			The script location the selector is sent from,
+ * 							used to index the inline caches, or 0 if not
+ * 							sent by a script.
  * @return					kSelectorNone if the selector was not found in
  * 							the object or its superclasses.
  * 							kSelectorVariable if the selector represents an
@@ -396,7 +399,7 @@ void run_vm(EngineState *s);
  * 							method
  */
 SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
-		ObjVarRef *varp, reg_t *fptr);
+		ObjVarRef *varp, reg_t *fptr, uint32 site = 0);
 
 /**
  * Read a PMachine instruction from a memory buffer and return its length.
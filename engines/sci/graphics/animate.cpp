@@ -21,6 +21,7 @@
 
 #include "common/util.h"
 #include "common/stack.h"
+#include "common/profiler.h"
 #include "graphics/primitives.h"
 
 #include "sci/console.h"
@@ -647,6 +648,8 @@ void GfxAnimate::animateShowPic() {
 }
 
 void GfxAnimate::kernelAnimate(reg_t listReference, bool cycle, int argc, reg_t *argv) {
+	PROFILE_ZONE("GfxAnimate::kernelAnimate");
+
 	// If necessary, delay this kAnimate for a running PalVary.
 	// See delayForPalVaryWorkaround() for details.
 	if (_screen->_picNotValid)
@@ -24,6 +24,7 @@
 #include "common/events.h"
 #include "common/keyboard.h"
 #include "common/list.h"
+#include "common/profiler.h"
 #include "common/str.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -1219,6 +1220,8 @@ void GfxFrameout::updateScreen(const int delta) {
 }
 
 void GfxFrameout::kernelFrameOut(const bool shouldShowBits) {
+	PROFILE_ZONE("GfxFrameout::kernelFrameOut");
+
 	if (_transitions->hasShowStyles()) {
 		_transitions->processShowStyles();
 	} else if (_palMorphIsOn) {
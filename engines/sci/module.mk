@@ -8,6 +8,7 @@ MODULE_OBJS := \
 	metaengine.o \
 	sci.o \
 	util.o \
+	engine/dispatch_cache.o \
 	engine/features.o \
 	engine/file.o \
 	engine/gc.o \
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -210,6 +211,10 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
+	_requestFrame = 0;
+	_manifestRoom = -1;
+	_prefetched = false;
+	_evicted = false;
 }
 
 Resource::~Resource() {
@@ -421,10 +426,18 @@ void ResourceManager::disposeVolumeFileStream(Common::SeekableReadStream *fileSt
 }
 
 void ResourceManager::loadResource(Resource *res) {
+	const uint32 startTime = g_system->getMillis();
+
 	res->_source->loadResource(this, res);
 	if (_patcher) {
 		_patcher->applyPatch(*res);
 	};
+
+	LoadStats &stats = _loadStats[res->getType()];
+	stats.loads++;
+	stats.bytes += res->size();
+	stats.loadTime += g_system->getMillis() - startTime;
+	res->_evicted = false;
 }
 
 
@@ -1006,10 +1019,20 @@ ResourceManager::ResourceManager(const bool detectionMode) :
 
 void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
+	_baseMemoryLRU = _maxMemoryLRU;
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	_roomReloads = 0;
 	_LRU.clear();
 	_resMap.clear();
+	resetLoadStats();
+	_prefetchEnabled = true;
+	_currentRoom = -1;
+	_frame = 1;
+	_frameRequests.clear();
+	_roomManifests.clear();
+	_roomSuccessors.clear();
+	_prefetchQueue.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
 	_currentDiscNo = 1;
@@ -1081,6 +1104,7 @@ void ResourceManager::init() {
 	if (getSciVersion() >= SCI_VERSION_2) {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
+	_baseMemoryLRU = _maxMemoryLRU;
 
 	switch (_viewType) {
 	case kViewEga:
@@ -1154,6 +1178,8 @@ void ResourceManager::freeOldResources() {
 		Resource *goner = _LRU.back();
 		removeFromLRU(goner);
 		goner->unalloc();
+		goner->_evicted = true;
+		goner->_prefetched = false;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
@@ -1196,15 +1222,22 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
-	if (retval->_status == kResStatusNoMalloc)
+	recordRequest(retval);
+
+	if (retval->_status == kResStatusNoMalloc) {
+		if (retval->_evicted) {
+			_loadStats[retval->getType()].reloads++;
+			_roomReloads++;
+		}
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	} else if (retval->_status == kResStatusEnqueued) {
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
 		// will be added back to the LRU list at the 'most
 		// recent' position.
 		removeFromLRU(retval);
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
@@ -1248,6 +1281,155 @@ void ResourceManager::unlockResource(Resource *res) {
 	freeOldResources();
 }
 
+enum {
+	kMaxFrameRequests = 256,
+	kMaxRoomManifestSize = 512,
+	kReloadThreshold = 4,
+	kMaxMemoryLRUFactor = 4
+};
+
+void ResourceManager::resetLoadStats() {
+	memset(_loadStats, 0, sizeof(_loadStats));
+}
+
+static bool isPrefetchableType(ResourceType type) {
+	switch (type) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypeScript:
+	case kResourceTypeHeap:
+	case kResourceTypePalette:
+	case kResourceTypeSound:
+	case kResourceTypeAudio:
+	case kResourceTypeFont:
+	case kResourceTypeMessage:
+		return true;
+	default:
+		// Speech (audio36/sync36) is only played once, and videos are
+		// streamed
+		return false;
+	}
+}
+
+void ResourceManager::recordRequest(Resource *res) {
+	if (res->_prefetched) {
+		_loadStats[res->getType()].prefetchHits++;
+		res->_prefetched = false;
+	}
+
+	if (res->_requestFrame == _frame || _currentRoom < 0 || !isPrefetchableType(res->getType()))
+		return;
+
+	res->_requestFrame = _frame;
+	if (_frameRequests.size() < kMaxFrameRequests)
+		_frameRequests.push_back(res->_id);
+}
+
+void ResourceManager::flushFrameRequests() {
+	if (_currentRoom >= 0) {
+		Common::Array<ResourceId> &manifest = _roomManifests[_currentRoom];
+
+		for (uint i = 0; i < _frameRequests.size(); i++) {
+			Resource *res = testResource(_frameRequests[i]);
+
+			if (!res || res->_manifestRoom == _currentRoom)
+				continue;
+
+			res->_manifestRoom = _currentRoom;
+			if (manifest.size() < kMaxRoomManifestSize && Common::find(manifest.begin(), manifest.end(), res->_id) == manifest.end())
+				manifest.push_back(res->_id);
+		}
+	}
+
+	_frameRequests.clear();
+}
+
+void ResourceManager::queueRoomManifest(uint16 roomNumber) {
+	RoomManifestMap::const_iterator it = _roomManifests.find(roomNumber);
+	if (it == _roomManifests.end())
+		return;
+
+	for (uint i = 0; i < it->_value.size(); i++)
+		_prefetchQueue.push_back(it->_value[i]);
+}
+
+void ResourceManager::adaptMemoryLRU() {
+	// A room that had to load resources again after they were freed did
+	// not fit in the budget, so grow it. Otherwise, slowly shrink it back.
+	if (_roomReloads > kReloadThreshold)
+		_maxMemoryLRU = MIN(_maxMemoryLRU + _maxMemoryLRU / 2, _baseMemoryLRU * kMaxMemoryLRUFactor);
+	else if (_roomReloads == 0)
+		_maxMemoryLRU = MAX(_maxMemoryLRU - _maxMemoryLRU / 8, _baseMemoryLRU);
+
+	debugC(2, kDebugLevelResMan, "[resMan] %u resources reloaded in room %d, LRU budget is now %d bytes", _roomReloads, _currentRoom, _maxMemoryLRU);
+
+	_roomReloads = 0;
+	freeOldResources();
+}
+
+void ResourceManager::updateRoom(uint16 roomNumber) {
+	if (_currentRoom != roomNumber) {
+		if (_currentRoom >= 0) {
+			_roomSuccessors[_currentRoom] = roomNumber;
+			adaptMemoryLRU();
+		}
+
+		// The resources requested in the frame that changed the room
+		// are those of the new room
+		_currentRoom = roomNumber;
+		flushFrameRequests();
+
+		_prefetchQueue.clear();
+		if (_prefetchEnabled) {
+			queueRoomManifest(roomNumber);
+			if (_roomSuccessors.contains(roomNumber) && _roomSuccessors[roomNumber] != roomNumber)
+				queueRoomManifest(_roomSuccessors[roomNumber]);
+		}
+	} else {
+		flushFrameRequests();
+	}
+
+	_frame++;
+}
+
+bool ResourceManager::prefetchResources(uint32 deadline) {
+	bool loaded = false;
+
+	while (!_prefetchQueue.empty() && g_system->getMillis() < deadline) {
+		Resource *res = testResource(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		loadResource(res);
+		loaded = true;
+
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		// The size is only known once the resource is loaded. Never push
+		// resources that are in use out of the LRU.
+		if (_memoryLRU + (int)res->size() > _maxMemoryLRU) {
+			res->unalloc();
+			_prefetchQueue.clear();
+			break;
+		}
+
+		_loadStats[res->getType()].prefetched++;
+		res->_prefetched = true;
+		addToLRU(res);
+	}
+
+	return loaded;
+}
+
+void ResourceManager::setPrefetchEnabled(bool enabled) {
+	_prefetchEnabled = enabled;
+	if (!enabled)
+		_prefetchQueue.clear();
+}
+
 const char *ResourceManager::versionDescription(ResVersion version) const {
 	switch (version) {
 	case kResVersionUnknown:
@@ -2404,7 +2586,9 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	byte *ptr = new byte[_size];
 	_data = ptr;
 	_status = kResStatusAllocated;
+	const uint32 startTime = g_system->getMillis();
 	errorNum = ptr ? dec->unpack(file, ptr, szPacked, _size) : SCI_ERROR_RESOURCE_TOO_BIG;
+	_resMan->addDecompressTime(getType(), g_system->getMillis() - startTime);
 	if (errorNum) {
 		unalloc();
 	} else {
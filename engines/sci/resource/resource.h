@@ -25,6 +25,7 @@
 #include "common/str.h"
 #include "common/list.h"
 #include "common/hashmap.h"
+#include "common/array.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/resource/decompressor.h"
@@ -312,6 +313,11 @@ protected:
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
+	uint32 _requestFrame; /**< Frame in which the resource was last requested */
+	int _manifestRoom; /**< Last room manifest the resource was added to, or -1 */
+	bool _prefetched; /**< Loaded by the prefetcher and not requested since */
+	bool _evicted; /**< Freed by the LRU and not loaded since */
+
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
 	bool loadFromWaveFile(Common::SeekableReadStream *file);
@@ -380,6 +386,54 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Load statistics for a resource type.
+	 */
+	struct LoadStats {
+		uint32 loads;			///< Number of resources loaded
+		uint32 bytes;			///< Size of the loaded resources, uncompressed
+		uint32 loadTime;		///< Time spent loading, in ms
+		uint32 decompressTime;	///< Part of the load time spent decompressing, in ms
+		uint32 reloads;			///< Resources requested again after the LRU freed them
+		uint32 prefetched;		///< Resources loaded by the prefetcher
+		uint32 prefetchHits;	///< Prefetched resources requested before being freed
+	};
+
+	const LoadStats &getLoadStats(ResourceType type) const { return _loadStats[type]; }
+	void resetLoadStats();
+	void addDecompressTime(ResourceType type, uint32 time) { _loadStats[type].decompressTime += time; }
+
+	/**
+	 * Informs the resource manager of the current room, once per frame.
+	 *
+	 * The resources requested in each room are recorded in a manifest for
+	 * that room. When the room changes, the manifest of the new room and
+	 * that of the room entered from it last time are queued for
+	 * prefetching, and the LRU budget is adapted to how many resources the
+	 * previous room had to load again after the LRU freed them.
+	 * @param roomNumber	The current room number
+	 */
+	void updateRoom(uint16 roomNumber);
+
+	/**
+	 * Loads queued resources ahead of their use, as long as they fit in the
+	 * LRU budget.
+	 * @param deadline	Time (as returned by OSystem::getMillis) after which
+	 *					no more resources are loaded
+	 * @return true if any resource was loaded
+	 */
+	bool prefetchResources(uint32 deadline);
+
+	bool isPrefetchEnabled() const { return _prefetchEnabled; }
+	void setPrefetchEnabled(bool enabled);
+	uint getPrefetchQueueSize() const { return _prefetchQueue.size(); }
+	uint getRoomManifestCount() const { return _roomManifests.size(); }
+
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+	int getBaseMemoryLRU() const { return _baseMemoryLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -509,6 +563,24 @@ protected:
 	ResVersion _mapVersion; ///< resource.map version
 	bool _isSci2Mac;
 
+	int _baseMemoryLRU;	///< Initial LRU budget, the adaptive budget never goes below it
+	uint32 _roomReloads;	///< Resources loaded again after the LRU freed them, in the current room
+	LoadStats _loadStats[kResourceTypeInvalid + 1];
+
+	typedef Common::HashMap<uint16, Common::Array<ResourceId> > RoomManifestMap;
+	bool _prefetchEnabled;
+	int _currentRoom;	///< Current room number, or -1 before the first room
+	uint32 _frame;		///< Number of frames since the first room
+	Common::Array<ResourceId> _frameRequests; ///< Resources requested in the current frame
+	RoomManifestMap _roomManifests; ///< Resources requested in each room
+	Common::HashMap<uint16, uint16> _roomSuccessors; ///< Room entered from each room last time
+	Common::List<ResourceId> _prefetchQueue;
+
+	void recordRequest(Resource *res);
+	void flushFrameRequests();
+	void queueRoomManifest(uint16 roomNumber);
+	void adaptMemoryLRU();
+
 	/**
 	 * Add a path to the resource manager's list of sources.
 	 * @return a pointer to the added source structure, or NULL if an error occurred.
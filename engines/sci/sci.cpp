@@ -969,7 +969,10 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		uint32 time = _system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			_system->delayMillis(10);
+			// Spend the time loading the resources the game is expected
+			// to need next, if there are any
+			if (!_resMan->prefetchResources(time + 10))
+				_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				_system->delayMillis(wakeUpTime - time);
@@ -281,6 +281,8 @@ void AkosRenderer::setCostume(int costume, int shadow) {
 	const byte *akos = _vm->getResourceAddress(rtCostume, costume);
 	assert(akos);
 
+	_costumeId = costume;
+
 	_akhd = (const AkosHeader *)_vm->findResourceData(MKTAG('A','K','H','D'), akos);
 	_akof = (const AkosOffset *)_vm->findResourceData(MKTAG('A','K','O','F'), akos);
 	_akci = _vm->findResourceData(MKTAG('A','K','C','I'), akos);
@@ -496,10 +498,11 @@ byte AkosRenderer::drawLimb(const Actor *a, int limb) {
 	return result;
 }
 
-void AkosRenderer::byleRLEDecode(ByleRLEData &dataBlock) {
-	const byte *mask, *src;
+template<class CelSource>
+void AkosRenderer::byleRLEDecode(ByleRLEData &dataBlock, CelSource &source) {
+	const byte *mask;
 	byte *dst;
-	byte len, maskbit;
+	byte maskbit;
 	int lastColumnX, y;
 	uint16 color, height, pcolor;
 	const byte *scaleytab;
@@ -507,213 +510,99 @@ void AkosRenderer::byleRLEDecode(ByleRLEData &dataBlock) {
 
 	lastColumnX = -1;
 	y = dataBlock.y;
-	src = _srcPtr;
 	dst = dataBlock.destPtr;
-	len = dataBlock.repLen;
-	color = dataBlock.repColor;
 	height = _height;
 
 	scaleytab = &dataBlock.scaleTable[MAX<int>(0, dataBlock.scaleYIndex)]; // Avoid invalid mem reads in Basketball...
 	maskbit = revBitMask(dataBlock.x & 7);
 	mask = _vm->getMaskBuffer(dataBlock.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), dataBlock.y, _zbuf);
 
-	if (len)
-		goto StartPos;
-
 	do {
-		len = *src++;
-		color = len >> dataBlock.shr;
-		len &= dataBlock.mask;
-		if (!len)
-			len = *src++;
-
-		do {
-			if (_scaleY == 255 || *scaleytab++ < _scaleY) {
-				if (_actorHitMode) {
-					if (color && y == _actorHitY && dataBlock.x == _actorHitX) {
-						_actorHitResult = true;
-						return;
-					}
-				} else {
-					masked = (y < dataBlock.boundsRect.top || y >= dataBlock.boundsRect.bottom) || (dataBlock.x < 0 || dataBlock.x >= dataBlock.boundsRect.right) || (*mask & maskbit);
-					bool skipColumn = false;
-
-					if (color && !masked) {
-						pcolor = _palette[color];
-						if (_shadowMode == 1) {
-							if (pcolor == 13) {
-								// In shadow mode 1 skipColumn works more or less the same way as in shadow
-								// mode 3. It is only ever checked and applied if pcolor is 13.
-								skipColumn = (lastColumnX == dataBlock.x);
-								pcolor = _shadowTable[*dst];
-							}
-						} else if (_shadowMode == 2) {
-							error("AkosRenderer::byleRLEDecode(): shadowMode 2 not implemented."); // TODO
-						} else if (_shadowMode == 3) {
-							if (_vm->_game.features & GF_16BIT_COLOR) {
-								// I add the column skip here, too, although I don't know whether it always
-								// applies. But this is the only way to prevent recursive shading of pixels.
-								// This might need more fine tuning...
-								skipColumn = (lastColumnX == dataBlock.x);
-								uint16 srcColor = (pcolor >> 1) & 0x7DEF;
-								uint16 dstColor = (READ_UINT16(dst) >> 1) & 0x7DEF;
-								pcolor = srcColor + dstColor;
-							} else if (_vm->_game.heversion >= 90) {
-								// I add the column skip here, too, although I don't know whether it always
-								// applies. But this is the only way to prevent recursive shading of pixels.
-								// This might need more fine tuning...
-								skipColumn = (lastColumnX == dataBlock.x);
-								pcolor = (pcolor << 8) + *dst;
-								pcolor = _xmap[pcolor];
-							} else if (pcolor < 8) {
-								// This mode is used in COMI. The column skip only takes place when the shading
-								// is actually applied (for pcolor < 8). The skip avoids shading of pixels that
-								// already have been shaded.
-								skipColumn = (lastColumnX == dataBlock.x);
-								pcolor = (pcolor << 8) + *dst;
-								pcolor = _shadowTable[pcolor];
-							}
+		color = source.next();
+
+		if (_scaleY == 255 || *scaleytab++ < _scaleY) {
+			if (_actorHitMode) {
+				if (color && y == _actorHitY && dataBlock.x == _actorHitX) {
+					_actorHitResult = true;
+					return;
+				}
+			} else {
+				masked = (y < dataBlock.boundsRect.top || y >= dataBlock.boundsRect.bottom) || (dataBlock.x < 0 || dataBlock.x >= dataBlock.boundsRect.right) || (*mask & maskbit);
+				bool skipColumn = false;
+
+				if (color && !masked) {
+					pcolor = _palette[color];
+					if (_shadowMode == 1) {
+						if (pcolor == 13) {
+							// In shadow mode 1 skipColumn works more or less the same way as in shadow
+							// mode 3. It is only ever checked and applied if pcolor is 13.
+							skipColumn = (lastColumnX == dataBlock.x);
+							pcolor = _shadowTable[*dst];
 						}
-						if (!skipColumn) {
-							if (_vm->_bytesPerPixel == 2) {
-								WRITE_UINT16(dst, pcolor);
-							} else {
-								*dst = pcolor;
-							}
+					} else if (_shadowMode == 2) {
+						error("AkosRenderer::byleRLEDecode(): shadowMode 2 not implemented."); // TODO
+					} else if (_shadowMode == 3) {
+						if (_vm->_game.features & GF_16BIT_COLOR) {
+							// I add the column skip here, too, although I don't know whether it always
+							// applies. But this is the only way to prevent recursive shading of pixels.
+							// This might need more fine tuning...
+							skipColumn = (lastColumnX == dataBlock.x);
+							uint16 srcColor = (pcolor >> 1) & 0x7DEF;
+							uint16 dstColor = (READ_UINT16(dst) >> 1) & 0x7DEF;
+							pcolor = srcColor + dstColor;
+						} else if (_vm->_game.heversion >= 90) {
+							// I add the column skip here, too, although I don't know whether it always
+							// applies. But this is the only way to prevent recursive shading of pixels.
+							// This might need more fine tuning...
+							skipColumn = (lastColumnX == dataBlock.x);
+							pcolor = (pcolor << 8) + *dst;
+							pcolor = _xmap[pcolor];
+						} else if (pcolor < 8) {
+							// This mode is used in COMI. The column skip only takes place when the shading
+							// is actually applied (for pcolor < 8). The skip avoids shading of pixels that
+							// already have been shaded.
+							skipColumn = (lastColumnX == dataBlock.x);
+							pcolor = (pcolor << 8) + *dst;
+							pcolor = _shadowTable[pcolor];
+						}
+					}
+					if (!skipColumn) {
+						if (_vm->_bytesPerPixel == 2) {
+							WRITE_UINT16(dst, pcolor);
+						} else {
+							*dst = pcolor;
 						}
 					}
 				}
-				dst += _out.pitch;
-				mask += _numStrips;
-				y++;
 			}
-			if (!--height) {
-				if (!--dataBlock.skipWidth)
+			dst += _out.pitch;
+			mask += _numStrips;
+			y++;
+		}
+		if (!--height) {
+			if (!--dataBlock.skipWidth)
+				return;
+			height = _height;
+			y = dataBlock.y;
+
+			scaleytab = &dataBlock.scaleTable[MAX<int>(0, dataBlock.scaleYIndex)]; // Avoid invalid mem reads in Basketball...
+			lastColumnX = dataBlock.x;
+
+			if (_scaleX == 255 || dataBlock.scaleTable[dataBlock.scaleXIndex] < _scaleX) {
+				dataBlock.x += dataBlock.scaleXStep;
+				if (dataBlock.x < 0 || dataBlock.x >= dataBlock.boundsRect.right)
 					return;
-				height = _height;
-				y = dataBlock.y;
-
-				scaleytab = &dataBlock.scaleTable[MAX<int>(0, dataBlock.scaleYIndex)]; // Avoid invalid mem reads in Basketball...
-				lastColumnX = dataBlock.x;
-
-				if (_scaleX == 255 || dataBlock.scaleTable[dataBlock.scaleXIndex] < _scaleX) {
-					dataBlock.x += dataBlock.scaleXStep;
-					if (dataBlock.x < 0 || dataBlock.x >= dataBlock.boundsRect.right)
-						return;
-					maskbit = revBitMask(dataBlock.x & 7);
-					dataBlock.destPtr += dataBlock.scaleXStep * _vm->_bytesPerPixel;
-				}
-
-				dataBlock.scaleXIndex += dataBlock.scaleXStep;
-				dst = dataBlock.destPtr;
-				mask = _vm->getMaskBuffer(dataBlock.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), dataBlock.y, _zbuf);
+				maskbit = revBitMask(dataBlock.x & 7);
+				dataBlock.destPtr += dataBlock.scaleXStep * _vm->_bytesPerPixel;
 			}
-		StartPos:;
-		} while (--len);
+
+			dataBlock.scaleXIndex += dataBlock.scaleXStep;
+			dst = dataBlock.destPtr;
+			mask = _vm->getMaskBuffer(dataBlock.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), dataBlock.y, _zbuf);
+		}
 	} while (true);
 }
 
-const byte bigCostumeScaleTable[768] = {
-	0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
-	0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
-	0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8,
-	0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
-	0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4,
-	0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
-	0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC,
-	0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
-	0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2,
-	0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
-	0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA,
-	0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
-	0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6,
-	0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
-	0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE,
-	0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
-	0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1,
-	0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
-	0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9,
-	0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
-	0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5,
-	0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
-	0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED,
-	0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
-	0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3,
-	0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
-	0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB,
-	0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
-	0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7,
-	0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
-	0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF,
-	0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFE,
-
-	0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
-	0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
-	0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8,
-	0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
-	0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4,
-	0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
-	0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC,
-	0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
-	0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2,
-	0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
-	0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA,
-	0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
-	0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6,
-	0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
-	0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE,
-	0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
-	0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1,
-	0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
-	0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9,
-	0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
-	0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5,
-	0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
-	0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED,
-	0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
-	0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3,
-	0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
-	0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB,
-	0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
-	0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7,
-	0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
-	0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF,
-	0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFE,
-
-	0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
-	0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
-	0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8,
-	0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
-	0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4,
-	0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
-	0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC,
-	0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
-	0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2,
-	0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
-	0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA,
-	0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
-	0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6,
-	0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
-	0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE,
-	0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
-	0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1,
-	0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
-	0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9,
-	0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
-	0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5,
-	0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
-	0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED,
-	0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
-	0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3,
-	0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
-	0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB,
-	0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
-	0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7,
-	0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
-	0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF,
-	0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF,
-};
-
 byte AkosRenderer::paintCelByleRLE(int xMoveCur, int yMoveCur) {
 	int num_colors;
 	bool actorIsScaled;
@@ -746,6 +635,9 @@ byte AkosRenderer::paintCelByleRLE(int xMoveCur, int yMoveCur) {
 		compData.shr = 4;
 	}
 
+	// Decode the whole cel up front, unless it has been drawn recently
+	const byte *cachedCel = getCachedCel(_akcd, compData.shr, compData.mask);
+
 	actorIsScaled = (_scaleX != 0xFF) || (_scaleY != 0xFF);
 
 	compData.x = _actorX;
@@ -908,6 +800,7 @@ byte AkosRenderer::paintCelByleRLE(int xMoveCur, int yMoveCur) {
 		return 0;
 
 	compData.repLen = 0;
+	compData.startColumn = 0;
 
 	if (_mirror) {
 		if (!actorIsScaled)
@@ -966,7 +859,13 @@ byte AkosRenderer::paintCelByleRLE(int xMoveCur, int yMoveCur) {
 	compData.height = _out.h;
 	compData.destPtr = (byte *)_out.getBasePtr(compData.x, compData.y);
 
-	byleRLEDecode(compData);
+	if (cachedCel) {
+		CachedCelSource source(cachedCel, _height, compData);
+		byleRLEDecode(compData, source);
+	} else {
+		ByleRLESource source(_srcPtr, compData);
+		byleRLEDecode(compData, source);
+	}
 
 	return drawFlag;
 }
@@ -22,6 +22,8 @@
 
 #include "scumm/base-costume.h"
 #include "scumm/costume.h"
+#include "scumm/resource.h"
+#include "scumm/scumm.h"
 
 namespace Scumm {
 
@@ -58,6 +60,7 @@ byte BaseCostumeRenderer::drawCostume(const VirtScreen &vs, int numStrips, const
 }
 
 void BaseCostumeRenderer::skipCelLines(ByleRLEData &compData, int num) {
+	compData.startColumn += num;
 	num *= _height;
 
 	do {
@@ -75,6 +78,91 @@ void BaseCostumeRenderer::skipCelLines(ByleRLEData &compData, int num) {
 	} while (true);
 }
 
+const byte *BaseCostumeRenderer::getCachedCel(const byte *costumeData, byte shr, byte mask) {
+	// HE games can change their costumes at runtime
+	if (_vm->_game.heversion != 0 || _width <= 0 || _height <= 0)
+		return nullptr;
+
+	// Keep the cache in proportion to the memory the game may use for
+	// its resources
+	if (!_celCache.getBudget())
+		_celCache.setBudget(MAX<uint32>(_vm->_res->getMaxHeapThreshold() / 4, 128 * 1024));
+
+	return _celCache.getByleRLECel(_costumeId, costumeData, _srcPtr, _width, _height, shr, mask);
+}
+
+const byte *CostumeCelCache::getByleRLECel(int costume, const byte *costumeData, const byte *src, int width, int height, byte shr, byte mask) {
+	Key key;
+	key.costume = costume;
+	key.offset = src - costumeData;
+	key.width = width;
+	key.height = height;
+	key.shr = shr;
+
+	Common::HashMap<Key, EntryList::iterator, KeyHash>::iterator it = _entries.find(key);
+	if (it != _entries.end()) {
+		_stats.hits++;
+		if (it->_value != _lru.begin()) {
+			Entry entry = *it->_value;
+			_lru.erase(it->_value);
+			_lru.push_front(entry);
+			it->_value = _lru.begin();
+		}
+		return _lru.front().pixels;
+	}
+
+	_stats.misses++;
+
+	const uint32 size = width * height;
+	if (size > _budget)
+		return nullptr;
+	evict(size);
+
+	Entry entry;
+	entry.key = key;
+	entry.size = size;
+	entry.pixels = new byte[size];
+
+	BaseCostumeRenderer::ByleRLEData compData;
+	compData.repLen = 0;
+	compData.repColor = 0;
+	compData.shr = shr;
+	compData.mask = mask;
+	BaseCostumeRenderer::ByleRLESource source(src, compData);
+	for (uint32 i = 0; i < size; ++i)
+		entry.pixels[i] = source.next();
+
+	_lru.push_front(entry);
+	_entries[key] = _lru.begin();
+	_size += size;
+
+	return entry.pixels;
+}
+
+void CostumeCelCache::evict(uint32 needed) {
+	while (!_lru.empty() && _size + needed > _budget) {
+		Entry &entry = _lru.back();
+		_entries.erase(entry.key);
+		_size -= entry.size;
+		delete[] entry.pixels;
+		_lru.pop_back();
+		_stats.evictions++;
+	}
+}
+
+void CostumeCelCache::setBudget(uint32 budget) {
+	_budget = budget;
+	evict(0);
+}
+
+void CostumeCelCache::clear() {
+	for (EntryList::iterator it = _lru.begin(); it != _lru.end(); ++it)
+		delete[] it->pixels;
+	_lru.clear();
+	_entries.clear();
+	_size = 0;
+}
+
 bool ScummEngine::isCostumeInUse(int cost) const {
 	Actor *a;
 
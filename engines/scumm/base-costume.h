@@ -23,6 +23,8 @@
 #define SCUMM_BASE_COSTUME_H
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/list.h"
 #include "scumm/actor.h"		// for CostumeData
 
 namespace Scumm {
@@ -46,6 +48,82 @@ class Actor;
 class ScummEngine;
 struct VirtScreen;
 
+/**
+ * LRU cache of decoded costume cels.
+ *
+ * Cels are stored unmirrored and unscaled as one color index per pixel,
+ * column by column, i.e. in the order the run-length encoded data is
+ * drawn. Mirroring, scaling, masking and the actor palette are applied
+ * when drawing from the cache, so the same entry serves every actor
+ * using a costume, whatever its facing, scale or palette.
+ */
+class CostumeCelCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+
+		Stats() : hits(0), misses(0), evictions(0) {}
+	};
+
+	CostumeCelCache() : _size(0), _budget(0) {}
+	~CostumeCelCache() { clear(); }
+
+	/**
+	 * Return the decoded pixels of the run-length encoded cel at src, a
+	 * part of the given costume resource. Returns nullptr if the cel does
+	 * not fit into the cache.
+	 */
+	const byte *getByleRLECel(int costume, const byte *costumeData, const byte *src, int width, int height, byte shr, byte mask);
+
+	void clear();
+	void resetStats() { _stats = Stats(); }
+
+	uint32 getBudget() const { return _budget; }
+	void setBudget(uint32 budget);
+
+	uint32 getSize() const { return _size; }
+	uint getNumEntries() const { return _entries.size(); }
+	const Stats &getStats() const { return _stats; }
+
+private:
+	struct Key {
+		int costume;
+		uint32 offset;
+		uint16 width, height;
+		byte shr;
+
+		bool operator==(const Key &other) const {
+			return costume == other.costume && offset == other.offset && width == other.width &&
+				height == other.height && shr == other.shr;
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return (uint)key.costume * 2654435761U ^ key.offset ^ ((uint)key.shr << 24);
+		}
+	};
+
+	struct Entry {
+		Key key;
+		byte *pixels;
+		uint32 size;
+	};
+
+	typedef Common::List<Entry> EntryList;
+
+	void evict(uint32 needed);
+
+	// Most recently used entries come first
+	EntryList _lru;
+	Common::HashMap<Key, EntryList::iterator, KeyHash> _entries;
+	uint32 _size;
+	uint32 _budget;
+	Stats _stats;
+};
+
 class BaseCostumeLoader {
 protected:
 	ScummEngine *_vm;
@@ -104,6 +182,17 @@ protected:
 	// width and height of cel to decode
 	int _width, _height;
 
+	// number of the costume set with setCostume()
+	int _costumeId;
+
+	CostumeCelCache _celCache;
+
+	/**
+	 * Return the cached decoded form of the run-length encoded cel at
+	 * _srcPtr, or nullptr if it cannot be cached.
+	 */
+	const byte *getCachedCel(const byte *costumeData, byte shr, byte mask);
+
 public:
 	struct ByleRLEData {
 		// Parameters for the original ("V1") costume codec.
@@ -123,6 +212,45 @@ public:
 		// These ones aren't accessed from ARM code.
 		Common::Rect boundsRect;
 		int scaleXIndex, scaleYIndex;
+		int startColumn;
+	};
+
+	/** Returns the colors of a cel from its run-length encoded data. */
+	struct ByleRLESource {
+		const byte *src;
+		uint len;
+		byte color;
+		byte shr, mask;
+
+		// Resumes where skipCelLines() left off, if it was called
+		ByleRLESource(const byte *srcPtr, const ByleRLEData &compData) :
+			src(srcPtr), len(compData.repLen ? compData.repLen - 1 : 0),
+			color(compData.repColor), shr(compData.shr), mask(compData.mask) {}
+
+		inline byte next() {
+			if (!len) {
+				len = *src++;
+				color = len >> shr;
+				len &= mask;
+				if (!len) {
+					len = *src++;
+					if (!len)
+						len = 256;
+				}
+			}
+			--len;
+			return color;
+		}
+	};
+
+	/** Returns the colors of a cel decoded by CostumeCelCache. */
+	struct CachedCelSource {
+		const byte *pos;
+
+		CachedCelSource(const byte *cel, int height, const ByleRLEData &compData) :
+			pos(cel + compData.startColumn * height) {}
+
+		inline byte next() { return *pos++; }
 	};
 
 	BaseCostumeRenderer(ScummEngine *scumm) {
@@ -144,9 +272,12 @@ public:
 		_paletteNum = 0;
 		_actorDrawVirScr = false;
 		_numBlocks = 0;
+		_costumeId = 0;
 	}
 	virtual ~BaseCostumeRenderer() {}
 
+	CostumeCelCache &getCelCache() { return _celCache; }
+
 	virtual void setPalette(uint16 *palette) = 0;
 	virtual void setFacing(const Actor *a) = 0;
 	virtual void setCostume(int costume, int shadow) = 0;
@@ -111,6 +111,11 @@ byte ClassicCostumeRenderer::mainRoutine(int xmoveCur, int ymoveCur) {
 		break;
 	}
 
+	// Decode the whole cel up front, unless it has been drawn recently
+	const byte *cachedCel = nullptr;
+	if (!newAmiCost && !pcEngCost && _loaded._format != 0x57)
+		cachedCel = getCachedCel(_loaded._baseptr, compData.shr, compData.mask);
+
 	use_scaling = (_scaleX != 0xFF) || (_scaleY != 0xFF);
 
 	compData.x = _actorX;
@@ -235,6 +240,7 @@ byte ClassicCostumeRenderer::mainRoutine(int xmoveCur, int ymoveCur) {
 		return 0;
 
 	compData.repLen = 0;
+	compData.startColumn = 0;
 
 	if (_mirror) {
 		if (!use_scaling)
@@ -313,8 +319,13 @@ byte ClassicCostumeRenderer::mainRoutine(int xmoveCur, int ymoveCur) {
 		proc3_ami(compData);
 	else if (pcEngCost)
 		procPCEngine(compData);
-	else
-		proc3(compData);
+	else if (cachedCel) {
+		CachedCelSource source(cachedCel, _height, compData);
+		proc3(compData, source);
+	} else {
+		ByleRLESource source(_srcPtr, compData);
+		proc3(compData, source);
+	}
 
 	return drawFlag;
 }
@@ -436,10 +447,11 @@ extern "C" int ClassicProc3RendererShadowARM(int _scaleY,
 										int _scaleIndexY);
 #endif
 
-void ClassicCostumeRenderer::proc3(ByleRLEData &compData) {
-	const byte *mask, *src;
+template<class CelSource>
+void ClassicCostumeRenderer::proc3(ByleRLEData &compData, CelSource &source) {
+	const byte *mask;
 	byte *dst;
-	byte len, maskbit;
+	byte maskbit;
 	int y;
 	uint color, height, pcolor;
 	byte scaleIndexY;
@@ -466,76 +478,63 @@ void ClassicCostumeRenderer::proc3(ByleRLEData &compData) {
 #endif /* USE_ARM_COSTUME_ASM */
 
 	y = compData.y;
-	src = _srcPtr;
 	dst = compData.destPtr;
-	len = compData.repLen;
-	color = compData.repColor;
 	height = _height;
 
 	scaleIndexY = _scaleIndexY;
 	maskbit = revBitMask(compData.x & 7);
 	mask = compData.maskPtr + compData.x / 8;
 
-	if (len)
-		goto StartPos;
-
 	do {
-		len = *src++;
-		color = len >> compData.shr;
-		len &= compData.mask;
-		if (!len)
-			len = *src++;
+		color = source.next();
 
-		do {
-			if (_scaleY == 255 || compData.scaleTable[scaleIndexY++] < _scaleY) {
-				masked = (y < 0 || y >= _out.h) || (compData.x < 0 || compData.x >= _out.w) || (compData.maskPtr && (mask[0] & maskbit));
+		if (_scaleY == 255 || compData.scaleTable[scaleIndexY++] < _scaleY) {
+			masked = (y < 0 || y >= _out.h) || (compData.x < 0 || compData.x >= _out.w) || (compData.maskPtr && (mask[0] & maskbit));
 
-				if (color && !masked) {
-					if (_shadowMode & 0x20) {
+			if (color && !masked) {
+				if (_shadowMode & 0x20) {
+					pcolor = _shadowTable[*dst];
+				} else {
+					pcolor = _palette[color];
+					if (pcolor == 13 && _shadowTable)
 						pcolor = _shadowTable[*dst];
-					} else {
-						pcolor = _palette[color];
-						if (pcolor == 13 && _shadowTable)
-							pcolor = _shadowTable[*dst];
-					}
-					*dst = pcolor;
 				}
-				dst += _out.pitch;
-				mask += _numStrips;
-				y++;
+				*dst = pcolor;
 			}
-			if (!--height) {
-				if (!--compData.skipWidth)
-					return;
-				height = _height;
-				y = compData.y;
-
-				scaleIndexY = _scaleIndexY;
+			dst += _out.pitch;
+			mask += _numStrips;
+			y++;
+		}
+		if (!--height) {
+			if (!--compData.skipWidth)
+				return;
+			height = _height;
+			y = compData.y;
 
-				if (_scaleX == 255 || compData.scaleTable[_scaleIndexX] < _scaleX) {
-					compData.x += compData.scaleXStep;
-					if (compData.x < 0 || compData.x >= _out.w)
-						return;
-					maskbit = revBitMask(compData.x & 7);
-					compData.destPtr += compData.scaleXStep;
-				}
+			scaleIndexY = _scaleIndexY;
 
-				// From MONKEY1 EGA disasm: we only increment by 1.
-				// This accurately produces the original wonky scaling
-				// for the floppy editions of Monkey Island 1.
-				// Also valid for all other v4 games (this code is
-				// also in the executable for LOOM CD).
-				if (_vm->_game.version == 4) {
-					_scaleIndexX++;
-				} else {
-					_scaleIndexX += compData.scaleXStep;
-				}
+			if (_scaleX == 255 || compData.scaleTable[_scaleIndexX] < _scaleX) {
+				compData.x += compData.scaleXStep;
+				if (compData.x < 0 || compData.x >= _out.w)
+					return;
+				maskbit = revBitMask(compData.x & 7);
+				compData.destPtr += compData.scaleXStep;
+			}
 
-				dst = compData.destPtr;
-				mask = compData.maskPtr + compData.x / 8;
+			// From MONKEY1 EGA disasm: we only increment by 1.
+			// This accurately produces the original wonky scaling
+			// for the floppy editions of Monkey Island 1.
+			// Also valid for all other v4 games (this code is
+			// also in the executable for LOOM CD).
+			if (_vm->_game.version == 4) {
+				_scaleIndexX++;
+			} else {
+				_scaleIndexX += compData.scaleXStep;
 			}
-		StartPos:;
-		} while (--len);
+
+			dst = compData.destPtr;
+			mask = compData.maskPtr + compData.x / 8;
+		}
 	} while (1);
 }
 
@@ -1125,6 +1124,7 @@ void ClassicCostumeRenderer::setFacing(const Actor *a) {
 
 void ClassicCostumeRenderer::setCostume(int costume, int shadow) {
 	_loaded.loadCostume(costume);
+	_costumeId = costume;
 }
 
 bool ClassicCostumeLoader::increaseAnims(Actor *a) {
@@ -99,7 +99,8 @@ public:
 protected:
 	byte drawLimb(const Actor *a, int limb) override;
 
-	void proc3(ByleRLEData &v1);
+	template<class CelSource>
+	void proc3(ByleRLEData &v1, CelSource &source);
 	void proc3_ami(ByleRLEData &v1);
 
 	void procC64(ByleRLEData &v1, int actor);
@@ -111,6 +111,8 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 #endif
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+	registerCmd("stripcache",      WRAP_METHOD(ScummDebugger, Cmd_StripCache));
+	registerCmd("celcache",        WRAP_METHOD(ScummDebugger, Cmd_CelCache));
 }
 
 void ScummDebugger::preEnter() {
@@ -297,6 +299,14 @@ bool ScummDebugger::Cmd_DiMuse(int argc, const char **argv) {
 		} else if (!strcmp(argv[1], "groups") || !strcmp(argv[1], "vols")) {
 			_vm->_imuseDigital->listGroups();
 			return true;
+		} else if (!strcmp(argv[1], "streams")) {
+			if (argc > 2 && !strcmp(argv[2], "reset")) {
+				_vm->_imuseDigital->resetStreamStats();
+				debugPrintf("Stream statistics reset.\n");
+			} else {
+				_vm->_imuseDigital->listStreams();
+			}
+			return true;
 		} else if (!strcmp(argv[1], "getParam")) {
 			if (argc > 3) {
 				int result = _vm->_imuseDigital->diMUSEGetParam(atoi(argv[2]), strtol(argv[3], NULL, 16));
@@ -356,6 +366,7 @@ bool ScummDebugger::Cmd_DiMuse(int argc, const char **argv) {
 	debugPrintf("\thook <soundId> <hookId>          - Set hookId for a sound\n");
 	debugPrintf("\tlist|tracks                      - Display info for every virtual audio track\n");
 	debugPrintf("\tgroups|vols                      - Show volume groups info\n");
+	debugPrintf("\tstreams [reset]                  - Show (or reset) stream underruns and bundle read-ahead stats\n");
 	debugPrintf("\tgetParam <soundId> <param>       - Get parameter info from a sound\n");
 	debugPrintf("\tsetParam <soundId> <param> <val> - Set parameter value for a sound (dangerous!)\n");
 	debugPrintf("\n");
@@ -1414,4 +1425,67 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_StripCache(int argc, const char **argv) {
+	RoomStripCache &cache = _vm->_gdi->getStripCache();
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			cache.setEnabled(true);
+		} else if (!strcmp(argv[1], "off")) {
+			cache.setEnabled(false);
+		} else if (!strcmp(argv[1], "reset")) {
+			cache.invalidate();
+			cache.resetStats();
+		} else {
+			debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+			return true;
+		}
+	}
+
+	debugPrintf("Room strip cache: %s, %u strips, %u of %u KB\n", cache.isEnabled() ? "on" : "off",
+		cache.getNumEntries(), cache.getSize() / 1024, cache.getBudget() / 1024);
+
+	const RoomStripCache::Stats &last = cache.getLastFrameStats();
+	debugPrintf("Last frame: %u strips decoded in %u ms, %u strips from the cache\n",
+		last.stripsDecoded, last.decodeMillis, last.stripsCached);
+
+	const RoomStripCache::Stats &total = cache.getTotalStats();
+	if (total.frames) {
+		debugPrintf("Average over %u frames: %.2f strips decoded in %.3f ms, %.2f strips from the cache\n",
+			total.frames, (double)total.stripsDecoded / total.frames,
+			(double)total.decodeMillis / total.frames, (double)total.stripsCached / total.frames);
+	}
+
+	return true;
+}
+
+bool ScummDebugger::Cmd_CelCache(int argc, const char **argv) {
+	if (!_vm->_costumeRenderer) {
+		debugPrintf("No costume renderer\n");
+		return true;
+	}
+
+	CostumeCelCache &cache = _vm->_costumeRenderer->getCelCache();
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "clear")) {
+			cache.clear();
+		} else if (!strcmp(argv[1], "reset")) {
+			cache.resetStats();
+		} else {
+			debugPrintf("Usage: %s [clear|reset]\n", argv[0]);
+			return true;
+		}
+	}
+
+	const CostumeCelCache::Stats &stats = cache.getStats();
+	const uint32 lookups = stats.hits + stats.misses;
+	debugPrintf("Costume cel cache: %u cels, %u of %u KB\n", cache.getNumEntries(),
+		cache.getSize() / 1024, cache.getBudget() / 1024);
+	debugPrintf("%u hits, %u misses (%.1f%% hit rate), %u evictions\n", stats.hits, stats.misses,
+		lookups ? 100.0 * stats.hits / lookups : 0.0, stats.evictions);
+
+	return true;
+}
+
 } // End of namespace Scumm
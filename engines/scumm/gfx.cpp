@@ -285,6 +285,8 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	// A new room may be loaded at the address of the previous one
+	_stripCache.invalidate();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -2319,6 +2321,107 @@ int Gdi::getZPlanes(const byte *ptr, const byte *zplane_list[9], bool bmapImage)
 	return numzbuf;
 }
 
+RoomStripCache::RoomStripCache() : _bitmap(nullptr), _height(0), _numZBuf(0),
+	_entrySize(0), _size(0), _budget(kDefaultBudget), _enabled(true) {
+	memset(_palette, 0, sizeof(_palette));
+}
+
+RoomStripCache::~RoomStripCache() {
+	invalidate();
+}
+
+void RoomStripCache::setEnabled(bool enable) {
+	_enabled = enable;
+	if (!enable)
+		invalidate();
+}
+
+void RoomStripCache::invalidate() {
+	for (uint i = 0; i < _entries.size(); ++i)
+		delete[] _entries[i].data;
+	_entries.clear();
+	_bitmap = nullptr;
+	_size = 0;
+}
+
+void RoomStripCache::setSource(const byte *bitmap, int height, int numZBuf, const byte *roomPalette) {
+	if (bitmap == _bitmap && height == _height && numZBuf == _numZBuf && !memcmp(roomPalette, _palette, sizeof(_palette)))
+		return;
+
+	invalidate();
+	_bitmap = bitmap;
+	_height = height;
+	_numZBuf = numZBuf;
+	memcpy(_palette, roomPalette, sizeof(_palette));
+	_entrySize = 8 * height + MAX(numZBuf - 1, 0) * height;
+}
+
+const byte *RoomStripCache::lookup(int stripnr, bool &transparent) const {
+	if (stripnr < 0 || stripnr >= (int)_entries.size() || !_entries[stripnr].data)
+		return nullptr;
+
+	transparent = _entries[stripnr].transparent;
+	return _entries[stripnr].data;
+}
+
+byte *RoomStripCache::store(int stripnr, bool transparent) {
+	if (stripnr < 0 || _size + _entrySize > _budget)
+		return nullptr;
+
+	if (stripnr >= (int)_entries.size()) {
+		const uint oldSize = _entries.size();
+		_entries.resize(stripnr + 1);
+		for (uint i = oldSize; i < _entries.size(); ++i) {
+			_entries[i].data = nullptr;
+			_entries[i].transparent = false;
+		}
+	}
+
+	Entry &entry = _entries[stripnr];
+	if (!entry.data) {
+		entry.data = new byte[_entrySize];
+		_size += _entrySize;
+	}
+	entry.transparent = transparent;
+	return entry.data;
+}
+
+uint RoomStripCache::getNumEntries() const {
+	uint num = 0;
+	for (uint i = 0; i < _entries.size(); ++i) {
+		if (_entries[i].data)
+			++num;
+	}
+	return num;
+}
+
+void RoomStripCache::resetStats() {
+	_frame.clear();
+	_lastFrame.clear();
+	_total.clear();
+}
+
+void RoomStripCache::endFrame() {
+	_frame.frames = 1;
+	_lastFrame = _frame;
+
+	_total.frames++;
+	_total.stripsDecoded += _frame.stripsDecoded;
+	_total.stripsCached += _frame.stripsCached;
+	_total.decodeMillis += _frame.decodeMillis;
+
+	_frame.clear();
+}
+
+bool Gdi::canUseStripCache(const VirtScreen *vs, int y, int height, byte flag) const {
+	// Only the background of the main screen is cached, and only for the
+	// games using the generic strip decoders with an 8-bit room palette
+	return _stripCache.isEnabled() && flag == 0 && y == 0 && height == vs->h &&
+		vs->number == kMainVirtScreen && vs->hasTwoBuffers && vs->format.bytesPerPixel == 1 &&
+		_vm->_game.version >= 5 && _vm->_game.version <= 7 && _vm->_game.heversion == 0 &&
+		_vm->_game.platform != Common::kPlatformAmiga && !(_vm->_game.features & GF_16BIT_COLOR);
+}
+
 /**
  * Draw a bitmap onto a virtual screen. This is main drawing method for room backgrounds
  * and objects, used throughout all SCUMM versions.
@@ -2381,6 +2484,14 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		limit = numstrip;
 	if (limit > _numStrips - sx)
 		limit = _numStrips - sx;
+
+	const bool useStripCache = canUseStripCache(vs, y, height, flag);
+	if (useStripCache)
+		_stripCache.setSource(smap_ptr, height, numzbuf, _roomPalette);
+
+	const uint32 decodeStart = _vm->_system->getMillis();
+	uint32 stripsDecoded = 0, stripsCached = 0;
+
 	for (int k = 0; k < limit; ++k, ++stripnr, ++sx, ++x) {
 		if (y < vs->tdirty[sx])
 			vs->tdirty[sx] = y;
@@ -2395,7 +2506,15 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const byte *cachedStrip = useStripCache ? _stripCache.lookup(stripnr, transpStrip) : nullptr;
+		if (cachedStrip) {
+			for (int h = 0; h < height; ++h)
+				memcpy(dstPtr + h * vs->pitch, cachedStrip + h * 8, 8);
+			++stripsCached;
+		} else {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+			++stripsDecoded;
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -2409,7 +2528,32 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (cachedStrip) {
+			const byte *src = cachedStrip + 8 * height;
+			for (int i = 1; i < numzbuf; ++i, src += height) {
+				if (!zplane_list[i])
+					continue;
+				byte *mask_ptr = getMaskBuffer(x, y, i);
+				for (int h = 0; h < height; ++h)
+					mask_ptr[h * _numStrips] = src[h];
+			}
+		} else {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			byte *dst = useStripCache ? _stripCache.store(stripnr, transpStrip) : nullptr;
+			if (dst) {
+				for (int h = 0; h < height; ++h)
+					memcpy(dst + h * 8, dstPtr + h * vs->pitch, 8);
+				dst += 8 * height;
+				for (int i = 1; i < numzbuf; ++i, dst += height) {
+					if (!zplane_list[i])
+						continue;
+					const byte *mask_ptr = getMaskBuffer(x, y, i);
+					for (int h = 0; h < height; ++h)
+						dst[h] = mask_ptr[h * _numStrips];
+				}
+			}
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -2443,6 +2587,12 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		}
 #endif
 	}
+
+	if (useStripCache) {
+		if (stripsDecoded)
+			_stripCache.addDecoded(stripsDecoded, _vm->_system->getMillis() - decodeStart);
+		_stripCache.addCached(stripsCached);
+	}
 }
 
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
@@ -23,6 +23,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -289,6 +290,88 @@ struct StripTable;
 #define CHARSET_MASK_TRANSPARENCY	 0xFD
 #define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
 
+/**
+ * Cache of decoded room background strips and their z-plane masks.
+ *
+ * Room images never change while a room is loaded, so when scrolling the
+ * strips coming into view can be copied from here instead of being
+ * decompressed again. The cache is keyed on the room bitmap, its height,
+ * the number of z-planes and the room palette remapping; a change of any
+ * of these drops all cached strips. Only strips fitting into the memory
+ * budget are kept.
+ */
+class RoomStripCache {
+public:
+	struct Stats {
+		uint32 frames;
+		uint32 stripsDecoded;
+		uint32 stripsCached;
+		uint32 decodeMillis;
+
+		Stats() { clear(); }
+		void clear() { frames = stripsDecoded = stripsCached = decodeMillis = 0; }
+	};
+
+	enum {
+		kDefaultBudget = 2 * 1024 * 1024
+	};
+
+	RoomStripCache();
+	~RoomStripCache();
+
+	bool isEnabled() const { return _enabled; }
+	void setEnabled(bool enable);
+
+	/** Drop all cached strips. */
+	void invalidate();
+
+	/**
+	 * Prepare the cache for drawing strips of the given room bitmap; drops
+	 * the cached strips if the bitmap or its decoding parameters changed.
+	 */
+	void setSource(const byte *bitmap, int height, int numZBuf, const byte *roomPalette);
+
+	/**
+	 * Return the cached pixels (8 * height bytes) followed by the masks
+	 * (height bytes per z-plane above 0) of a strip, or nullptr.
+	 */
+	const byte *lookup(int stripnr, bool &transparent) const;
+
+	/** Allocate the storage for a strip, or return nullptr if over budget. */
+	byte *store(int stripnr, bool transparent);
+
+	uint32 getSize() const { return _size; }
+	uint32 getBudget() const { return _budget; }
+	uint getNumEntries() const;
+
+	/** Statistics of the previous frame and since the statistics were reset. */
+	const Stats &getLastFrameStats() const { return _lastFrame; }
+	const Stats &getTotalStats() const { return _total; }
+	void resetStats();
+
+	void addDecoded(uint32 strips, uint32 millis) { _frame.stripsDecoded += strips; _frame.decodeMillis += millis; }
+	void addCached(uint32 strips) { _frame.stripsCached += strips; }
+	void endFrame();
+
+private:
+	struct Entry {
+		byte *data;
+		bool transparent;
+	};
+
+	Common::Array<Entry> _entries;
+	const byte *_bitmap;
+	int _height;
+	int _numZBuf;
+	byte _palette[256];
+	uint32 _entrySize;
+	uint32 _size;
+	uint32 _budget;
+	bool _enabled;
+
+	Stats _frame, _lastFrame, _total;
+};
+
 class Gdi {
 protected:
 	ScummEngine *_vm;
@@ -304,6 +387,10 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	RoomStripCache _stripCache;
+
+	bool canUseStripCache(const VirtScreen *vs, int y, int height, byte flag) const;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -377,6 +464,8 @@ public:
 
 	void resetBackground(int top, int bottom, int strip);
 
+	RoomStripCache &getStripCache() { return _stripCache; }
+
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
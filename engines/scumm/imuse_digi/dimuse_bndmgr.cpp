@@ -137,8 +137,89 @@ int BundleDirCache::matchFile(const char *filename) {
 	}
 }
 
-BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache) {
+BundleBlockPool::BundleBlockPool() {
+	_buffer = (byte *)malloc(kNumBlocks * DIMUSE_BUN_CHUNK_SIZE);
+	assert(_buffer);
+	for (int i = 0; i < kNumBlocks; i++) {
+		_blocks[i].owner = nullptr;
+		_blocks[i].index = -1;
+		_blocks[i].outputSize = 0;
+		_blocks[i].lastUse = 0;
+		_blocks[i].data = _buffer + i * DIMUSE_BUN_CHUNK_SIZE;
+	}
+	_clock = 0;
+	resetStats();
+}
+
+BundleBlockPool::~BundleBlockPool() {
+	free(_buffer);
+}
+
+BundleBlockPool::Block *BundleBlockPool::get(const BundleMgr *owner, int32 index) {
+	for (int i = 0; i < kNumBlocks; i++) {
+		if (_blocks[i].owner == owner && _blocks[i].index == index) {
+			_blocks[i].lastUse = ++_clock;
+			_stats.hits++;
+			return &_blocks[i];
+		}
+	}
+
+	return nullptr;
+}
+
+bool BundleBlockPool::contains(const BundleMgr *owner, int32 index) const {
+	for (int i = 0; i < kNumBlocks; i++) {
+		if (_blocks[i].owner == owner && _blocks[i].index == index)
+			return true;
+	}
+
+	return false;
+}
+
+BundleBlockPool::Block *BundleBlockPool::claim(const BundleMgr *owner, int32 index, bool prefetch) {
+	// Prefer a free slot, otherwise recycle the least recently used one
+	Block *victim = &_blocks[0];
+	for (int i = 0; i < kNumBlocks; i++) {
+		if (!_blocks[i].owner) {
+			victim = &_blocks[i];
+			break;
+		}
+		if (_blocks[i].lastUse < victim->lastUse)
+			victim = &_blocks[i];
+	}
+
+	if (victim->owner)
+		_stats.evictions++;
+
+	if (prefetch)
+		_stats.prefetched++;
+	else
+		_stats.misses++;
+
+	victim->owner = owner;
+	victim->index = index;
+	victim->outputSize = 0;
+	victim->lastUse = ++_clock;
+	return victim;
+}
+
+void BundleBlockPool::invalidate(const BundleMgr *owner) {
+	for (int i = 0; i < kNumBlocks; i++) {
+		if (_blocks[i].owner == owner) {
+			_blocks[i].owner = nullptr;
+			_blocks[i].index = -1;
+			_blocks[i].lastUse = 0;
+		}
+	}
+}
+
+void BundleBlockPool::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache, BundleBlockPool *pool) {
 	_cache = cache;
+	_pool = pool;
 	_bundleTable = nullptr;
 	_compTable = nullptr;
 	_numFiles = 0;
@@ -202,6 +283,9 @@ bool BundleMgr::open(const char *filename, bool &isCompressed, bool errorFlag) {
 }
 
 void BundleMgr::close() {
+	if (_pool)
+		_pool->invalidate(this);
+
 	if (_file->isOpen()) {
 		_file->close();
 		_bundleTable = nullptr;
@@ -349,20 +433,7 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 		skip = (_curDecompressedFilePos + headerSize) % DIMUSE_BUN_CHUNK_SIZE; // Excess length after the last block
 
 		for (i = firstBlock; i <= lastBlock; i++) {
-			if (_lastBlock != i) {
-				// CMI hack: one more zero byte at the end of input buffer
-				_compInputBuff[_compTable[i].size] = 0;
-				_file->seek(_bundleTable[found->index].offset + _compTable[i].offset, SEEK_SET);
-				_file->read(_compInputBuff, _compTable[i].size);
-				_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-
-				if (_outputSize > DIMUSE_BUN_CHUNK_SIZE) {
-					error("_outputSize: %d", _outputSize);
-				}
-				_lastBlock = i;
-			}
-
-			outputSize = _outputSize;
+			const byte *blockData = getBlock(i, outputSize);
 
 			if (header_outside) {
 				outputSize -= skip;
@@ -379,7 +450,7 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 
 			assert(finalSize + outputSize <= blocksFinalSize);
 
-			memcpy(*comp_final + finalSize, _compOutputBuff + skip, outputSize);
+			memcpy(*comp_final + finalSize, blockData + skip, outputSize);
 			finalSize += outputSize;
 
 			size -= outputSize;
@@ -398,6 +469,63 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 	return final_size;
 }
 
+int32 BundleMgr::decompressBlock(int32 index, byte *dst) {
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[index].size] = 0;
+	_file->seek(_bundleTable[_curSampleId].offset + _compTable[index].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[index].size);
+	int32 outputSize = BundleCodecs::decompressCodec(_compTable[index].codec, _compInputBuff, dst, _compTable[index].size);
+
+	if (outputSize > DIMUSE_BUN_CHUNK_SIZE) {
+		error("_outputSize: %d", outputSize);
+	}
+
+	return outputSize;
+}
+
+const byte *BundleMgr::getBlock(int32 index, int32 &outputSize) {
+	if (!_pool) {
+		if (_lastBlock != index) {
+			_outputSize = decompressBlock(index, _compOutputBuff);
+			_lastBlock = index;
+		}
+
+		outputSize = _outputSize;
+		return _compOutputBuff;
+	}
+
+	BundleBlockPool::Block *block = _pool->get(this, index);
+	if (!block) {
+		block = _pool->claim(this, index, false);
+		block->outputSize = decompressBlock(index, block->data);
+	}
+
+	outputSize = block->outputSize;
+	return block->data;
+}
+
+int BundleMgr::readAhead(int numBlocks) {
+	// Decode the blocks following the current read position, so that the
+	// next readFile() calls only have to copy them out of the pool
+	if (!_pool || !_file->isOpen() || !_compTableLoaded || _isUncompressed || _curSampleId == -1)
+		return 0;
+
+	int firstBlock = _curDecompressedFilePos / DIMUSE_BUN_CHUNK_SIZE;
+	int lastBlock = MIN(firstBlock + numBlocks, _numCompItems) - 1;
+	int decoded = 0;
+
+	for (int i = firstBlock; i <= lastBlock; i++) {
+		if (_pool->contains(this, i))
+			continue;
+
+		BundleBlockPool::Block *block = _pool->claim(this, i, true);
+		block->outputSize = decompressBlock(i, block->data);
+		decoded++;
+	}
+
+	return decoded;
+}
+
 bool BundleMgr::isExtCompBun(byte gameId) {
 	bool isExtComp = false;
 	if (gameId == GID_CMI) {
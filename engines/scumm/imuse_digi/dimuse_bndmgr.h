@@ -29,6 +29,7 @@
 namespace Scumm {
 
 class BaseScummFile;
+class BundleMgr;
 
 class BundleDirCache {
 public:
@@ -65,6 +66,51 @@ public:
 	bool isSndDataExtComp(int slot);
 };
 
+/**
+ * A small pool of decompressed bundle blocks, shared by all the bundles
+ * opened by the sound manager. Blocks are decoded either on demand by
+ * BundleMgr::readFile() or ahead of time by BundleMgr::readAhead(); when
+ * the pool is full, the least recently used block is recycled.
+ */
+class BundleBlockPool {
+public:
+	enum {
+		kNumBlocks = 32
+	};
+
+	struct Block {
+		const BundleMgr *owner;
+		int32 index;
+		int32 outputSize;
+		uint32 lastUse;
+		byte *data;
+	};
+
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 prefetched;
+		uint32 evictions;
+	};
+
+	BundleBlockPool();
+	~BundleBlockPool();
+
+	Block *get(const BundleMgr *owner, int32 index);
+	bool contains(const BundleMgr *owner, int32 index) const;
+	Block *claim(const BundleMgr *owner, int32 index, bool prefetch);
+	void invalidate(const BundleMgr *owner);
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	Block _blocks[kNumBlocks];
+	byte *_buffer;
+	uint32 _clock;
+	Stats _stats;
+};
+
 class BundleMgr {
 
 private:
@@ -75,6 +121,7 @@ private:
 	};
 
 	BundleDirCache *_cache;
+	BundleBlockPool *_pool;
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable = nullptr;
 	CompTable *_compTable;
@@ -93,10 +140,12 @@ private:
 	int _outputSize = 0;
 	int _lastBlock = 0;
 	bool loadCompTable(int32 index);
+	int32 decompressBlock(int32 index, byte *dst);
+	const byte *getBlock(int32 index, int32 &outputSize);
 
 public:
 
-	BundleMgr(const ScummEngine *vm, BundleDirCache *_cache);
+	BundleMgr(const ScummEngine *vm, BundleDirCache *_cache, BundleBlockPool *pool = nullptr);
 	~BundleMgr();
 
 	bool open(const char *filename, bool &isCompressed, bool errorFlag = false);
@@ -104,6 +153,7 @@ public:
 	Common::SeekableReadStream *getFile(const char *filename, int32 &offset, int32 &size);
 	int32 seekFile(int32 offset, int size);
 	int32 readFile(const char *name, int32 size, byte **compFinal, bool headerOutside);
+	int readAhead(int numBlocks);
 	bool isExtCompBun(byte gameId);
 };
 
@@ -614,6 +614,9 @@ void IMuseDigital::dispatchProcessDispatches(IMuseDigiTrack *trackPtr, int feedS
 		if (dispatchPtr->streamPtr) {
 			srcBuf = streamerGetStreamBuffer(dispatchPtr->streamPtr, effRemainingAudio);
 			if (!srcBuf) {
+				if (!dispatchPtr->streamErrFlag)
+					_streamerUnderruns[dispatchPtr->streamPtr - _streams]++;
+
 				dispatchPtr->streamErrFlag = 1;
 				if (dispatchPtr->fadeBuf && dispatchPtr->fadeSyncFlag)
 					dispatchPtr->fadeSyncDelta += feedSize;
@@ -1141,4 +1141,39 @@ void IMuseDigital::listGroups() {
 	_vm->getDebugger()->debugPrintf("\tMUSICEFF: %3d\n\n", _groupsHandler->getGroupVol(DIMUSE_GROUP_MUSICEFF));
 }
 
+void IMuseDigital::listStreams() {
+	_vm->getDebugger()->debugPrintf("Streams:\n");
+	_vm->getDebugger()->debugPrintf("+----------------------------------------------------------+\n");
+	_vm->getDebugger()->debugPrintf("| # | soundId  | bufId | curOffset | endOffset | underruns |\n");
+	_vm->getDebugger()->debugPrintf("+---+----------+-------+-----------+-----------+-----------+\n");
+
+	for (int i = 0; i < DIMUSE_MAX_STREAMS; i++) {
+		IMuseDigiStream *curStream = &_streams[i];
+		if (curStream->soundId != 0) {
+			_vm->getDebugger()->debugPrintf("| %1d | %8d |   %d   | %9d | %9d | %9u |\n",
+				i, curStream->soundId, curStream->bufId, curStream->curOffset, curStream->endOffset, _streamerUnderruns[i]);
+		} else {
+			_vm->getDebugger()->debugPrintf("| %1d |   ---    |  ---  |    ---    |    ---    | %9u |\n", i, _streamerUnderruns[i]);
+		}
+	}
+	_vm->getDebugger()->debugPrintf("+---+----------+-------+-----------+-----------+-----------+\n\n");
+
+	if (!_isEarlyDiMUSE) {
+		const BundleBlockPool::Stats &stats = _filesHandler->getBlockPool()->getStats();
+		_vm->getDebugger()->debugPrintf("Bundle block pool (%d blocks):\n", (int)BundleBlockPool::kNumBlocks);
+		_vm->getDebugger()->debugPrintf("\tHits:       %u\n", stats.hits);
+		_vm->getDebugger()->debugPrintf("\tMisses:     %u\n", stats.misses);
+		_vm->getDebugger()->debugPrintf("\tPrefetched: %u\n", stats.prefetched);
+		_vm->getDebugger()->debugPrintf("\tEvictions:  %u\n\n", stats.evictions);
+	}
+}
+
+void IMuseDigital::resetStreamStats() {
+	Common::StackLock lock(*_mutex);
+	for (int i = 0; i < DIMUSE_MAX_STREAMS; i++)
+		_streamerUnderruns[i] = 0;
+
+	_filesHandler->getBlockPool()->resetStats();
+}
+
 } // End of namespace Scumm
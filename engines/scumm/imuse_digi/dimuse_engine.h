@@ -173,6 +173,7 @@ private:
 	IMuseDigiStream _streams[DIMUSE_MAX_STREAMS];
 	IMuseDigiStream *_lastStreamLoaded;
 	int _streamerBailFlag;
+	uint32 _streamerUnderruns[DIMUSE_MAX_STREAMS];
 
 	int streamerInit();
 	IMuseDigiStream *streamerAllocateSound(int soundId, int bufId, int32 maxRead);
@@ -187,6 +188,7 @@ private:
 	void streamerQueryStream(IMuseDigiStream *streamPtr, int32 &bufSize, int32 &criticalSize, int32 &freeSpace, int &paused);
 	int streamerFeedStream(IMuseDigiStream *streamPtr, uint8 *srcBuf, int32 sizeToFeed, int paused);
 	int streamerFetchData(IMuseDigiStream *streamPtr);
+	void streamerReadAhead();
 	void streamerSetLoopFlag(IMuseDigiStream *streamPtr, int offset);
 	void streamerRemoveLoopFlag(IMuseDigiStream *streamPtr);
 
@@ -439,6 +441,8 @@ public:
 	void listCues();
 	void listTracks();
 	void listGroups();
+	void listStreams();
+	void resetStreamStats();
 };
 
 } // End of namespace Scumm
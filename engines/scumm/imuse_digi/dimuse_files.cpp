@@ -256,6 +256,26 @@ int IMuseDigiFilesHandler::read(int soundId, uint8 *buf, int32 size, int bufId)
 	return 0;
 }
 
+int IMuseDigiFilesHandler::readAhead(int soundId, int numBlocks) {
+	// Only DIG and COMI stream their sounds out of compressed bundles
+	if (_engine->isEngineDisabled() || _engine->isFTSoundEngine() || soundId == 0)
+		return 0;
+
+	// A soundId > 10000 is a SAN cutscene
+	if ((_vm->_game.id == GID_DIG && !(_vm->_game.features & GF_DEMO)) && (soundId > kTalkSoundID))
+		return 0;
+
+	ImuseDigiSndMgr::SoundDesc *s = _sound->findSoundById(soundId);
+	if (!s || !s->inUse || s->scheduledForDealloc || !s->bundle)
+		return 0;
+
+	return s->bundle->readAhead(numBlocks);
+}
+
+BundleBlockPool *IMuseDigiFilesHandler::getBlockPool() {
+	return _sound->getBlockPool();
+}
+
 IMuseDigiSndBuffer *IMuseDigiFilesHandler::getBufInfo(int bufId) {
 	if (bufId > 0 && bufId <= 4) {
 		return &_soundBuffers[bufId];
@@ -57,6 +57,8 @@ public:
 	int getNextSound(int soundId);
 	int seek(int soundId, int32 offset, int mode, int bufId);
 	int read(int soundId, uint8 *buf, int32 size, int bufId);
+	int readAhead(int soundId, int numBlocks);
+	BundleBlockPool *getBlockPool();
 	IMuseDigiSndBuffer *getBufInfo(int bufId);
 	int openSound(int soundId);
 	void closeSound(int soundId);
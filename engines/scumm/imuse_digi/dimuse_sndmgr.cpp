@@ -44,6 +44,7 @@ ImuseDigiSndMgr::ImuseDigiSndMgr(ScummEngine *scumm) {
 	_disk = 0;
 	_cacheBundleDir = new BundleDirCache(scumm);
 	assert(_cacheBundleDir);
+	_blockPool = new BundleBlockPool();
 	BundleCodecs::initializeImcTables();
 }
 
@@ -53,6 +54,7 @@ ImuseDigiSndMgr::~ImuseDigiSndMgr() {
 	}
 
 	delete _cacheBundleDir;
+	delete _blockPool;
 	BundleCodecs::releaseImcTables();
 }
 
@@ -72,7 +74,7 @@ bool ImuseDigiSndMgr::openMusicBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 	bool compressed = false;
 
-	sound->bundle = new BundleMgr(_vm, _cacheBundleDir);
+	sound->bundle = new BundleMgr(_vm, _cacheBundleDir, _blockPool);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
@@ -108,7 +110,7 @@ bool ImuseDigiSndMgr::openVoiceBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 	bool compressed = false;
 
-	sound->bundle = new BundleMgr(_vm, _cacheBundleDir);
+	sound->bundle = new BundleMgr(_vm, _cacheBundleDir, _blockPool);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
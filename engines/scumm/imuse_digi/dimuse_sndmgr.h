@@ -38,6 +38,7 @@ namespace Scumm {
 class ScummEngine;
 class BundleMgr;
 class BundleDirCache;
+class BundleBlockPool;
 
 class ImuseDigiSndMgr {
 public:
@@ -74,6 +75,7 @@ private:
 	ScummEngine *_vm;
 	byte _disk;
 	BundleDirCache *_cacheBundleDir;
+	BundleBlockPool *_blockPool;
 
 	bool openMusicBundle(SoundDesc *sound, int &disk);
 	bool openVoiceBundle(SoundDesc *sound, int &disk);
@@ -88,6 +90,7 @@ public:
 	void closeSoundById(int soundId);
 	SoundDesc *findSoundById(int soundId);
 	SoundDesc *getSounds();
+	BundleBlockPool *getBlockPool() { return _blockPool; }
 	void scheduleSoundForDeallocation(int soundId);
 
 };
@@ -26,6 +26,7 @@ namespace Scumm {
 int IMuseDigital::streamerInit() {
 	for (int l = 0; l < DIMUSE_MAX_STREAMS; l++) {
 		_streams[l].soundId = 0;
+		_streamerUnderruns[l] = 0;
 	}
 	_lastStreamLoaded = nullptr;
 	return 0;
@@ -374,6 +375,33 @@ int IMuseDigital::streamerFetchData(IMuseDigiStream *streamPtr) {
 	return 0;
 }
 
+void IMuseDigital::streamerReadAhead() {
+	// FT and the DIG demo don't stream from compressed bundles
+	if (_isEarlyDiMUSE)
+		return;
+
+	int soundIds[DIMUSE_MAX_STREAMS];
+
+	// Take a snapshot of the streams which are still loading, then decode
+	// their upcoming bundle blocks without holding the mutex the audio
+	// callback is waiting on
+	_mutex->lock();
+	for (int l = 0; l < DIMUSE_MAX_STREAMS; l++) {
+		IMuseDigiStream *streamPtr = &_streams[l];
+		if (streamPtr->soundId && !streamPtr->paused && streamPtr->curOffset < streamPtr->endOffset) {
+			soundIds[l] = streamPtr->soundId;
+		} else {
+			soundIds[l] = 0;
+		}
+	}
+	_mutex->unlock();
+
+	for (int l = 0; l < DIMUSE_MAX_STREAMS; l++) {
+		if (soundIds[l])
+			_filesHandler->readAhead(soundIds[l], DIMUSE_READAHEAD_BLOCKS);
+	}
+}
+
 void IMuseDigital::streamerSetLoopFlag(IMuseDigiStream *streamPtr, int offset) {
 	streamPtr->vocLoopFlag = 1;
 	streamPtr->vocLoopTriggerOffset = offset;
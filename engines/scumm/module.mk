@@ -134,6 +134,7 @@ MODULE_OBJS += \
 	insane/insane_enemy.o \
 	insane/insane_scenes.o \
 	insane/insane_iact.o \
+	smush/blocks.o \
 	smush/codec1.o \
 	smush/codec20.o \
 	smush/codec37.o \
@@ -145,6 +146,15 @@ MODULE_OBJS += \
 	smush/codec47ARM.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	smush/blocksNEON.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	smush/blocksSSE2.o
+endif
+
 endif
 
 ifdef USE_ARM_GFX_ASM
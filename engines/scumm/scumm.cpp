@@ -24,6 +24,7 @@
 #include "common/debug-channels.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/profiler.h"
 #include "common/events.h"
 #include "common/str.h"
 #include "common/system.h"
@@ -2983,6 +2984,8 @@ void ScummEngine_v0::scummLoop(int delta) {
 }
 
 void ScummEngine::scummLoop(int delta) {
+	PROFILE_ZONE("ScummEngine::scummLoop");
+
 	// Notify the script about how much time has passed, in jiffies
 	if (VAR_TIMER != 0xFF)
 		VAR(VAR_TIMER) = delta;
@@ -3939,6 +3942,8 @@ void ScummEngine::scummLoop_handleDrawing() {
 	}
 
 	processDrawQue();
+
+	_gdi->getStripCache().endFrame();
 }
 
 #ifdef ENABLE_SCUMM_7_8
@@ -0,0 +1,96 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/system.h"
+#include "scumm/smush/blocks.h"
+
+namespace Scumm {
+
+static void copy8x8Generic(byte *dst, const byte *src, int pitch) {
+	for (int i = 0; i < 8; i++) {
+		memcpy(dst, src, 8);
+		dst += pitch;
+		src += pitch;
+	}
+}
+
+static void fill8x8Generic(byte *dst, byte color, int pitch) {
+	for (int i = 0; i < 8; i++) {
+		memset(dst, color, 8);
+		dst += pitch;
+	}
+}
+
+// Selects four pixels at a time between the two glyph colors
+static inline void glyphLine4(byte *dst, const byte *mask, uint32 fg, uint32 bg) {
+	uint32 m, px;
+	memcpy(&m, mask, 4);
+	px = (fg & m) | (bg & ~m);
+	memcpy(dst, &px, 4);
+}
+
+static void glyph8x8Generic(byte *dst, int pitch, const byte *mask, byte fg, byte bg) {
+	const uint32 f = fg * 0x01010101U;
+	const uint32 b = bg * 0x01010101U;
+	for (int i = 0; i < 8; i++) {
+		glyphLine4(dst, mask, f, b);
+		glyphLine4(dst + 4, mask + 4, f, b);
+		dst += pitch;
+		mask += 8;
+	}
+}
+
+static void glyph4x4Generic(byte *dst, int pitch, const byte *mask, byte fg, byte bg) {
+	const uint32 f = fg * 0x01010101U;
+	const uint32 b = bg * 0x01010101U;
+	for (int i = 0; i < 4; i++) {
+		glyphLine4(dst, mask, f, b);
+		dst += pitch;
+		mask += 4;
+	}
+}
+
+const SmushBlockKernels smushBlockKernelsGeneric = {
+	copy8x8Generic,
+	fill8x8Generic,
+	glyph8x8Generic,
+	glyph4x4Generic
+};
+
+const SmushBlockKernels *smushBlockKernels = nullptr;
+
+const SmushBlockKernels *getSmushBlockKernels() {
+	if (smushBlockKernels)
+		return smushBlockKernels;
+
+	smushBlockKernels = &smushBlockKernelsGeneric;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		smushBlockKernels = &smushBlockKernelsSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		smushBlockKernels = &smushBlockKernelsNEON;
+#endif
+	return smushBlockKernels;
+}
+
+} // End of namespace Scumm
@@ -0,0 +1,62 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCUMM_SMUSH_BLOCKS_H
+#define SCUMM_SMUSH_BLOCKS_H
+
+#include "common/scummsys.h"
+
+namespace Scumm {
+
+/**
+ * Block kernels used by the SMUSH codec 47 decoder for its 8x8 and 4x4
+ * blocks. All of them operate on 8-bit pixels, and the motion copy source
+ * is another frame buffer with the same pitch as the destination.
+ *
+ * The glyph kernels take a mask with one byte per pixel in row order:
+ * 0xFF selects the foreground color and 0x00 the background color.
+ */
+struct SmushBlockKernels {
+	void (*copy8x8)(byte *dst, const byte *src, int pitch);
+	void (*fill8x8)(byte *dst, byte color, int pitch);
+	void (*glyph8x8)(byte *dst, int pitch, const byte *mask, byte fg, byte bg);
+	void (*glyph4x4)(byte *dst, int pitch, const byte *mask, byte fg, byte bg);
+};
+
+/**
+ * The kernels used by the SMUSH decoders. They are picked based on the CPU
+ * features on first use, unless they have been set before.
+ */
+extern const SmushBlockKernels *smushBlockKernels;
+
+const SmushBlockKernels *getSmushBlockKernels();
+
+extern const SmushBlockKernels smushBlockKernelsGeneric;
+#ifdef SCUMMVM_NEON
+extern const SmushBlockKernels smushBlockKernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+extern const SmushBlockKernels smushBlockKernelsSSE2;
+#endif
+
+} // End of namespace Scumm
+
+#endif
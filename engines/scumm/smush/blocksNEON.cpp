@@ -0,0 +1,103 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "scumm/smush/blocks.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Scumm {
+
+static void copy8x8NEON(byte *dst, const byte *src, int pitch) {
+	for (int i = 0; i < 8; i++) {
+		vst1_u8(dst, vld1_u8(src));
+		dst += pitch;
+		src += pitch;
+	}
+}
+
+static void fill8x8NEON(byte *dst, byte color, int pitch) {
+	const uint8x8_t c = vdup_n_u8(color);
+	for (int i = 0; i < 8; i++) {
+		vst1_u8(dst, c);
+		dst += pitch;
+	}
+}
+
+static void glyph8x8NEON(byte *dst, int pitch, const byte *mask, byte fg, byte bg) {
+	const uint8x16_t f = vdupq_n_u8(fg);
+	const uint8x16_t b = vdupq_n_u8(bg);
+
+	// Each 16 byte mask covers two rows
+	for (int i = 0; i < 4; i++) {
+		const uint8x16_t px = vbslq_u8(vld1q_u8(mask), f, b);
+		vst1_u8(dst, vget_low_u8(px));
+		vst1_u8(dst + pitch, vget_high_u8(px));
+		dst += pitch * 2;
+		mask += 16;
+	}
+}
+
+static void glyph4x4NEON(byte *dst, int pitch, const byte *mask, byte fg, byte bg) {
+	const uint32x4_t px = vreinterpretq_u32_u8(vbslq_u8(vld1q_u8(mask), vdupq_n_u8(fg), vdupq_n_u8(bg)));
+	uint32 rows[4];
+
+	vst1q_u32(rows, px);
+	for (int i = 0; i < 4; i++) {
+		memcpy(dst, &rows[i], 4);
+		dst += pitch;
+	}
+}
+
+const SmushBlockKernels smushBlockKernelsNEON = {
+	copy8x8NEON,
+	fill8x8NEON,
+	glyph8x8NEON,
+	glyph4x4NEON
+};
+
+} // End of namespace Scumm
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include "scumm/smush/blocks.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Scumm {
+
+static void copy8x8SSE2(byte *dst, const byte *src, int pitch) {
+	for (int i = 0; i < 8; i++) {
+		_mm_storel_epi64((__m128i *)dst, _mm_loadl_epi64((const __m128i *)src));
+		dst += pitch;
+		src += pitch;
+	}
+}
+
+static void fill8x8SSE2(byte *dst, byte color, int pitch) {
+	const __m128i c = _mm_set1_epi8((char)color);
+	for (int i = 0; i < 8; i++) {
+		_mm_storel_epi64((__m128i *)dst, c);
+		dst += pitch;
+	}
+}
+
+static FORCEINLINE __m128i select(const byte *mask, __m128i fg, __m128i bg) {
+	const __m128i m = _mm_loadu_si128((const __m128i *)mask);
+	return _mm_or_si128(_mm_and_si128(m, fg), _mm_andnot_si128(m, bg));
+}
+
+static void glyph8x8SSE2(byte *dst, int pitch, const byte *mask, byte fg, byte bg) {
+	const __m128i f = _mm_set1_epi8((char)fg);
+	const __m128i b = _mm_set1_epi8((char)bg);
+
+	// Each 16 byte mask covers two rows
+	for (int i = 0; i < 4; i++) {
+		const __m128i px = select(mask, f, b);
+		_mm_storel_epi64((__m128i *)dst, px);
+		_mm_storel_epi64((__m128i *)(dst + pitch), _mm_unpackhi_epi64(px, px));
+		dst += pitch * 2;
+		mask += 16;
+	}
+}
+
+static void glyph4x4SSE2(byte *dst, int pitch, const byte *mask, byte fg, byte bg) {
+	__m128i px = select(mask, _mm_set1_epi8((char)fg), _mm_set1_epi8((char)bg));
+
+	for (int i = 0; i < 4; i++) {
+		const uint32 row = (uint32)_mm_cvtsi128_si32(px);
+		memcpy(dst, &row, 4);
+		px = _mm_srli_si128(px, 4);
+		dst += pitch;
+	}
+}
+
+const SmushBlockKernels smushBlockKernelsSSE2 = {
+	copy8x8SSE2,
+	fill8x8SSE2,
+	glyph8x8SSE2,
+	glyph4x4SSE2
+};
+
+} // End of namespace Scumm
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // SCUMMVM_SSE2
@@ -366,6 +366,15 @@ void SmushDeltaBlocksDecoder::makeTable(int pitch, int index) {
 		dst += 4;                                             \
 	} while (0)
 
+/* Copy a run of unchanged 4x4 pixel blocks on the same block row from the other buffer */
+
+static inline void copyBlockRun(byte *dst, int32 nextOffs, int32 count, int pitch) {
+	for (int y = 0; y < 4; y++) {
+		memcpy(dst, dst + nextOffs, count * 4);
+		dst += pitch;
+	}
+}
+
 void SmushDeltaBlocksDecoder::proc1(byte *dst, const byte *src, int32 nextOffs, int bw, int bh, int pitch, int16 *offsetTable) {
 	uint8 code;
 	bool filling, skipCode;
@@ -480,10 +489,12 @@ void SmushDeltaBlocksDecoder::proc4WithFDFE(byte *dst, const byte *src, int32 ne
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + nextOffs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
+				while (length > 0) {
+					int32 n = MIN(length, i);
+					copyBlockRun(dst, nextOffs, n, pitch);
+					dst += n * 4;
+					length -= n;
+					i -= n;
 					if (i == 0) {
 						dst += pitch * 3;
 						bh--;
@@ -512,10 +523,12 @@ void SmushDeltaBlocksDecoder::proc4WithoutFDFE(byte *dst, const byte *src, int32
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + nextOffs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
+				while (length > 0) {
+					int32 n = MIN(length, i);
+					copyBlockRun(dst, nextOffs, n, pitch);
+					dst += n * 4;
+					length -= n;
+					i -= n;
 					if (i == 0) {
 						dst += pitch * 3;
 						bh--;
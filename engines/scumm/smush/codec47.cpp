@@ -24,6 +24,7 @@
 #include "common/textconsole.h"
 #include "common/util.h"
 #include "scumm/bomp.h"
+#include "scumm/smush/blocks.h"
 #include "scumm/smush/codec47.h"
 
 namespace Scumm {
@@ -302,6 +303,24 @@ void SmushDeltaGlyphsDecoder::makeTablesInterpolation(int sideLength) {
 	}
 }
 
+void SmushDeltaGlyphsDecoder::makeGlyphMasks() {
+	// The two pixel lists of each glyph are disjoint and cover the whole
+	// block, so a glyph can be drawn as a select between its two colors.
+	for (int i = 0; i < NGLYPHS; i++) {
+		const byte *big = _tableBig + i * 388;
+		byte *mask = _glyphMasksBig + i * 64;
+		memset(mask, 0, 64);
+		for (int j = 0; j < big[384]; j++)
+			mask[big[256 + j]] = 0xFF;
+
+		const byte *small = _tableSmall + i * 128;
+		mask = _glyphMasksSmall + i * 16;
+		memset(mask, 0, 16);
+		for (int j = 0; j < small[96]; j++)
+			mask[small[64 + j]] = 0xFF;
+	}
+}
+
 void SmushDeltaGlyphsDecoder::makeCodecTables(int width) {
 	if (_lastTableWidth == width)
 		return;
@@ -425,21 +444,9 @@ void SmushDeltaGlyphsDecoder::level2(byte *d_dst) {
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
-		byte *tmpPtr = _tableSmall + *_dSrc++ * 128;
-		int32 l = tmpPtr[96];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[97];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 32);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
+		const byte *mask = _glyphMasksSmall + _dSrc[0] * 16;
+		_kernels->glyph4x4(d_dst, _dPitch, mask, _dSrc[1], _dSrc[2]);
+		_dSrc += 3;
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
 		for (i = 0; i < 4; i++) {
@@ -458,15 +465,10 @@ void SmushDeltaGlyphsDecoder::level2(byte *d_dst) {
 void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	int32 tmp;
 	byte code = *_dSrc++;
-	int i;
 
 	if (code < MOTION_OFFSET_TABLE_SIZE) {
 		tmp = _table[code] + _offset1;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
-			d_dst += _dPitch;
-		}
+		_kernels->copy8x8(d_dst, d_dst + tmp, _dPitch);
 	} else if (code == PROCESS_SUBBLOCKS) {
 		level2(d_dst);
 		d_dst += 4;
@@ -476,43 +478,15 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 		d_dst += 4;
 		level2(d_dst);
 	} else if (code == FILL_SINGLE_COLOR) {
-		byte t = *_dSrc++;
-		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
-			d_dst += _dPitch;
-		}
+		_kernels->fill8x8(d_dst, *_dSrc++, _dPitch);
 	} else if (code == DRAW_GLYPH) {
-		tmp = *_dSrc++;
-		byte *tmpPtr = _tableBig + tmp * 388;
-		byte l = tmpPtr[384];
-		byte val = *_dSrc++;
-		int16 *tmpPtr2 = (int16 *)tmpPtr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
-		l = tmpPtr[385];
-		val = *_dSrc++;
-		tmpPtr2 = (int16 *)(tmpPtr + 128);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmpPtr2)) = val;
-			tmpPtr2++;
-		}
+		const byte *mask = _glyphMasksBig + _dSrc[0] * 64;
+		_kernels->glyph8x8(d_dst, _dPitch, mask, _dSrc[1], _dSrc[2]);
+		_dSrc += 3;
 	} else if (code == COPY_PREV_BUFFER) {
-		tmp = _offset2;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
-			d_dst += _dPitch;
-		}
+		_kernels->copy8x8(d_dst, d_dst + _offset2, _dPitch);
 	} else {
-		byte t = _paramPtr[code];
-		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
-			d_dst += _dPitch;
-		}
+		_kernels->fill8x8(d_dst, _paramPtr[code], _dPitch);
 	}
 }
 
@@ -535,15 +509,19 @@ void SmushDeltaGlyphsDecoder::decode2(byte *dst, const byte *src, int width, int
 }
 #endif
 
-SmushDeltaGlyphsDecoder::SmushDeltaGlyphsDecoder(int width, int height) : _prevSeqNb(0), _dSrc(nullptr), _paramPtr(nullptr), _dPitch(0), _offset1(0), _offset2(0) {
+SmushDeltaGlyphsDecoder::SmushDeltaGlyphsDecoder(int width, int height) : _prevSeqNb(0), _dSrc(nullptr), _paramPtr(nullptr), _dPitch(0), _offset1(0), _offset2(0), _kernels(nullptr) {
 	_lastTableWidth = -1;
 	_width = width;
 	_height = height;
 	_tableBig = (byte *)malloc(NGLYPHS * 388);
 	_tableSmall = (byte *)malloc(NGLYPHS * 128);
+	_glyphMasksBig = (byte *)malloc(NGLYPHS * 64);
+	_glyphMasksSmall = (byte *)malloc(NGLYPHS * 16);
 	if ((_tableBig != nullptr) && (_tableSmall != nullptr)) {
 		makeTablesInterpolation(4);
 		makeTablesInterpolation(8);
+		if ((_glyphMasksBig != nullptr) && (_glyphMasksSmall != nullptr))
+			makeGlyphMasks();
 	}
 
 	_frameSize = _width * _height;
@@ -563,6 +541,10 @@ SmushDeltaGlyphsDecoder::~SmushDeltaGlyphsDecoder() {
 		free(_tableSmall);
 		_tableSmall = nullptr;
 	}
+	free(_glyphMasksBig);
+	_glyphMasksBig = nullptr;
+	free(_glyphMasksSmall);
+	_glyphMasksSmall = nullptr;
 	_lastTableWidth = -1;
 	if (_deltaBuf) {
 		free(_deltaBuf);
@@ -576,6 +558,10 @@ SmushDeltaGlyphsDecoder::~SmushDeltaGlyphsDecoder() {
 bool SmushDeltaGlyphsDecoder::decode(byte *dst, const byte *src) {
 	if ((_tableBig == nullptr) || (_tableSmall == nullptr) || (_deltaBuf == nullptr))
 		return false;
+	if ((_glyphMasksBig == nullptr) || (_glyphMasksSmall == nullptr))
+		return false;
+
+	_kernels = getSmushBlockKernels();
 
 	_offset1 = _deltaBufs[1] - _curBuf;
 	_offset2 = _deltaBufs[0] - _curBuf;
@@ -26,6 +26,8 @@
 
 namespace Scumm {
 
+struct SmushBlockKernels;
+
 class SmushDeltaGlyphsDecoder {
 private:
 
@@ -40,11 +42,15 @@ private:
 	int32 _offset1, _offset2;
 	byte *_tableBig;
 	byte *_tableSmall;
+	byte *_glyphMasksBig;
+	byte *_glyphMasksSmall;
+	const SmushBlockKernels *_kernels;
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
 
 	void makeTablesInterpolation(int param);
+	void makeGlyphMasks();
 	void makeCodecTables(int width);
 	void level1(byte *d_dst);
 	void level2(byte *d_dst);
@@ -25,6 +25,7 @@
 #include "common/events.h"
 #include "common/memstream.h"
 #include "common/keyboard.h"
+#include "common/profiler.h"
 #include "common/fs.h"
 #include "common/config-manager.h"
 #include "common/serializer.h"
@@ -1160,6 +1161,8 @@ Common::Error TinselEngine::run() {
 
 
 void TinselEngine::NextGameCycle() {
+	PROFILE_ZONE("TinselEngine::NextGameCycle");
+
 	// Dim Music
 	_pcmMusic->dimIteration();
 
@@ -288,6 +288,46 @@ bool scaleBlitBilinear(byte *dst, const byte *src,
 					   const Graphics::PixelFormat &fmt,
 					   const byte flip = 0);
 
+/**
+ * Downscale an image by averaging every source pixel covered by each
+ * destination pixel (box filter). Unlike scaleBlitBilinear(), no source
+ * pixels are skipped, which avoids aliasing on large reduction factors
+ * such as thumbnail generation.
+ *
+ * Only 2 and 4 bytes per pixel are supported.
+ *
+ * @return false if the format is unsupported or either dimension would
+ *         be enlarged.
+ */
+bool scaleBlitBox(byte *dst, const byte *src,
+				  const uint dstPitch, const uint srcPitch,
+				  const uint dstW, const uint dstH,
+				  const uint srcW, const uint srcH,
+				  const Graphics::PixelFormat &fmt);
+
+/**
+ * Add @p count bytes from @p src to the matching entries of @p acc.
+ * This is the inner loop of scaleBlitBox().
+ */
+typedef void (*BoxAccumulateFunc)(uint32 *acc, const byte *src, const uint count);
+
+/**
+ * The kernel used by scaleBlitBox(). It is picked based on the CPU features
+ * on first use, unless it has been set before.
+ */
+extern BoxAccumulateFunc boxAccumulateFunc;
+
+void boxAccumulateGeneric(uint32 *acc, const byte *src, const uint count);
+#ifdef SCUMMVM_NEON
+void boxAccumulateNEON(uint32 *acc, const byte *src, const uint count);
+#endif
+#ifdef SCUMMVM_SSE2
+void boxAccumulateSSE2(uint32 *acc, const byte *src, const uint count);
+#endif
+#ifdef SCUMMVM_AVX2
+void boxAccumulateAVX2(uint32 *acc, const byte *src, const uint count);
+#endif
+
 bool rotoscaleBlit(byte *dst, const byte *src,
 				   const uint dstPitch, const uint srcPitch,
 				   const uint dstW, const uint dstH,
@@ -321,6 +321,17 @@ void BlendBlit::blitAVX2(Args &args, const TSpriteBlendMode &blendMode, const Al
 	blitT<BlendBlitImpl_AVX2>(args, blendMode, alphaType);
 }
 
+void boxAccumulateAVX2(uint32 *acc, const byte *src, const uint count) {
+	uint i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256i s = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+		__m256i *a = (__m256i *)(acc + i);
+		_mm256_storeu_si256(a, _mm256_add_epi32(_mm256_loadu_si256(a), s));
+	}
+	for (; i < count; i++)
+		acc[i] += src[i];
+}
+
 } // End of namespace Graphics
 
 #if defined(__clang__)
@@ -376,6 +376,21 @@ void fastBlitNEON_XRGB1555_RGB565(byte *dst, const byte *src,
 	}
 }
 
+void boxAccumulateNEON(uint32 *acc, const byte *src, const uint count) {
+	uint i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const uint8x16_t s = vld1q_u8(src + i);
+		const uint16x8_t lo = vmovl_u8(vget_low_u8(s));
+		const uint16x8_t hi = vmovl_u8(vget_high_u8(s));
+		vst1q_u32(acc + i + 0,  vaddw_u16(vld1q_u32(acc + i + 0),  vget_low_u16(lo)));
+		vst1q_u32(acc + i + 4,  vaddw_u16(vld1q_u32(acc + i + 4),  vget_high_u16(lo)));
+		vst1q_u32(acc + i + 8,  vaddw_u16(vld1q_u32(acc + i + 8),  vget_low_u16(hi)));
+		vst1q_u32(acc + i + 12, vaddw_u16(vld1q_u32(acc + i + 12), vget_high_u16(hi)));
+	}
+	for (; i < count; i++)
+		acc[i] += src[i];
+}
+
 } // end of namespace Graphics
 
 #if !defined(__aarch64__) && !defined(__ARM_NEON)
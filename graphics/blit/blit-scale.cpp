@@ -30,6 +30,7 @@
 
 #include "common/endian.h"
 #include "common/rect.h"
+#include "common/system.h"
 #include "math/utils.h"
 
 namespace Graphics {
@@ -138,6 +139,126 @@ bool scaleBlit(byte *dst, const byte *src,
 	return false;
 }
 
+BoxAccumulateFunc boxAccumulateFunc = nullptr;
+
+void boxAccumulateGeneric(uint32 *acc, const byte *src, const uint count) {
+	for (uint i = 0; i < count; i++)
+		acc[i] += src[i];
+}
+
+namespace {
+
+static BoxAccumulateFunc getBoxAccumulateFunc() {
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		return boxAccumulateAVX2;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return boxAccumulateSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return boxAccumulateNEON;
+#endif
+	return boxAccumulateGeneric;
+}
+
+/**
+ * Formats whose channels each occupy a full byte can be averaged byte by
+ * byte without unpacking. An unused padding byte is averaged as well, which
+ * is harmless.
+ */
+static bool hasByteLanes(const Graphics::PixelFormat &fmt) {
+	if (fmt.bytesPerPixel != 4)
+		return false;
+	if (fmt.rLoss || fmt.gLoss || fmt.bLoss)
+		return false;
+	if (fmt.aLoss != 0 && fmt.aLoss != 8)
+		return false;
+	return !(fmt.rShift & 7) && !(fmt.gShift & 7) && !(fmt.bShift & 7) && !(fmt.aShift & 7);
+}
+
+template<typename Color>
+static void unpackRow(byte *dst, const byte *src, const uint w, const Graphics::PixelFormat &fmt) {
+	const Color *s = (const Color *)src;
+	for (uint x = 0; x < w; x++, dst += 4)
+		fmt.colorToARGB(s[x], dst[0], dst[1], dst[2], dst[3]);
+}
+
+template<typename Color>
+static void packPixel(byte *dst, const byte *argb, const Graphics::PixelFormat &fmt) {
+	*(Color *)dst = fmt.ARGBToColor(argb[0], argb[1], argb[2], argb[3]);
+}
+
+} // End of anonymous namespace
+
+bool scaleBlitBox(byte *dst, const byte *src,
+				  const uint dstPitch, const uint srcPitch,
+				  const uint dstW, const uint dstH,
+				  const uint srcW, const uint srcH,
+				  const Graphics::PixelFormat &fmt) {
+	if (!dstW || !dstH || dstW > srcW || dstH > srcH)
+		return false;
+	if (fmt.bytesPerPixel != 2 && fmt.bytesPerPixel != 4)
+		return false;
+
+	if (!boxAccumulateFunc)
+		boxAccumulateFunc = getBoxAccumulateFunc();
+
+	const bool byteLanes = hasByteLanes(fmt);
+	const uint lanes = srcW * 4;
+
+	// Column sums for the current destination row, four lanes per pixel
+	uint32 *acc = new uint32[lanes];
+	byte *unpacked = byteLanes ? nullptr : new byte[lanes];
+
+	for (uint y = 0; y < dstH; y++) {
+		const uint y0 = y * srcH / dstH;
+		const uint y1 = (y + 1) * srcH / dstH;
+
+		memset(acc, 0, lanes * sizeof(uint32));
+		for (uint sy = y0; sy < y1; sy++) {
+			const byte *row = src + sy * srcPitch;
+			if (!byteLanes) {
+				if (fmt.bytesPerPixel == 2)
+					unpackRow<uint16>(unpacked, row, srcW, fmt);
+				else
+					unpackRow<uint32>(unpacked, row, srcW, fmt);
+				row = unpacked;
+			}
+			boxAccumulateFunc(acc, row, lanes);
+		}
+
+		byte *dstP = dst + y * dstPitch;
+		for (uint x = 0; x < dstW; x++) {
+			const uint x0 = x * srcW / dstW;
+			const uint x1 = (x + 1) * srcW / dstW;
+			const uint32 area = (x1 - x0) * (y1 - y0);
+
+			byte avg[4];
+			for (uint l = 0; l < 4; l++) {
+				uint32 sum = 0;
+				for (uint sx = x0; sx < x1; sx++)
+					sum += acc[sx * 4 + l];
+				avg[l] = (sum + area / 2) / area;
+			}
+
+			if (byteLanes)
+				memcpy(dstP, avg, 4);
+			else if (fmt.bytesPerPixel == 2)
+				packPixel<uint16>(dstP, avg, fmt);
+			else
+				packPixel<uint32>(dstP, avg, fmt);
+			dstP += fmt.bytesPerPixel;
+		}
+	}
+
+	delete[] unpacked;
+	delete[] acc;
+	return true;
+}
+
 /*
 
 The functions below are adapted from SDL_rotozoom.c,
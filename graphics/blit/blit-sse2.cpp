@@ -326,6 +326,23 @@ void BlendBlit::blitSSE2(Args &args, const TSpriteBlendMode &blendMode, const Al
 	blitT<BlendBlitImpl_SSE2>(args, blendMode, alphaType);
 }
 
+void boxAccumulateSSE2(uint32 *acc, const byte *src, const uint count) {
+	const __m128i zero = _mm_setzero_si128();
+	uint i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+		const __m128i lo = _mm_unpacklo_epi8(s, zero);
+		const __m128i hi = _mm_unpackhi_epi8(s, zero);
+		__m128i *a = (__m128i *)(acc + i);
+		_mm_storeu_si128(a + 0, _mm_add_epi32(_mm_loadu_si128(a + 0), _mm_unpacklo_epi16(lo, zero)));
+		_mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), _mm_unpackhi_epi16(lo, zero)));
+		_mm_storeu_si128(a + 2, _mm_add_epi32(_mm_loadu_si128(a + 2), _mm_unpacklo_epi16(hi, zero)));
+		_mm_storeu_si128(a + 3, _mm_add_epi32(_mm_loadu_si128(a + 3), _mm_unpackhi_epi16(hi, zero)));
+	}
+	for (; i < count; i++)
+		acc[i] += src[i];
+}
+
 } // End of namespace Graphics
 
 #if !defined(__x86_64__)
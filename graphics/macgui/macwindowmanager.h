@@ -358,6 +358,7 @@ public:
 	byte inverter(byte src);
 
 	const byte *getPalette() { return _palette; }
+	PaletteLookup *getPaletteLookup() { return &_paletteLookup; }
 	uint getPaletteSize() { return _paletteSize; }
 
 	void renderZoomBox(bool redraw = false);
@@ -23,6 +23,7 @@
 #include "common/scummsys.h"
 #include "common/system.h"
 
+#include "graphics/blit.h"
 #include "graphics/colormasks.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
@@ -77,6 +78,26 @@ void createThumbnail_4(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32
 
 template<typename ColorMask>
 static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
+	if (in.w >= out.w || in.h >= out.h) {
+		// Average every input pixel into the aspect correct target rectangle.
+		// This only fails when the input would need to be enlarged.
+		int targetWidth = out.w, targetHeight = out.h;
+
+		const float inputAspect = (float)in.w / in.h;
+		const float outputAspect = (float)out.w / out.h;
+
+		if (inputAspect > outputAspect) {
+			targetHeight = MAX(1, int(targetWidth / inputAspect));
+		} else if (inputAspect < outputAspect) {
+			targetWidth = MAX(1, int(targetHeight * inputAspect));
+		}
+
+		byte *dst = (byte *)out.getBasePtr((out.w - targetWidth) / 2, (out.h - targetHeight) / 2);
+		if (Graphics::scaleBlitBox(dst, (const byte *)in.getPixels(), out.pitch, in.pitch,
+		                           targetWidth, targetHeight, in.w, in.h, in.format))
+			return;
+	}
+
 	while (in.w / out.w >= 4 || in.h / out.h >= 4) {
 		createThumbnail_4<ColorMask>((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
 		in.w /= 4;
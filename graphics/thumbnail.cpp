@@ -20,6 +20,7 @@
  */
 
 #include "graphics/thumbnail.h"
+#include "graphics/blit.h"
 #include "graphics/scaler.h"
 #include "graphics/pixelformat.h"
 #include "common/endian.h"
@@ -311,6 +312,12 @@ Graphics::Surface *scale(const Graphics::Surface &srcImage, int xSize, int ySize
 	Graphics::Surface *s = new Graphics::Surface();
 	s->create(xSize, ySize, srcImage.format);
 
+	// Average the source pixels when shrinking, so thin lines and text in
+	// the source do not drop out of the scaled image
+	if (scaleBlitBox((byte *)s->getPixels(), (const byte *)srcImage.getPixels(),
+	                 s->pitch, srcImage.pitch, xSize, ySize, srcImage.w, srcImage.h, srcImage.format))
+		return s;
+
 	int *horizUsage = scaleLine(xSize, srcImage.w);
 	int *vertUsage = scaleLine(ySize, srcImage.h);
 
@@ -355,8 +355,8 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	color_mask_red = color_mask_green = color_mask_blue = color_mask_alpha = true;
 
 	_currentAllocatorIndex = 0;
-	_drawCallAllocator[0].initialize(drawCallMemorySize);
-	_drawCallAllocator[1].initialize(drawCallMemorySize);
+	_drawCallAllocator[0] = new Common::Arena(drawCallMemorySize);
+	_drawCallAllocator[1] = new Common::Arena(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
 }
@@ -372,6 +372,8 @@ void GLContext::deinit() {
 	endSharedState();
 	gl_free(vertex);
 	delete fb;
+	delete _drawCallAllocator[0];
+	delete _drawCallAllocator[1];
 }
 
 } // end of namespace TinyGL
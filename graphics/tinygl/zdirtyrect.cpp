@@ -246,7 +246,7 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 	disposeResources();
 
 	_currentAllocatorIndex = (_currentAllocatorIndex + 1) & 0x1;
-	_drawCallAllocator[_currentAllocatorIndex].reset();
+	_drawCallAllocator[_currentAllocatorIndex]->reset();
 }
 
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
@@ -261,7 +261,7 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 	disposeResources();
 
-	_drawCallAllocator[_currentAllocatorIndex].reset();
+	_drawCallAllocator[_currentAllocatorIndex]->reset();
 }
 
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
@@ -817,7 +817,7 @@ bool RasterizationDrawCall::RasterizationState::operator==(const RasterizationSt
 
 void *Internal::allocateFrame(int size) {
 	GLContext *c = gl_get_context();
-	return c->_drawCallAllocator[c->_currentAllocatorIndex].allocate(size);
+	return c->_drawCallAllocator[c->_currentAllocatorIndex]->allocate(size);
 }
 
 } // end of namespace TinyGL
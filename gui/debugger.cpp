@@ -22,14 +22,15 @@
 // NB: This is really only necessary if USE_READLINE is defined
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
+#include "common/archive.h"
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
-#include "common/archive.h"
 #include "common/macresman.h"
 #include "common/stream.h"
 #endif
@@ -78,6 +79,10 @@ Debugger::Debugger() {
 	registerCmd("exec",				WRAP_METHOD(Debugger, cmdExecFile));
 
 	registerCmd("debuglevel",		WRAP_METHOD(Debugger, cmdDebugLevel));
+	registerCmd("archivecache",		WRAP_METHOD(Debugger, cmdArchiveCache));
+#ifdef USE_ZONE_PROFILER
+	registerCmd("profiler",			WRAP_METHOD(Debugger, cmdProfiler));
+#endif
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
@@ -777,6 +782,65 @@ bool Debugger::cmdDebugLevel(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdArchiveCache(int argc, const char **argv) {
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		Common::MemcachingCaseInsensitiveArchive::resetCacheStats();
+		debugPrintf("Archive cache statistics reset\n");
+		return true;
+	}
+
+	Common::ArchiveCacheStats stats = Common::MemcachingCaseInsensitiveArchive::getCacheStats();
+	uint32 lookups = stats.hits + stats.misses;
+
+	debugPrintf("Archive cache: %u entries (%u pinned), %u of %u KB used\n", stats.entries, stats.pinned,
+	            (uint32)(stats.bytesUsed / 1024), (uint32)(stats.budget / 1024));
+	debugPrintf("Hits: %u, misses: %u (%u%% hit rate), evictions: %u\n", stats.hits, stats.misses,
+	            lookups ? stats.hits * 100 / lookups : 0, stats.evictions);
+	debugPrintf("Usage: %s [reset]\n", argv[0]);
+	return true;
+}
+
+#ifdef USE_ZONE_PROFILER
+bool Debugger::cmdProfiler(int argc, const char **argv) {
+	Common::ZoneProfiler &profiler = Common::ZoneProfiler::instance();
+
+	if (argc > 1 && !strcmp(argv[1], "start")) {
+		profiler.startCapture();
+		debugPrintf("Profiler capture started\n");
+	} else if (argc > 1 && !strcmp(argv[1], "stop")) {
+		profiler.stopCapture();
+		debugPrintf("Profiler capture stopped, %u events\n", profiler.getCapturedEventCount());
+	} else if (argc > 2 && !strcmp(argv[1], "trace")) {
+		Common::DumpFile out;
+		if (!out.open(Common::Path(argv[2], Common::Path::kNativeSeparator)) || !profiler.writeChromeTrace(out)) {
+			debugPrintf("Could not write %s\n", argv[2]);
+			return true;
+		}
+		debugPrintf("Wrote %u events to %s\n", profiler.getCapturedEventCount(), argv[2]);
+	} else if (argc > 1 && !strcmp(argv[1], "reset")) {
+		profiler.resetStats();
+		debugPrintf("Profiler statistics reset\n");
+	} else if (argc > 1) {
+		debugPrintf("Usage: %s [start|stop|trace <file>|reset]\n", argv[0]);
+	} else {
+		// Work on a copy, the zones keep being updated by the other threads
+		Common::Array<Common::ProfileZoneInfo> zones;
+		Common::Array<Common::ProfileCounterInfo> counters;
+		profiler.getStats(zones, counters);
+
+		debugPrintf("%u frames, last frame %.3f ms\n", profiler.getFrameCount(), profiler.getLastFrameNanos() / 1000000.0);
+		debugPrintf("%-32s %8s %10s %10s %10s %10s\n", "Zone", "Calls", "Total ms", "Max ms", "Frame #", "Frame ms");
+		for (const Common::ProfileZoneInfo &zone : zones) {
+			debugPrintf("%-32s %8u %10.3f %10.3f %10u %10.3f\n", zone.name, zone.calls, zone.totalNanos / 1000000.0,
+			            zone.maxNanos / 1000000.0, zone.lastFrameCalls, zone.lastFrameNanos / 1000000.0);
+		}
+		for (const Common::ProfileCounterInfo &counter : counters)
+			debugPrintf("%-32s %lld\n", counter.name, (long long)counter.value);
+	}
+	return true;
+}
+#endif
+
 bool Debugger::cmdDebugFlagsList(int argc, const char **argv) {
 	const Common::DebugManager::DebugChannelList &debugLevels = DebugMan.getDebugChannels();
 
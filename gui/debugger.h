@@ -272,6 +272,10 @@ protected:
 	bool cmdMd5Mac(int argc, const char **argv);
 #endif
 	bool cmdDebugLevel(int argc, const char **argv);
+	bool cmdArchiveCache(int argc, const char **argv);
+#ifdef USE_ZONE_PROFILER
+	bool cmdProfiler(int argc, const char **argv);
+#endif
 	bool cmdDebugFlagsList(int argc, const char **argv);
 	bool cmdDebugFlagEnable(int argc, const char **argv);
 	bool cmdDebugFlagDisable(int argc, const char **argv);
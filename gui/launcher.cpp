@@ -1794,6 +1794,8 @@ void LauncherGrid::build() {
 	// Add list with game titles
 	_grid = new GridWidget(this, "LauncherGrid.IconArea");
 	_grid->setMultiSelectEnabled(true);
+	// Let the grid load its thumbnails even when it does not have focus
+	setTickleWidget(_grid);
 	// Populate the list
 	updateListing();
 
@@ -32,6 +32,7 @@ MODULE_OBJS := \
 	ThemeEval.o \
 	ThemeLayout.o \
 	ThemeParser.o \
+	thumbnail-cache.o \
 	Tooltip.o \
 	unknown-game-dialog.o \
 	widget.o \
@@ -219,6 +219,7 @@ public:
 protected:
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleMouseWheel(int x, int y, int direction) override;
+	void handleTickle() override;
 	void updateSaveList(bool external) override;
 private:
 	int runIntern() override;
@@ -256,6 +257,10 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlot(uint curNum, uint i);
+
+	// Buttons on the current page still waiting for their meta infos
+	Common::Array<uint> _pendingSlots;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -0,0 +1,256 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/debug.h"
+#include "common/savefile.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/managed_surface.h"
+
+#include "gui/thumbnail-cache.h"
+
+namespace GUI {
+
+#define THUMBNAIL_CACHE_VERSION 1
+
+enum {
+	// Entries not used in the current session are dropped beyond this count
+	kMaxCacheEntries = 2048,
+	// Anything larger than this in the index means the file is damaged
+	kMaxThumbnailSize = 2048
+};
+
+ThumbnailCache::ThumbnailCache(const Common::String &fileName) : _fileName(fileName), _file(nullptr), _dirty(false) {
+	loadIndex();
+}
+
+ThumbnailCache::~ThumbnailCache() {
+	flush();
+	clear();
+}
+
+void ThumbnailCache::clear() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete[] i->_value.pixels;
+	_entries.clear();
+
+	delete _file;
+	_file = nullptr;
+}
+
+void ThumbnailCache::loadIndex() {
+	_file = g_system->getSavefileManager()->openForLoading(_fileName);
+	if (!_file)
+		return;
+
+	if (_file->readUint32BE() != MKTAG('S', 'V', 'T', 'C') || _file->readByte() != THUMBNAIL_CACHE_VERSION) {
+		debug(2, "ThumbnailCache: Ignoring outdated cache '%s'", _fileName.c_str());
+		delete _file;
+		_file = nullptr;
+		return;
+	}
+
+	const uint32 count = _file->readUint32BE();
+	for (uint32 i = 0; i < count && !_file->eos() && !_file->err(); i++) {
+		Entry entry;
+		const Common::String key = _file->readPascalString(false);
+		entry.stamp = _file->readUint32BE();
+		entry.boxWidth = _file->readUint16BE();
+		entry.boxHeight = _file->readUint16BE();
+		entry.width = _file->readUint16BE();
+		entry.height = _file->readUint16BE();
+
+		entry.format.bytesPerPixel = _file->readByte();
+		entry.format.rLoss = _file->readByte();
+		entry.format.gLoss = _file->readByte();
+		entry.format.bLoss = _file->readByte();
+		entry.format.aLoss = _file->readByte();
+		entry.format.rShift = _file->readByte();
+		entry.format.gShift = _file->readByte();
+		entry.format.bShift = _file->readByte();
+		entry.format.aShift = _file->readByte();
+
+		// Don't let a damaged index make us allocate arbitrary amounts
+		// of memory in get() and flush()
+		if (_file->eos() || _file->err() || !isValidEntry(entry)) {
+			warning("ThumbnailCache: Ignoring damaged cache '%s'", _fileName.c_str());
+			_entries.clear();
+			delete _file;
+			_file = nullptr;
+			return;
+		}
+
+		entry.offset = _file->pos();
+		if (entry.offset + entry.dataSize() > (uint64)_file->size() || !_file->skip(entry.dataSize()))
+			break;
+
+		_entries[key] = entry;
+	}
+}
+
+bool ThumbnailCache::isValidEntry(const Entry &entry) {
+	if (entry.width == 0 || entry.width > kMaxThumbnailSize || entry.height == 0 || entry.height > kMaxThumbnailSize)
+		return false;
+	if (entry.boxWidth > kMaxThumbnailSize || entry.boxHeight > kMaxThumbnailSize)
+		return false;
+	if (entry.format.bytesPerPixel < 1 || entry.format.bytesPerPixel > 4)
+		return false;
+
+	const Graphics::PixelFormat &f = entry.format;
+	return f.rLoss <= 8 && f.gLoss <= 8 && f.bLoss <= 8 && f.aLoss <= 8 &&
+		f.rShift < 32 && f.gShift < 32 && f.bShift < 32 && f.aShift < 32;
+}
+
+Graphics::ManagedSurface *ThumbnailCache::get(const Common::String &key, uint32 stamp, int boxWidth, int boxHeight) {
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end())
+		return nullptr;
+
+	Entry &entry = i->_value;
+	if (entry.stamp != stamp || entry.boxWidth != boxWidth || entry.boxHeight != boxHeight)
+		return nullptr;
+
+	Graphics::ManagedSurface *surf = new Graphics::ManagedSurface(entry.width, entry.height, entry.format);
+	const uint rowSize = entry.width * entry.format.bytesPerPixel;
+
+	if (entry.pixels) {
+		for (int y = 0; y < entry.height; y++)
+			memcpy(surf->getBasePtr(0, y), entry.pixels + y * rowSize, rowSize);
+	} else {
+		bool ok = _file && _file->seek(entry.offset);
+		for (int y = 0; ok && y < entry.height; y++)
+			ok = _file->read(surf->getBasePtr(0, y), rowSize) == rowSize;
+
+		if (!ok) {
+			warning("ThumbnailCache: Failed to read '%s' from '%s'", key.c_str(), _fileName.c_str());
+			delete surf;
+			_entries.erase(i);
+			_dirty = true;
+			return nullptr;
+		}
+	}
+
+	entry.used = true;
+	return surf;
+}
+
+void ThumbnailCache::put(const Common::String &key, uint32 stamp, int boxWidth, int boxHeight, const Graphics::Surface &surf) {
+	// Keys are stored as Pascal strings
+	if (key.size() > 255)
+		return;
+
+	Entry &entry = _entries[key];
+	delete[] entry.pixels;
+
+	entry.stamp = stamp;
+	entry.boxWidth = boxWidth;
+	entry.boxHeight = boxHeight;
+	entry.width = surf.w;
+	entry.height = surf.h;
+	entry.format = surf.format;
+	entry.offset = 0;
+	entry.used = true;
+
+	const uint rowSize = surf.w * surf.format.bytesPerPixel;
+	entry.pixels = new byte[entry.dataSize()];
+	for (int y = 0; y < surf.h; y++)
+		memcpy(entry.pixels + y * rowSize, surf.getBasePtr(0, y), rowSize);
+
+	_dirty = true;
+}
+
+void ThumbnailCache::flush() {
+	if (!_dirty)
+		return;
+
+	// The new file replaces the old one, so pull everything that is kept
+	// into memory first
+	uint32 count = 0;
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ) {
+		Entry &entry = i->_value;
+		if (!entry.used && _entries.size() > kMaxCacheEntries) {
+			delete[] entry.pixels;
+			_entries.erase(i++);
+			continue;
+		}
+
+		if (!entry.pixels) {
+			entry.pixels = new byte[entry.dataSize()];
+			if (!_file || !_file->seek(entry.offset) || _file->read(entry.pixels, entry.dataSize()) != entry.dataSize()) {
+				delete[] entry.pixels;
+				_entries.erase(i++);
+				continue;
+			}
+		}
+
+		++count;
+		++i;
+	}
+
+	delete _file;
+	_file = nullptr;
+
+	// Thumbnails are stored uncompressed, so the index can be read without
+	// inflating the pixel data
+	Common::OutSaveFile *out = g_system->getSavefileManager()->openForSaving(_fileName, false);
+	if (!out) {
+		warning("ThumbnailCache: Could not write '%s'", _fileName.c_str());
+		return;
+	}
+
+	out->writeUint32BE(MKTAG('S', 'V', 'T', 'C'));
+	out->writeByte(THUMBNAIL_CACHE_VERSION);
+	out->writeUint32BE(count);
+
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		const Entry &entry = i->_value;
+		out->writeByte(i->_key.size());
+		out->writeString(i->_key);
+		out->writeUint32BE(entry.stamp);
+		out->writeUint16BE(entry.boxWidth);
+		out->writeUint16BE(entry.boxHeight);
+		out->writeUint16BE(entry.width);
+		out->writeUint16BE(entry.height);
+
+		out->writeByte(entry.format.bytesPerPixel);
+		out->writeByte(entry.format.rLoss);
+		out->writeByte(entry.format.gLoss);
+		out->writeByte(entry.format.bLoss);
+		out->writeByte(entry.format.aLoss);
+		out->writeByte(entry.format.rShift);
+		out->writeByte(entry.format.gShift);
+		out->writeByte(entry.format.bShift);
+		out->writeByte(entry.format.aShift);
+
+		out->write(entry.pixels, entry.dataSize());
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("ThumbnailCache: Could not write '%s'", _fileName.c_str());
+	delete out;
+
+	_dirty = false;
+	_file = g_system->getSavefileManager()->openForLoading(_fileName);
+}
+
+} // End of namespace GUI
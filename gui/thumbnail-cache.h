@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_THUMBNAIL_CACHE_H
+#define GUI_THUMBNAIL_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+#include "graphics/pixelformat.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Graphics {
+class ManagedSurface;
+struct Surface;
+}
+
+namespace GUI {
+
+/**
+ * A persistent cache of already scaled thumbnails, stored as a single file
+ * in the save directory.
+ *
+ * Entries are looked up by a key (usually the path of the source image)
+ * and are only returned when the stamp and the requested bounding box match
+ * the ones recorded when the entry was stored. The stamp should change
+ * whenever the source changes; the size of the source file is used by the
+ * launcher grid.
+ *
+ * Only the index is read when the cache is opened. Pixel data is read on
+ * demand, so opening a cache with thousands of entries stays cheap.
+ */
+class ThumbnailCache {
+public:
+	ThumbnailCache(const Common::String &fileName);
+	~ThumbnailCache();
+
+	/**
+	 * Look up a thumbnail.
+	 *
+	 * @return a new surface owned by the caller, or nullptr if there is no
+	 *         matching entry.
+	 */
+	Graphics::ManagedSurface *get(const Common::String &key, uint32 stamp, int boxWidth, int boxHeight);
+
+	/**
+	 * Store a thumbnail which was scaled to fit into the given bounding box.
+	 * The data is copied and written to disk by flush().
+	 */
+	void put(const Common::String &key, uint32 stamp, int boxWidth, int boxHeight, const Graphics::Surface &surf);
+
+	/** Write the cache back to disk if any entry was added or replaced. */
+	void flush();
+
+private:
+	struct Entry {
+		uint32 stamp;
+		uint16 boxWidth, boxHeight;
+		uint16 width, height;
+		Graphics::PixelFormat format;
+
+		/** Position of the pixel data in the cache file, if not in memory. */
+		uint32 offset;
+		/** Pixel data of entries added since the cache was loaded. */
+		byte *pixels;
+		/** Whether the entry was looked up or stored in this session. */
+		bool used;
+
+		Entry() : stamp(0), boxWidth(0), boxHeight(0), width(0), height(0), offset(0), pixels(nullptr), used(false) {}
+		uint32 dataSize() const { return width * height * format.bytesPerPixel; }
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	void loadIndex();
+	void clear();
+	static bool isValidEntry(const Entry &entry);
+
+	Common::String _fileName;
+	Common::SeekableReadStream *_file;
+	EntryMap _entries;
+	bool _dirty;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -24,6 +24,7 @@
 #include "common/rect.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "gui/widget.h"
 #include "gui/gui-manager.h"
@@ -623,6 +624,17 @@ const Graphics::ManagedSurface *scaleGfx(const Graphics::ManagedSurface *gfx, in
 	w = nw;
 	h = nh;
 
+	// Shrinking thumbnails and icons by averaging keeps fine detail readable.
+	// Color keyed images are left to the regular scaler, as averaging would
+	// bleed the key color into the edges.
+	if (filtering && w <= gfx->w && h <= gfx->h && !gfx->hasTransparentColor()) {
+		Graphics::ManagedSurface *target = new Graphics::ManagedSurface(w, h, gfx->format);
+		if (Graphics::scaleBlitBox((byte *)target->getPixels(), (const byte *)gfx->getPixels(),
+		                           target->pitch, gfx->pitch, w, h, gfx->w, gfx->h, gfx->format))
+			return target;
+		delete target;
+	}
+
 	return gfx->scale(w, h, filtering);
 }
 
@@ -27,12 +27,16 @@
 #include "common/translation.h"
 
 #include "gui/gui-manager.h"
+#include "gui/thumbnail-cache.h"
 #include "gui/widgets/grid.h"
 
 #include "gui/ThemeEval.h"
 
 namespace GUI {
 
+// Time in milliseconds spent loading thumbnails per GUI tick
+static const uint32 kThumbnailLoadBudget = 10;
+
 GridItemWidget::GridItemWidget(GridWidget *boss)
 	: ContainerWidget(boss, 0, 0, 0, 0), CommandSender(boss) {
 
@@ -253,7 +257,7 @@ void GridWidget::saveClosedGroups(const Common::U32String &groupName) {
 		}
 	}
 	ConfMan.set("group_" + groupName, hiddenGroups, ConfMan.kApplicationDomain);
-	ConfMan.flushToDisk();
+	ConfMan.scheduleFlushToDisk();
 }
 
 void GridItemWidget::handleMouseDown(int x, int y, int button, int clickCount) {
@@ -396,6 +400,27 @@ void GridItemTray::handleMouseMoved(int x, int y, int button) {
 
 #pragma mark -
 
+// Return the size of a file in the icons set, or 0 if it does not exist.
+static uint32 getIconFileSize(const Common::Path &path) {
+	uint32 size = 0;
+	g_gui.lockIconsSet();
+	if (g_gui.getIconsSet().hasFile(path)) {
+		// The icon packs record the sizes, so this does not inflate anything
+		int64 memberSize = g_gui.getIconsSet().getMemberSize(path);
+		if (memberSize >= 0) {
+			size = memberSize;
+		} else {
+			// Plain files, which are cheap to open
+			Common::SeekableReadStream *stream = g_gui.getIconsSet().createReadStreamForMember(path);
+			if (stream)
+				size = stream->size();
+			delete stream;
+		}
+	}
+	g_gui.unlockIconsSet();
+	return size;
+}
+
 // Load an image file by String name, provide additional render dimensions for SVG images.
 // TODO: Add BMP support, and add scaling of non-vector images.
 Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int renderWidth = 0, int renderHeight = 0) {
@@ -457,6 +482,7 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	_extraIconHeight = 0;
 	_extraIconWidth = 0;
 	_disabledIconOverlay = nullptr;
+	_thumbnailCache = new ThumbnailCache("launcher-thumbnails.cache");
 
 	_minGridXSpacing = 0;
 	_minGridYSpacing = 0;
@@ -467,6 +493,9 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	_scrollWindowPaddingX = 0;
 	_scrollWindowPaddingY = 0;
 
+	// Thumbnails are loaded a few at a time from handleTickle()
+	setFlags(WIDGET_WANT_TICKLE);
+
 	_scrollBar = new ScrollBarWidget(this, _w - _scrollBarWidth, _y, _scrollBarWidth, _y + _h);
 	_scrollBar->setTarget(this);
 	_scrollPos = 0;
@@ -501,6 +530,7 @@ GridWidget::~GridWidget() {
 	unloadSurfaces(_extraIcons);
 	unloadSurfaces(_loadedSurfaces);
 	delete _disabledIconOverlay;
+	delete _thumbnailCache;
 	_gridItems.clear();
 	_dataEntryList.clear();
 	_headerEntryList.clear();
@@ -555,6 +585,7 @@ void GridWidget::setEntryList(Common::Array<GridItemInfo> *list) {
 	_headerEntryList.clear();
 	_sortedEntryList.clear();
 	_visibleEntryList.clear();
+	_pendingThumbnails.clear();
 	_isGridInvalid = true;
 	_selectedEntry = nullptr;
 	_selectedItems.clear();
@@ -748,48 +779,90 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 }
 
 void GridWidget::reloadThumbnails() {
-	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
-	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
+	// Only queue the thumbnails here. Decoding and scaling every visible
+	// icon at once stalls the launcher, so they are loaded from handleTickle()
+	// instead, in the order they appear on screen.
+	_pendingThumbnails.clear();
 	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
 		GridItemInfo *entry = *iter;
 		if (entry->thumbPath.empty())
 			continue;
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[entry->thumbPath] = thSurf;
-				}
-			}
+		if (!_loadedSurfaces.contains(entry->thumbPath))
+			_pendingThumbnails.push_back(entry);
+	}
+}
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+void GridWidget::loadThumbnail(const GridItemInfo &entry) {
+	if (_loadedSurfaces.contains(entry.thumbPath))
+		return;
 
-				if (path != entry->thumbPath) {
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[path] = thSurf;
-				}
+	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
+	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
+	_loadedSurfaces[entry.thumbPath] = nullptr;
+	Common::String path = Common::String::format("icons/%s-%s.png", entry.engineid.c_str(), entry.gameid.c_str());
+	uint32 fileSize = getIconFileSize(Common::Path(path));
+	if (!fileSize) {
+		path = Common::String::format("icons/%s.png", entry.engineid.c_str());
+		if (_loadedSurfaces.contains(path)) {
+			const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
+			if (scSurf) {
+				// TODO: Use SharedPtr instead of duplicating the surface
+				Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
+				thSurf->copyFrom(*scSurf);
+				_loadedSurfaces[entry.thumbPath] = thSurf;
 			}
+			return;
+		}
+		fileSize = getIconFileSize(Common::Path(path));
+		if (!fileSize)
+			return;
+	}
+
+	// The icons only change along with their file, so the file size is a
+	// good enough stamp to tell whether the cached version is still valid
+	const Graphics::ManagedSurface *scSurf = _thumbnailCache->get(path, fileSize, thumbnailWidth, thumbnailHeight);
+	if (!scSurf) {
+		Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
+		if (!surf)
+			return;
+
+		scSurf = scaleGfx(surf, thumbnailWidth, thumbnailHeight, true);
+		if (surf != scSurf) {
+			surf->free();
+			delete surf;
 		}
+
+		_thumbnailCache->put(path, fileSize, thumbnailWidth, thumbnailHeight, scSurf->rawSurface());
+	}
+
+	_loadedSurfaces[entry.thumbPath] = scSurf;
+
+	if (path != entry.thumbPath) {
+		// TODO: Use SharedPtr instead of duplicating the surface
+		Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
+		thSurf->copyFrom(*scSurf);
+		_loadedSurfaces[path] = thSurf;
+	}
+}
+
+void GridWidget::handleTickle() {
+	if (_pendingThumbnails.empty())
+		return;
+
+	// Keep the GUI responsive by spending at most a few milliseconds per tick
+	const uint32 deadline = g_system->getMillis() + kThumbnailLoadBudget;
+	uint loaded = 0;
+	while (loaded < _pendingThumbnails.size()) {
+		loadThumbnail(*_pendingThumbnails[loaded++]);
+		if (g_system->getMillis() >= deadline)
+			break;
 	}
+	_pendingThumbnails.erase(_pendingThumbnails.begin(), _pendingThumbnails.begin() + loaded);
+
+	assignEntriesToItems();
+	markAsDirty();
 }
 
 void GridWidget::loadFlagIcons() {
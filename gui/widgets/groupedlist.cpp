@@ -186,7 +186,7 @@ void GroupedListWidget::saveClosedGroups(const Common::U32String &groupName) {
 		}
 	}
 	ConfMan.set("group_" + groupName, hiddenGroups, ConfMan.kApplicationDomain);
-	ConfMan.flushToDisk();
+	ConfMan.scheduleFlushToDisk();
 }
 
 void GroupedListWidget::handleMouseDown(int x, int y, int button, int clickCount) {
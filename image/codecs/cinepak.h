@@ -23,6 +23,7 @@
 #define IMAGE_CODECS_CINEPAK_H
 
 #include "common/scummsys.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 #include "graphics/pixelformat.h"
 #include "graphics/palette.h"
@@ -92,7 +93,7 @@ private:
 
 	Graphics::Palette _ditherPalette;
 	bool _dirtyPalette;
-	byte *_colorMap;
+	Common::SharedPtr<byte> _colorMap;
 	DitherType _ditherType;
 
 	void initializeCodebook(uint16 strip, byte codebookType);
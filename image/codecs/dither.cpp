@@ -22,9 +22,59 @@
 #include "image/codecs/dither.h"
 
 #include "common/list.h"
+#include "common/singleton.h"
 
 namespace Image {
 
+/**
+ * Keeps the QuickTime dither tables of the most recently used palettes,
+ * since building one takes a lot longer than dithering a frame with it.
+ */
+class QuickTimeDitherTableCache : public Common::Singleton<QuickTimeDitherTableCache> {
+public:
+	Common::SharedPtr<byte> getTable(const byte *palette);
+
+private:
+	static const uint kMaxTables = 4;
+
+	struct Entry {
+		byte palette[256 * 3];
+		Common::SharedPtr<byte> table;
+	};
+
+	// Most recently used first
+	Common::List<Entry> _entries;
+};
+
+} // End of namespace Image
+
+namespace Common {
+DECLARE_SINGLETON(Image::QuickTimeDitherTableCache);
+}
+
+namespace Image {
+
+Common::SharedPtr<byte> QuickTimeDitherTableCache::getTable(const byte *palette) {
+	for (Common::List<Entry>::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if (memcmp(i->palette, palette, sizeof(i->palette)) == 0) {
+			if (i != _entries.begin()) {
+				_entries.push_front(*i);
+				_entries.erase(i);
+			}
+			return _entries.front().table;
+		}
+	}
+
+	if (_entries.size() >= kMaxTables)
+		_entries.pop_back();
+
+	Entry entry;
+	memcpy(entry.palette, palette, sizeof(entry.palette));
+	entry.table = Common::SharedPtr<byte>(DitherCodec::createQuickTimeDitherTable(palette, 256), Common::ArrayDeleter<byte>());
+	_entries.push_front(entry);
+	return entry.table;
+}
+
 namespace {
 
 /**
@@ -51,14 +101,15 @@ inline uint16 makeQuickTimeDitherColor(byte r, byte g, byte b) {
 
 DitherCodec::DitherCodec(Codec *codec, DisposeAfterUse::Flag disposeAfterUse)
   : _codec(codec), _disposeAfterUse(disposeAfterUse), _dirtyPalette(false),
-    _forcedDitherPalette(0), _ditherTable(0), _ditherFrame(0), _srcPalette(nullptr) {
+    _forcedDitherPalette(0), _ditherFrame(0), _srcPalette(nullptr),
+    _paletteDitherTableValid(false), _formatDitherTable(nullptr) {
 }
 
 DitherCodec::~DitherCodec() {
 	if (_disposeAfterUse == DisposeAfterUse::YES)
 		delete _codec;
 
-	delete[] _ditherTable;
+	delete[] _formatDitherTable;
 
 	if (_ditherFrame) {
 		_ditherFrame->free();
@@ -69,41 +120,79 @@ DitherCodec::~DitherCodec() {
 namespace {
 
 // Default template to convert a dither color
-inline uint16 readQT_RGB(uint32 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
+inline uint16 readQT_RGB(uint32 srcColor, const Graphics::PixelFormat& format, const void *lookup) {
 	byte r, g, b;
 	format.colorToRGB(srcColor, r, g, b);
 	return makeQuickTimeDitherColor(r, g, b);
 }
 
-// Specialized version for 8bpp
-inline uint16 readQT_Palette(uint8 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	return makeQuickTimeDitherColor(palette[srcColor * 3], palette[srcColor * 3 + 1], palette[srcColor * 3 + 2]);
+// Specialized version for other 16bpp formats, using a precomputed conversion table
+inline uint16 readQT_Lookup(uint16 srcColor, const Graphics::PixelFormat& format, const void *lookup) {
+	return ((const uint16 *)lookup)[srcColor];
 }
 
 // Specialized version for RGB554
-inline uint16 readQT_RGB554(uint16 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
+inline uint16 readQT_RGB554(uint16 srcColor, const Graphics::PixelFormat& format, const void *lookup) {
 	return srcColor;
 }
 
 // Specialized version for RGB555 and ARGB1555
-inline uint16 readQT_RGB555(uint16 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
+inline uint16 readQT_RGB555(uint16 srcColor, const Graphics::PixelFormat& format, const void *lookup) {
 	return (srcColor >> 1) & 0x3FFF;
 }
 
 template<typename PixelInt, class Fn>
-void ditherQuickTimeFrame(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable, Fn fn, const byte *palette = 0) {
+void ditherQuickTimeFrame(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable, Fn fn, const void *lookup = 0) {
 	static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
 
 	for (int y = 0; y < dst.h; y++) {
 		const PixelInt *srcPtr = (const PixelInt *)src.getBasePtr(0, y);
 		byte *dstPtr = (byte *)dst.getBasePtr(0, y);
-		uint16 colorTableOffset = colorTableOffsets[y & 3];
 
-		for (int x = 0; x < dst.w; x++) {
-			uint16 color = fn(*srcPtr++, src.format, palette);
-			*dstPtr++ = ditherTable[colorTableOffset + color];
-			colorTableOffset += 0x4000;
+		// The four tables cycle with the column, so resolve them once per row
+		const byte *tables[4];
+		for (int i = 0; i < 4; i++)
+			tables[i] = ditherTable + (uint16)(colorTableOffsets[y & 3] + i * 0x4000);
+
+		int x = 0;
+		for (; x + 4 <= dst.w; x += 4) {
+			dstPtr[0] = tables[0][fn(srcPtr[0], src.format, lookup)];
+			dstPtr[1] = tables[1][fn(srcPtr[1], src.format, lookup)];
+			dstPtr[2] = tables[2][fn(srcPtr[2], src.format, lookup)];
+			dstPtr[3] = tables[3][fn(srcPtr[3], src.format, lookup)];
+			srcPtr += 4;
+			dstPtr += 4;
 		}
+
+		for (; x < dst.w; x++)
+			*dstPtr++ = tables[x & 3][fn(*srcPtr++, src.format, lookup)];
+	}
+}
+
+// Paletted frames go through a per-palette table holding the final index for each column phase
+void ditherQuickTimeFramePaletted(const Graphics::Surface &src, Graphics::Surface &dst, const byte (*paletteTable)[256]) {
+	static const byte tableOffsets[] = { 0, 3, 1, 2 };
+
+	for (int y = 0; y < dst.h; y++) {
+		const byte *srcPtr = (const byte *)src.getBasePtr(0, y);
+		byte *dstPtr = (byte *)dst.getBasePtr(0, y);
+
+		const byte *tables[4];
+		for (int i = 0; i < 4; i++)
+			tables[i] = paletteTable[(tableOffsets[y & 3] + i) & 3];
+
+		int x = 0;
+		for (; x + 4 <= dst.w; x += 4) {
+			dstPtr[0] = tables[0][srcPtr[0]];
+			dstPtr[1] = tables[1][srcPtr[1]];
+			dstPtr[2] = tables[2][srcPtr[2]];
+			dstPtr[3] = tables[3][srcPtr[3]];
+			srcPtr += 4;
+			dstPtr += 4;
+		}
+
+		for (; x < dst.w; x++)
+			*dstPtr++ = tables[x & 3][*srcPtr++];
 	}
 }
 
@@ -132,21 +221,53 @@ const Graphics::Surface *DitherCodec::decodeFrame(Common::SeekableReadStream &st
 		_ditherFrame->create(frame->w, frame->h, Graphics::PixelFormat::createFormatCLUT8());
 	}
 
-	if (frame->format.isCLUT8() && curPalette)
-		ditherQuickTimeFrame<byte>(*frame, *_ditherFrame, _ditherTable, readQT_Palette, curPalette);
-	else if (frame->format == Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0))
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB554);
-	else if (frame->format == Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) ||
-	         frame->format == Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15))
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB555);
-	else if (frame->format.bytesPerPixel == 2)
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB);
-	else if (frame->format.bytesPerPixel == 4)
-		ditherQuickTimeFrame<uint32>(*frame, *_ditherFrame, _ditherTable, readQT_RGB);
+	const byte *ditherTable = _ditherTable.get();
+
+	if (frame->format.isCLUT8() && curPalette) {
+		updatePaletteDitherTable(curPalette);
+		ditherQuickTimeFramePaletted(*frame, *_ditherFrame, _paletteDitherTable);
+	} else if (frame->format == Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0)) {
+		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, ditherTable, readQT_RGB554);
+	} else if (frame->format == Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) ||
+	           frame->format == Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15)) {
+		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, ditherTable, readQT_RGB555);
+	} else if (frame->format.bytesPerPixel == 2) {
+		updateFormatDitherTable(frame->format);
+		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, ditherTable, readQT_Lookup, _formatDitherTable);
+	} else if (frame->format.bytesPerPixel == 4) {
+		ditherQuickTimeFrame<uint32>(*frame, *_ditherFrame, ditherTable, readQT_RGB);
+	}
 
 	return _ditherFrame;
 }
 
+void DitherCodec::updatePaletteDitherTable(const byte *palette) {
+	if (_paletteDitherTableValid && memcmp(_paletteDitherSource, palette, sizeof(_paletteDitherSource)) == 0)
+		return;
+
+	memcpy(_paletteDitherSource, palette, sizeof(_paletteDitherSource));
+	_paletteDitherTableValid = true;
+
+	const byte *ditherTable = _ditherTable.get();
+	for (uint i = 0; i < 256; i++) {
+		uint16 color = makeQuickTimeDitherColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+		for (uint j = 0; j < 4; j++)
+			_paletteDitherTable[j][i] = ditherTable[j * 0x4000 + color];
+	}
+}
+
+void DitherCodec::updateFormatDitherTable(const Graphics::PixelFormat &format) {
+	if (_formatDitherTable && _formatDitherTableFormat == format)
+		return;
+
+	if (!_formatDitherTable)
+		_formatDitherTable = new uint16[0x10000];
+	_formatDitherTableFormat = format;
+
+	for (uint i = 0; i < 0x10000; i++)
+		_formatDitherTable[i] = readQT_RGB(i, format, nullptr);
+}
+
 Graphics::PixelFormat DitherCodec::getPixelFormat() const {
 	if (_forcedDitherPalette.empty())
 		return _codec->getPixelFormat();
@@ -194,7 +315,7 @@ void DitherCodec::setDither(DitherType type, const byte *palette) {
 		_forcedDitherPalette.set(palette, 0, 256);
 		_dirtyPalette = true;
 
-		_ditherTable = createQuickTimeDitherTable(_forcedDitherPalette.data(), 256);
+		_ditherTable = getQuickTimeDitherTable(_forcedDitherPalette.data());
 
 		// Prefer RGB554 or RGB555 to avoid extra conversion when dithering
 		if (!_codec->setOutputPixelFormat(Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0)))
@@ -206,6 +327,10 @@ void DitherCodec::setCodecAccuracy(CodecAccuracy accuracy) {
 	return _codec->setCodecAccuracy(accuracy);
 }
 
+Common::SharedPtr<byte> DitherCodec::getQuickTimeDitherTable(const byte *palette) {
+	return QuickTimeDitherTableCache::instance().getTable(palette);
+}
+
 byte *DitherCodec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 	byte *buf = new byte[0x10000]();
 
@@ -24,6 +24,7 @@
 
 #include "image/codecs/codec.h"
 
+#include "common/ptr.h"
 #include "common/types.h"
 #include "graphics/palette.h"
 
@@ -55,15 +56,36 @@ public:
 	 */
 	static byte *createQuickTimeDitherTable(const byte *palette, uint colorCount);
 
+	/**
+	 * Get the QuickTime dither table for a 256 color palette.
+	 *
+	 * The tables of the most recently used palettes are cached, so codecs
+	 * dithering to the same palette share one table instead of each
+	 * building their own.
+	 */
+	static Common::SharedPtr<byte> getQuickTimeDitherTable(const byte *palette);
+
 private:
+	void updatePaletteDitherTable(const byte *palette);
+	void updateFormatDitherTable(const Graphics::PixelFormat &format);
+
 	DisposeAfterUse::Flag _disposeAfterUse;
 	Codec *_codec;
 	const byte *_srcPalette;
 
 	Graphics::Surface *_ditherFrame;
 	Graphics::Palette _forcedDitherPalette;
-	byte *_ditherTable;
+	Common::SharedPtr<byte> _ditherTable;
 	bool _dirtyPalette;
+
+	// Final dither results of a CLUT8 source palette, per column phase
+	byte _paletteDitherTable[4][256];
+	byte _paletteDitherSource[256 * 3];
+	bool _paletteDitherTableValid;
+
+	// RGB554 dither colors of every value of a 16bpp source format
+	uint16 *_formatDitherTable;
+	Graphics::PixelFormat _formatDitherTableFormat;
 };
 
 } // End of namespace Image
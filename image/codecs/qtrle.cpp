@@ -40,7 +40,6 @@ QTRLEDecoder::QTRLEDecoder(uint16 width, uint16 height, byte bitsPerPixel) : Cod
 	_height = height;
 	_surface = 0;
 	_dirtyPalette = false;
-	_colorMap = 0;
 
 	// We need to ensure the width is a multiple of 4
 	_paddedWidth = width;
@@ -54,8 +53,6 @@ QTRLEDecoder::~QTRLEDecoder() {
 		_surface->free();
 		delete _surface;
 	}
-
-	delete[] _colorMap;
 }
 
 #define CHECK_STREAM_PTR(n) \
@@ -272,6 +269,7 @@ inline uint16 readDitherColor16(Common::ReadStream &stream) {
 void QTRLEDecoder::dither16(Common::SeekableReadStream &stream, uint32 rowPtr, uint32 linesToChange) {
 	uint32 pixelPtr = 0;
 	byte *output = (byte *)_surface->getPixels();
+	const byte *colorMap = _colorMap.get();
 
 	static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
 
@@ -302,7 +300,7 @@ void QTRLEDecoder::dither16(Common::SeekableReadStream &stream, uint32 rowPtr, u
 				CHECK_PIXEL_PTR(rleCode);
 
 				while (rleCode--) {
-					output[pixelPtr++] = _colorMap[colorTableOffset + color];
+					output[pixelPtr++] = colorMap[colorTableOffset + color];
 					colorTableOffset += 0x4000;
 				}
 			} else {
@@ -312,7 +310,7 @@ void QTRLEDecoder::dither16(Common::SeekableReadStream &stream, uint32 rowPtr, u
 				// copy pixels directly to output
 				while (rleCode--) {
 					uint16 color = readDitherColor16(stream);
-					output[pixelPtr++] = _colorMap[colorTableOffset + color];
+					output[pixelPtr++] = colorMap[colorTableOffset + color];
 					colorTableOffset += 0x4000;
 				}
 			}
@@ -385,6 +383,7 @@ inline uint16 readDitherColor24(Common::ReadStream &stream) {
 void QTRLEDecoder::dither24(Common::SeekableReadStream &stream, uint32 rowPtr, uint32 linesToChange) {
 	uint32 pixelPtr = 0;
 	byte *output = (byte *)_surface->getPixels();
+	const byte *colorMap = _colorMap.get();
 
 	static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
 
@@ -415,7 +414,7 @@ void QTRLEDecoder::dither24(Common::SeekableReadStream &stream, uint32 rowPtr, u
 				CHECK_PIXEL_PTR(rleCode);
 
 				while (rleCode--) {
-					output[pixelPtr++] = _colorMap[colorTableOffset + color];
+					output[pixelPtr++] = colorMap[colorTableOffset + color];
 					colorTableOffset += 0x4000;
 				}
 			} else {
@@ -425,7 +424,7 @@ void QTRLEDecoder::dither24(Common::SeekableReadStream &stream, uint32 rowPtr, u
 				// copy pixels directly to output
 				while (rleCode--) {
 					uint16 color = readDitherColor24(stream);
-					output[pixelPtr++] = _colorMap[colorTableOffset + color];
+					output[pixelPtr++] = colorMap[colorTableOffset + color];
 					colorTableOffset += 0x4000;
 				}
 			}
@@ -500,6 +499,7 @@ inline uint16 readDitherColor32(Common::ReadStream &stream) {
 void QTRLEDecoder::dither32(Common::SeekableReadStream &stream, uint32 rowPtr, uint32 linesToChange) {
 	uint32 pixelPtr = 0;
 	byte *output = (byte *)_surface->getPixels();
+	const byte *colorMap = _colorMap.get();
 
 	static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
 
@@ -530,7 +530,7 @@ void QTRLEDecoder::dither32(Common::SeekableReadStream &stream, uint32 rowPtr, u
 				CHECK_PIXEL_PTR(rleCode);
 
 				while (rleCode--) {
-					output[pixelPtr++] = _colorMap[colorTableOffset + color];
+					output[pixelPtr++] = colorMap[colorTableOffset + color];
 					colorTableOffset += 0x4000;
 				}
 			} else {
@@ -540,7 +540,7 @@ void QTRLEDecoder::dither32(Common::SeekableReadStream &stream, uint32 rowPtr, u
 				// copy pixels directly to output
 				while (rleCode--) {
 					uint16 color = readDitherColor32(stream);
-					output[pixelPtr++] = _colorMap[colorTableOffset + color];
+					output[pixelPtr++] = colorMap[colorTableOffset + color];
 					colorTableOffset += 0x4000;
 				}
 			}
@@ -661,8 +661,7 @@ void QTRLEDecoder::setDither(DitherType type, const byte *palette) {
 	_ditherPalette.set(palette, 0, 256);
 	_dirtyPalette = true;
 
-	delete[] _colorMap;
-	_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+	_colorMap = DitherCodec::getQuickTimeDitherTable(palette);
 }
 
 void QTRLEDecoder::createSurface() {
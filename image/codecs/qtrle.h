@@ -22,6 +22,7 @@
 #ifndef IMAGE_CODECS_QTRLE_H
 #define IMAGE_CODECS_QTRLE_H
 
+#include "common/ptr.h"
 #include "graphics/pixelformat.h"
 #include "graphics/palette.h"
 #include "image/codecs/codec.h"
@@ -54,7 +55,7 @@ private:
 	uint32 _paddedWidth;
 	Graphics::Palette _ditherPalette;
 	bool _dirtyPalette;
-	byte *_colorMap;
+	Common::SharedPtr<byte> _colorMap;
 
 	void createSurface();
 
@@ -34,7 +34,6 @@ namespace Image {
 RPZADecoder::RPZADecoder(uint16 width, uint16 height) : Codec(), _ditherPalette(0) {
 	_format = Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0);
 	_dirtyPalette = false;
-	_colorMap = 0;
 	_width = width;
 	_height = height;
 	_blockWidth = (width + 3) / 4;
@@ -47,8 +46,6 @@ RPZADecoder::~RPZADecoder() {
 		_surface->free();
 		delete _surface;
 	}
-
-	delete[] _colorMap;
 }
 
 #define ADVANCE_BLOCK() \
@@ -338,9 +335,9 @@ const Graphics::Surface *RPZADecoder::decodeFrame(Common::SeekableReadStream &st
 	}
 
 	if (_colorMap)
-		decodeFrameTmpl<byte, BlockDecoderDither>(stream, (byte *)_surface->getPixels(), _surface->pitch, _blockWidth, _blockHeight, _colorMap);
+		decodeFrameTmpl<byte, BlockDecoderDither>(stream, (byte *)_surface->getPixels(), _surface->pitch, _blockWidth, _blockHeight, _colorMap.get());
 	else
-		decodeFrameTmpl<uint16, BlockDecoderRaw>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, _colorMap);
+		decodeFrameTmpl<uint16, BlockDecoderRaw>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, nullptr);
 
 	return _surface;
 }
@@ -358,8 +355,7 @@ void RPZADecoder::setDither(DitherType type, const byte *palette) {
 	_dirtyPalette = true;
 	_format = Graphics::PixelFormat::createFormatCLUT8();
 
-	delete[] _colorMap;
-	_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+	_colorMap = DitherCodec::getQuickTimeDitherTable(palette);
 }
 
 } // End of namespace Image
@@ -22,6 +22,7 @@
 #ifndef IMAGE_CODECS_RPZA_H
 #define IMAGE_CODECS_RPZA_H
 
+#include "common/ptr.h"
 #include "graphics/pixelformat.h"
 #include "graphics/palette.h"
 #include "image/codecs/codec.h"
@@ -52,7 +53,7 @@ private:
 	Graphics::Surface *_surface;
 	Graphics::Palette _ditherPalette;
 	bool _dirtyPalette;
-	byte *_colorMap;
+	Common::SharedPtr<byte> _colorMap;
 	uint16 _width, _height;
 	uint16 _blockWidth, _blockHeight;
 };
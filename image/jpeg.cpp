@@ -30,6 +30,7 @@
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/util.h"
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 
 #ifdef USE_JPEG
@@ -244,10 +245,25 @@ J_COLOR_SPACE fromScummvmPixelFormat(const Graphics::PixelFormat &format) {
 #endif
 
 bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
+	return decode(stream, nullptr, 0, 0);
+}
+
+bool JPEGDecoder::loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst, int x, int y) {
+	return decode(stream, &dst, x, y);
+}
+
+bool JPEGDecoder::decode(Common::SeekableReadStream &stream, Graphics::Surface *dst, int dstX, int dstY) {
 #ifdef USE_JPEG
 	// Reset member variables from previous decodings
 	destroy();
 
+	// The format the decoded image ends up in
+	const Graphics::PixelFormat outputPixelFormat = dst ? dst->format : _requestedPixelFormat;
+	if (_colorSpace == kColorSpaceRGB && outputPixelFormat.isCLUT8())
+		return false;
+	if (_colorSpace == kColorSpaceYUV && dst && dst->format.bytesPerPixel != 3)
+		return false;
+
 	jpeg_decompress_struct cinfo;
 	jpeg_error_mgr_ext jerr;
 	jerr.jmp_valid = false;
@@ -281,7 +297,7 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// We can request YUV output because Groovie requires it
 	switch (_colorSpace) {
 	case kColorSpaceRGB: {
-		J_COLOR_SPACE colorSpace = fromScummvmPixelFormat(_requestedPixelFormat);
+		J_COLOR_SPACE colorSpace = fromScummvmPixelFormat(outputPixelFormat);
 
 		if (colorSpace == JCS_UNKNOWN) {
 			// When libjpeg-turbo is not available or an unhandled pixel
@@ -331,53 +347,78 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		return false;
 	}
 
-	// Allocate buffers for the output data
+	// Determine the format of the scanlines produced by libjpeg
+	Graphics::PixelFormat scanlineFormat;
 	switch (_colorSpace) {
-	case kColorSpaceRGB: {
-		Graphics::PixelFormat outputPixelFormat;
+	case kColorSpaceRGB:
 		if (cinfo.out_color_space == JCS_RGB) {
-			outputPixelFormat = getByteOrderRgbPixelFormat();
+			scanlineFormat = getByteOrderRgbPixelFormat();
 		} else {
-			outputPixelFormat = _requestedPixelFormat;
+			scanlineFormat = outputPixelFormat;
 		}
-		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
 		break;
-	}
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		scanlineFormat = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
 		break;
 	default:
 		break;
 	}
+
 	// Size of output pixel must match 4 bytes.
-	if (cinfo.out_color_space == JCS_CMYK) {
-		assert(_surface.format.bytesPerPixel == 4);
+	if (cinfo.out_color_space == JCS_CMYK && scanlineFormat.bytesPerPixel != 4) {
+		jpeg_destroy_decompress(&cinfo);
+		return false;
 	}
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= (int)pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	// Scanlines which are already in the final format are decoded straight
+	// into the target surface. Everything else is converted band by band.
+	const bool direct = _colorSpace == kColorSpaceYUV || scanlineFormat == outputPixelFormat;
+
+	Graphics::Surface *target = dst;
+	if (!target) {
+		_surface.create(cinfo.output_width, cinfo.output_height, direct ? scanlineFormat : outputPixelFormat);
+		target = &_surface;
+		dstX = dstY = 0;
+	} else if (dstX < 0 || dstY < 0 || dstX + cinfo.output_width > (JDIMENSION)dst->w || dstY + cinfo.output_height > (JDIMENSION)dst->h) {
+		jpeg_destroy_decompress(&cinfo);
+		return false;
+	}
 
-	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
+	if (direct) {
+		JSAMPROW rows[kBandHeight];
 
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+		// Go through the image data band by band
+		while (cinfo.output_scanline < cinfo.output_height) {
+			JDIMENSION count = MIN<JDIMENSION>(kBandHeight, cinfo.output_height - cinfo.output_scanline);
+			for (JDIMENSION i = 0; i < count; i++)
+				rows[i] = (JSAMPROW)target->getBasePtr(dstX, dstY + cinfo.output_scanline + i);
 
-		memcpy(dst, buffer[0], pitch);
+			jpeg_read_scanlines(&cinfo, rows, count);
+		}
+	} else {
+		// Allocate buffer for one band of scanlines
+		JDIMENSION pitch = cinfo.output_width * scanlineFormat.bytesPerPixel;
+		JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, kBandHeight);
+
+		// Go through the image data band by band
+		while (cinfo.output_scanline < cinfo.output_height) {
+			JDIMENSION first = cinfo.output_scanline;
+			JDIMENSION count = jpeg_read_scanlines(&cinfo, buffer, kBandHeight);
+
+			for (JDIMENSION i = 0; i < count; i++) {
+				byte *dstPtr = (byte *)target->getBasePtr(dstX, dstY + first + i);
+				Graphics::crossBlit(dstPtr, buffer[i], target->pitch, pitch, cinfo.output_width, 1,
+					outputPixelFormat, scanlineFormat);
+			}
+		}
 	}
 
 	// We are done with decompressing, thus free all the data
 	jpeg_finish_decompress(&cinfo);
 	jpeg_destroy_decompress(&cinfo);
 
-	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
-		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
-	}
-
 	return true;
 #else
 	return false;
@@ -104,7 +104,30 @@ public:
 	 */
 	void setOutputColorSpace(ColorSpace outSpace) { _colorSpace = outSpace; }
 
+	/**
+	 * Decode an image straight into a caller-owned surface.
+	 *
+	 * The scanlines are written in the pixel format of @p dst at the given
+	 * position. When libjpeg can produce that format itself they are decoded
+	 * in place, otherwise they are converted in small bands. getSurface()
+	 * returns an empty surface afterwards.
+	 *
+	 * @param stream  Input stream.
+	 * @param dst     Surface which receives the image. It must be large enough
+	 *                and, in YUV mode, use 3 bytes per pixel.
+	 * @param x       Left edge of the image in @p dst.
+	 * @param y       Top edge of the image in @p dst.
+	 *
+	 * @return Whether decoding the image succeeded.
+	 */
+	bool loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst, int x = 0, int y = 0);
+
 private:
+	/** Number of scanlines decoded at once. */
+	static const int kBandHeight = 16;
+
+	bool decode(Common::SeekableReadStream &stream, Graphics::Surface *dst, int dstX, int dstY);
+
 	// TODO: Avoid inheriting from multiple superclasses that have identical member functions.
 	using Codec::getPalette;
 	Graphics::Surface _surface;
@@ -12,6 +12,7 @@ MODULE_OBJS := \
 	pcx.o \
 	pict.o \
 	png.o \
+	preloader.o \
 	scr.o \
 	tga.o \
 	xbm.o \
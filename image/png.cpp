@@ -30,6 +30,7 @@
 
 #include "image/png.h"
 
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -109,6 +110,14 @@ void pngFlushStream(png_structp pngPtr) {
  */
 
 bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
+	return decode(stream, nullptr, 0, 0);
+}
+
+bool PNGDecoder::loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst, int x, int y) {
+	return decode(stream, &dst, x, y);
+}
+
+bool PNGDecoder::decode(Common::SeekableReadStream &stream, Graphics::Surface *dst, int dstX, int dstY) {
 #ifdef USE_PNG
 	destroy();
 
@@ -150,69 +159,54 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// No handling for unknown chunks yet.
 	int bitDepth, colorType, width, height, interlaceType;
 	png_uint_32 w, h;
-	uint32 rgbaPalette[256];
+	png_colorp palette = nullptr;
+	int numPalette = 0;
+	png_bytep trans = nullptr;
+	int numTrans = 0;
 	bool hasRgbaPalette = false;
 
 	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, &interlaceType, NULL, NULL);
 	width = w;
 	height = h;
 
-	// Allocate memory for the final image data.
-	// To keep memory framentation low this happens before allocating memory for temporary image data.
-	_outputSurface = new Graphics::Surface();
-
-	// Images of all color formats except PNG_COLOR_TYPE_PALETTE
-	// will be transformed into ARGB images
-	if (colorType == PNG_COLOR_TYPE_PALETTE && (_keepTransparencyPaletted || !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))) {
-		int numPalette = 0;
-		png_colorp palette = NULL;
-		png_bytep trans = nullptr;
-		int numTrans = 0;
+	// The format libpng hands out rows in. Images of all color formats
+	// except PNG_COLOR_TYPE_PALETTE will be transformed into RGB(A) rows
+	Graphics::PixelFormat rowFormat;
 
+	if (colorType == PNG_COLOR_TYPE_PALETTE) {
 		uint32 success = png_get_PLTE(pngPtr, infoPtr, &palette, &numPalette);
 		if (success != PNG_INFO_PLTE) {
 			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
 			return false;
 		}
 
-		_palette.resize(numPalette, false);
-		for (int i = 0; i < numPalette; i++) {
-			_palette.set(i, palette[i].red, palette[i].green, palette[i].blue);
-		}
-
 		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
 			png_color_16p transColor;
 			png_get_tRNS(pngPtr, infoPtr, &trans, &numTrans, &transColor);
 
-			if (numTrans == 1) {
+			if (numTrans == 1 && _keepTransparencyPaletted) {
 				// For a single transparency color, the alpha should be fully transparent
 				assert(*trans == 0);
 				_hasTransparentColor = true;
 				_transparentColor = 0;
 			} else {
-				// Multiple alphas are being specified for the palette, so we can't use
-				// _transparentColor, and will instead need to build an RGBA surface
-				assert(numTrans > 1);
+				// Multiple alphas are being specified for the palette, or the
+				// caller does not want paletted images with transparency, so we
+				// can't use _transparentColor, and will instead need to build
+				// an RGBA surface
 				hasRgbaPalette = true;
 			}
 		}
 
-		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : Graphics::PixelFormat::createFormatCLUT8());
-		png_set_packing(pngPtr);
-
-		if (hasRgbaPalette) {
-			// Build up the RGBA palette using the transparency alphas
-			Common::fill(&rgbaPalette[0], &rgbaPalette[256], 0);
-			for (int i = 0; i < numPalette; ++i) {
-				byte a = (i < numTrans) ? trans[i] : 0xff;
-				rgbaPalette[i] = _outputSurface->format.ARGBToColor(
-					a, palette[i].red, palette[i].green, palette[i].blue);
+		if (!hasRgbaPalette) {
+			_palette.resize(numPalette, false);
+			for (int i = 0; i < numPalette; i++) {
+				_palette.set(i, palette[i].red, palette[i].green, palette[i].blue);
 			}
-
-			// We won't be needing a separate palette
-			_palette.clear();
 		}
+
+		rowFormat = Graphics::PixelFormat::createFormatCLUT8();
+		png_set_packing(pngPtr);
 	} else {
  		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
 		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
@@ -220,10 +214,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat(isAlpha));
-		if (!_outputSurface->getPixels()) {
-			error("Could not allocate memory for output image.");
-		}
+		rowFormat = getByteOrderRgbaPixelFormat(isAlpha);
 		if (bitDepth == 16)
 			png_set_strip_16(pngPtr);
 		if (bitDepth < 8)
@@ -233,36 +224,77 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_gray_to_rgb(pngPtr);
 	}
 
-	// After the transformations have been registered, the image data is read again.
-	png_set_interlace_handling(pngPtr);
-	png_read_update_info(pngPtr, infoPtr);
-	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, NULL, NULL, NULL);
-	width = w;
-	height = h;
+	// Pick the format the final image is stored in: the caller's surface,
+	// the requested output format, or the natural format of the image.
+	Graphics::PixelFormat outFormat;
+	if (dst)
+		outFormat = dst->format;
+	else if (_outputPixelFormat.bytesPerPixel != 0)
+		outFormat = _outputPixelFormat;
+	else if (hasRgbaPalette)
+		outFormat = getByteOrderRgbaPixelFormat(true);
+	else
+		outFormat = rowFormat;
 
-	if (hasRgbaPalette) {
-		// Build up the RGBA surface from paletted rows
-		png_bytep rowPtr = new byte[width];
-		if (!rowPtr)
-			error("Could not allocate memory for row.");
+	// Paletted output is only possible from paletted images
+	if (outFormat.isCLUT8() && !(rowFormat.isCLUT8() && !hasRgbaPalette)) {
+		if (!dst && _outputPixelFormat.bytesPerPixel != 0) {
+			outFormat = hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : rowFormat;
+		} else {
+			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+			return false;
+		}
+	}
 
-		for (int yp = 0; yp < height; ++yp) {
-			png_read_row(pngPtr, rowPtr, nullptr);
-			uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
+	if (dst && (dstX < 0 || dstY < 0 || dstX + width > dst->w || dstY + height > dst->h)) {
+		png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+		return false;
+	}
 
-			for (int xp = 0; xp < width; ++xp)
-				destRowP[xp] = rgbaPalette[rowPtr[xp]];
+	// Paletted rows going into a true color image are converted through a map
+	uint32 paletteMap[256];
+	bool useMap = rowFormat.isCLUT8() && !outFormat.isCLUT8();
+	if (useMap) {
+		Common::fill(&paletteMap[0], &paletteMap[256], 0);
+		for (int i = 0; i < numPalette; ++i) {
+			byte a = (i < numTrans) ? trans[i] : 0xff;
+			if (!hasRgbaPalette && _hasTransparentColor && i == (int)_transparentColor)
+				a = 0;
+			paletteMap[i] = outFormat.ARGBToColor(a, palette[i].red, palette[i].green, palette[i].blue);
 		}
 
-		delete[] rowPtr;
-	} else  if (interlaceType == PNG_INTERLACE_NONE) {
-		// PNGs without interlacing can simply be read row by row.
-		for (int i = 0; i < height; i++) {
-			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+		// We won't be needing a separate palette
+		_palette.clear();
+		_hasTransparentColor = false;
+	}
+
+	Graphics::Surface *target = dst;
+	if (!target) {
+		// Allocate memory for the final image data.
+		// To keep memory framentation low this happens before allocating memory for temporary image data.
+		_outputSurface = new Graphics::Surface();
+		_outputSurface->create(width, height, outFormat);
+		if (!_outputSurface->getPixels()) {
+			error("Could not allocate memory for output image.");
 		}
-	} else {
-		// PNGs with interlacing require us to allocate an auxiliary
-		// buffer with pointers to all row starts.
+		target = _outputSurface;
+		dstX = dstY = 0;
+	}
+
+	// After the transformations have been registered, the image data is read again.
+	int passes = png_set_interlace_handling(pngPtr);
+	png_read_update_info(pngPtr, infoPtr);
+
+	const bool direct = !useMap && rowFormat == outFormat;
+	const uint rowPitch = width * rowFormat.bytesPerPixel;
+
+	if (passes > 1) {
+		// PNGs with interlacing require us to provide storage for the whole
+		// image at once, so they are decoded into the target when the rows
+		// can be used as they are and converted in a single step otherwise.
+		Graphics::Surface tmp;
+		if (!direct)
+			tmp.create(width, height, rowFormat);
 
 		// Allocate row pointer buffer
 		png_bytep *rowPtr = new png_bytep[height];
@@ -272,13 +304,39 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		// Initialize row pointers
 		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+			rowPtr[i] = direct ? (png_bytep)target->getBasePtr(dstX, dstY + i) : (png_bytep)tmp.getBasePtr(0, i);
 
 		// Read image data
 		png_read_image(pngPtr, rowPtr);
 
 		// Free row pointer buffer
 		delete[] rowPtr;
+
+		if (!direct)
+			convertRows(*target, dstX, dstY, (const byte *)tmp.getPixels(), tmp.pitch, width, height, rowFormat, useMap ? paletteMap : nullptr);
+		tmp.free();
+	} else if (direct) {
+		// PNGs without interlacing can simply be read row by row.
+		for (int i = 0; i < height; i++) {
+			png_read_row(pngPtr, (png_bytep)target->getBasePtr(dstX, dstY + i), NULL);
+		}
+	} else {
+		// Otherwise rows are streamed through a small band buffer and
+		// converted into the target format as soon as the band is full,
+		// so that no full size intermediate image is ever needed.
+		byte *band = new byte[rowPitch * kBandHeight];
+		if (!band)
+			error("Could not allocate memory for row band.");
+
+		for (int yp = 0; yp < height; yp += kBandHeight) {
+			int rows = MIN<int>(kBandHeight, height - yp);
+			for (int i = 0; i < rows; ++i)
+				png_read_row(pngPtr, band + i * rowPitch, nullptr);
+
+			convertRows(*target, dstX, dstY + yp, band, rowPitch, width, rows, rowFormat, useMap ? paletteMap : nullptr);
+		}
+
+		delete[] band;
 	}
 
 	// Read additional data at the end.
@@ -293,6 +351,15 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #endif
 }
 
+void PNGDecoder::convertRows(Graphics::Surface &dst, int x, int y, const byte *src, uint srcPitch, int w, int h,
+		const Graphics::PixelFormat &srcFormat, const uint32 *map) const {
+	byte *dstPtr = (byte *)dst.getBasePtr(x, y);
+	if (map)
+		Graphics::crossBlitMap(dstPtr, src, dst.pitch, srcPitch, w, h, dst.format.bytesPerPixel, map);
+	else
+		Graphics::crossBlit(dstPtr, src, dst.pitch, srcPitch, w, h, dst.format, srcFormat);
+}
+
 bool writePNG(Common::WriteStream &out, const Graphics::Surface &input, const Graphics::Palette &palette) {
 	return writePNG(out, input, palette.data(), palette.size());
 }
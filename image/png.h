@@ -67,7 +67,40 @@ public:
 	uint32 getTransparentColor() const override { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request the pixel format loadStream() stores the image in.
+	 *
+	 * The rows are converted while they are decoded, so no second pass over
+	 * the image is needed. Requesting CLUT8 keeps paletted images paletted
+	 * and leaves true color images in their natural format.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputPixelFormat = format; }
+
+	/**
+	 * Decode an image straight into a caller-owned surface.
+	 *
+	 * The image is converted into the pixel format of @p dst on the fly and
+	 * written at the given position, without allocating a surface of its own.
+	 * getSurface() returns nullptr afterwards. A CLUT8 surface can only
+	 * receive paletted images; the palette is available through getPalette().
+	 *
+	 * @param stream  Input stream.
+	 * @param dst     Surface which receives the image. It must be large enough.
+	 * @param x       Left edge of the image in @p dst.
+	 * @param y       Top edge of the image in @p dst.
+	 *
+	 * @return Whether decoding the image succeeded.
+	 */
+	bool loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst, int x = 0, int y = 0);
+
 private:
+	/** Number of rows converted at once when the output format differs from the decoded one. */
+	static const int kBandHeight = 16;
+
+	bool decode(Common::SeekableReadStream &stream, Graphics::Surface *dst, int dstX, int dstY);
+	void convertRows(Graphics::Surface &dst, int x, int y, const byte *src, uint srcPitch, int w, int h,
+		const Graphics::PixelFormat &srcFormat, const uint32 *map) const;
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat(bool isAlpha) const;
 
 	Graphics::Palette _palette;
@@ -80,6 +113,9 @@ private:
 	bool _hasTransparentColor;
 	uint32 _transparentColor;
 
+	// Requested output format, or a null format for the natural format of the image
+	Graphics::PixelFormat _outputPixelFormat;
+
 	Graphics::Surface *_outputSurface;
 };
 
@@ -0,0 +1,291 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "image/preloader.h"
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/timer.h"
+
+#include "image/jpeg.h"
+#include "image/png.h"
+
+namespace Image {
+
+ImagePreloader::ImagePreloader(const Graphics::PixelFormat &format) :
+		_format(format),
+		_background(false) {
+}
+
+ImagePreloader::~ImagePreloader() {
+	stopBackground();
+	clear();
+}
+
+bool ImagePreloader::preload(const Common::Path &path) {
+	Common::SeekableReadStream *stream = SearchMan.createReadStreamForMember(path);
+	if (!stream)
+		return false;
+
+	Request request;
+	request.path = path;
+	request.stream = stream;
+	request.data = nullptr;
+	request.size = 0;
+	request.buffered = 0;
+	request.complete = false;
+
+	Common::StackLock lock(_mutex);
+	_queue.push_back(request);
+	return true;
+}
+
+bool ImagePreloader::startBackground(int32 interval) {
+	if (!_background)
+		_background = g_system->getTimerManager()->installTimerProc(&timerProc, interval, this, "imagePreloader");
+	return _background;
+}
+
+void ImagePreloader::stopBackground() {
+	if (!_background)
+		return;
+
+	// This also waits for a running callback to finish
+	g_system->getTimerManager()->removeTimerProc(&timerProc);
+	_background = false;
+}
+
+void ImagePreloader::timerProc(void *refCon) {
+	ImagePreloader *preloader = (ImagePreloader *)refCon;
+	preloader->readAhead();
+}
+
+void ImagePreloader::claim(const Common::Path &path) {
+	// Called with _mutex held and nothing in progress, so only a waiter
+	// passing through waitForWork() can hold _workMutex right now
+	_workMutex.lock();
+	_inProgress = path;
+}
+
+void ImagePreloader::release() {
+	_inProgress.clear();
+	_workMutex.unlock();
+}
+
+void ImagePreloader::waitForWork() {
+	Common::StackLock wait(_workMutex);
+}
+
+void ImagePreloader::readAhead() {
+	Request *request = nullptr;
+
+	{
+		Common::StackLock lock(_mutex);
+
+		// Someone is decoding or reading, try again on the next tick
+		if (!_inProgress.empty())
+			return;
+
+		for (Common::List<Request>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
+			if (!i->complete) {
+				request = &*i;
+				break;
+			}
+		}
+		if (!request)
+			return;
+
+		claim(request->path);
+	}
+
+	// The request stays queued, but nobody touches it until release()
+	if (!request->data) {
+		int64 size = request->stream->size();
+		if (size > 0 && size < 0x7FFFFFFF)
+			request->data = (byte *)malloc(size);
+		if (request->data) {
+			request->size = (uint32)size;
+			request->stream->seek(0);
+		} else {
+			request->complete = true;
+		}
+	}
+
+	if (request->data) {
+		uint32 chunk = MIN<uint32>(kReadAheadChunk, request->size - request->buffered);
+		uint32 read = request->stream->read(request->data + request->buffered, chunk);
+		request->buffered += read;
+
+		if (read < chunk || request->stream->err()) {
+			// Leave it to the decoder to report the error
+			free(request->data);
+			request->data = nullptr;
+			request->complete = true;
+		} else if (request->buffered == request->size) {
+			delete request->stream;
+			request->stream = new Common::MemoryReadStream(request->data, request->size, DisposeAfterUse::YES);
+			request->data = nullptr;
+			request->complete = true;
+		}
+	}
+
+	Common::StackLock lock(_mutex);
+	release();
+}
+
+void ImagePreloader::pump(uint32 maxMillis) {
+	uint32 start = g_system->getMillis();
+	while (decodeNext()) {
+		if (g_system->getMillis() - start >= maxMillis)
+			break;
+	}
+}
+
+ImageDecoder *ImagePreloader::take(const Common::Path &path) {
+	for (;;) {
+		Request request;
+		bool found = false;
+
+		{
+			Common::StackLock lock(_mutex);
+
+			DecoderMap::iterator decoded = _decoded.find(path);
+			if (decoded != _decoded.end()) {
+				ImageDecoder *decoder = decoded->_value;
+				_decoded.erase(decoded);
+				return decoder;
+			}
+
+			if (!_inProgress.equalsIgnoreCase(path)) {
+				for (Common::List<Request>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
+					if (i->path.equalsIgnoreCase(path)) {
+						request = *i;
+						_queue.erase(i);
+						found = true;
+						break;
+					}
+				}
+
+				if (!found)
+					return nullptr;
+			}
+		}
+
+		if (found) {
+			// Not started yet, so the caller has to wait for it anyway
+			return decode(request);
+		}
+
+		// Someone else is busy with this very image
+		waitForWork();
+	}
+}
+
+void ImagePreloader::clear() {
+	for (;;) {
+		{
+			Common::StackLock lock(_mutex);
+			if (_inProgress.empty()) {
+				for (Common::List<Request>::iterator i = _queue.begin(); i != _queue.end(); ++i) {
+					delete i->stream;
+					free(i->data);
+				}
+				_queue.clear();
+
+				for (DecoderMap::iterator i = _decoded.begin(); i != _decoded.end(); ++i)
+					delete i->_value;
+				_decoded.clear();
+				return;
+			}
+		}
+
+		waitForWork();
+	}
+}
+
+bool ImagePreloader::decodeNext() {
+	Request request;
+
+	for (;;) {
+		{
+			Common::StackLock lock(_mutex);
+			if (_queue.empty())
+				return false;
+
+			if (_inProgress.empty()) {
+				request = _queue.front();
+				_queue.pop_front();
+				claim(request.path);
+				break;
+			}
+		}
+
+		waitForWork();
+	}
+
+	ImageDecoder *decoder = decode(request);
+
+	Common::StackLock lock(_mutex);
+	// Failed images are remembered as well, so take() does not wait for them
+	_decoded[request.path] = decoder;
+	release();
+	return true;
+}
+
+ImageDecoder *ImagePreloader::decode(Request &request) const {
+	// A partial read-ahead is of no use to the decoders
+	free(request.data);
+	request.data = nullptr;
+
+	Common::SeekableReadStream *stream = request.stream;
+	request.stream = nullptr;
+
+	stream->seek(0);
+	uint16 magic = stream->readUint16BE();
+	stream->seek(0);
+
+	ImageDecoder *decoder;
+	if (magic == 0x8950) {
+		PNGDecoder *png = new PNGDecoder();
+		png->setOutputPixelFormat(_format);
+		decoder = png;
+	} else if (magic == 0xFFD8) {
+		JPEGDecoder *jpeg = new JPEGDecoder();
+		if (!_format.isCLUT8())
+			jpeg->setOutputPixelFormat(_format);
+		decoder = jpeg;
+	} else {
+		delete stream;
+		return nullptr;
+	}
+
+	if (!decoder->loadStream(*stream)) {
+		delete decoder;
+		decoder = nullptr;
+	}
+
+	delete stream;
+	return decoder;
+}
+
+} // End of namespace Image
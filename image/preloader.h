@@ -0,0 +1,152 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IMAGE_PRELOADER_H
+#define IMAGE_PRELOADER_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/path.h"
+#include "graphics/pixelformat.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Image {
+
+class ImageDecoder;
+
+/**
+ * @defgroup image_preloader Image preloader
+ * @ingroup image
+ *
+ * @brief Decodes PNG and JPEG images ahead of their use.
+ *
+ * Engines can queue the images they are about to need, for example the
+ * backgrounds of the next scene, and pick up the finished decoders later.
+ * Decoding happens through pump() from the engine's own idle loop, or in
+ * take() for images that are not ready yet. An optional timer callback
+ * reads the queued files into memory ahead of that, one bounded chunk per
+ * tick, so it never holds up the other timer procs for long.
+ *
+ * @{
+ */
+
+class ImagePreloader {
+public:
+	/**
+	 * @param format  Pixel format the images are decoded to. This is only a
+	 *                request, paletted PNG images stay paletted for CLUT8.
+	 */
+	ImagePreloader(const Graphics::PixelFormat &format);
+	~ImagePreloader();
+
+	/**
+	 * Queue an image for decoding.
+	 *
+	 * The file is opened immediately, only the decoding is deferred.
+	 *
+	 * @return False if the file could not be opened.
+	 */
+	bool preload(const Common::Path &path);
+
+	/**
+	 * Start reading queued files into memory from a timer callback.
+	 *
+	 * Only one preloader should read in the background at a time.
+	 *
+	 * @param interval  Interval between two chunks, in microseconds.
+	 */
+	bool startBackground(int32 interval = 10000);
+
+	/** Stop reading from the timer callback. */
+	void stopBackground();
+
+	/**
+	 * Decode queued images in the calling thread.
+	 *
+	 * @param maxMillis  Stop once this much time has been spent. At least one
+	 *                   image is decoded if any is pending.
+	 */
+	void pump(uint32 maxMillis);
+
+	/**
+	 * Take a decoded image.
+	 *
+	 * If the image has not been decoded yet, this is done right away.
+	 * The caller becomes the owner of the returned decoder.
+	 *
+	 * @return The decoder holding the image, or nullptr if the image was never
+	 *         queued or could not be decoded.
+	 */
+	ImageDecoder *take(const Common::Path &path);
+
+	/** Drop all pending and decoded images. */
+	void clear();
+
+private:
+	struct Request {
+		Common::Path path;
+		Common::SeekableReadStream *stream;
+		byte *data;			///< Read-ahead buffer, until the whole file is in
+		uint32 size;
+		uint32 buffered;
+		bool complete;		///< Nothing left to read ahead
+	};
+
+	/** Bytes read ahead by the timer callback per tick. */
+	static const uint32 kReadAheadChunk = 64 * 1024;
+
+	typedef Common::HashMap<Common::Path, ImageDecoder *, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> DecoderMap;
+
+	static void timerProc(void *refCon);
+
+	/** Read the next chunk of the first queued file not in memory yet. */
+	void readAhead();
+	/** Decode the next queued image. Returns false if there was none. */
+	bool decodeNext();
+	ImageDecoder *decode(Request &request) const;
+
+	/**
+	 * Mark @p path as being worked on outside _mutex, which must be held.
+	 * Whoever needs the same request waits on _workMutex until release().
+	 */
+	void claim(const Common::Path &path);
+	void release();
+	/** Block until the current claim is released. _mutex must not be held. */
+	void waitForWork();
+
+	Graphics::PixelFormat _format;
+	Common::Mutex _mutex;
+	Common::Mutex _workMutex;
+	Common::List<Request> _queue;
+	DecoderMap _decoded;
+	Common::Path _inProgress;
+	bool _background;
+};
+
+/** @} */
+
+} // End of namespace Image
+
+#endif
@@ -0,0 +1,72 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+
+struct ArenaTestObject {
+	ArenaTestObject(int a, int b) : sum(a + b) {}
+	int sum;
+};
+
+class ArenaTestSuite : public CxxTest::TestSuite {
+public:
+	void test_alignment() {
+		Common::Arena arena(256);
+
+		byte *a = (byte *)arena.allocate(3, 1);
+		byte *b = (byte *)arena.allocate(8, 8);
+		byte *c = (byte *)arena.allocate(1);
+
+		TS_ASSERT(a);
+		TS_ASSERT_EQUALS((uintptr)b % 8, 0u);
+		TS_ASSERT_EQUALS((uintptr)c % Common::Arena::kDefaultAlignment, 0u);
+		TS_ASSERT_LESS_THAN_EQUALS(a + 3, b);
+
+		ArenaTestObject *obj = arena.create<ArenaTestObject>(2, 3);
+		TS_ASSERT_EQUALS(obj->sum, 5);
+		TS_ASSERT_EQUALS(arena.getStats().allocations, 4u);
+	}
+
+	void test_growth_and_reset() {
+		Common::Arena arena(128);
+
+		for (int i = 0; i < 10; i++)
+			arena.allocate(64);
+		// Larger than a chunk
+		arena.allocate(1000);
+
+		const Common::Arena::Stats &stats = arena.getStats();
+		TS_ASSERT_LESS_THAN(1u, stats.chunkAllocations);
+		TS_ASSERT_EQUALS(stats.bytesUsed, 1640u);
+
+		// After a reset, the same workload fits in a single chunk
+		arena.reset();
+		TS_ASSERT_EQUALS(stats.bytesUsed, 0u);
+		TS_ASSERT_EQUALS(stats.peakBytesUsed, 1640u);
+		uint32 chunks = stats.chunkAllocations;
+
+		for (int i = 0; i < 10; i++)
+			arena.allocate(64);
+		arena.allocate(1000);
+		TS_ASSERT_EQUALS(stats.chunkAllocations, chunks);
+		TS_ASSERT_EQUALS(stats.resets, 1u);
+	}
+
+	void test_scope() {
+		Common::Arena arena(128);
+		void *first = arena.allocate(16);
+
+		{
+			Common::ArenaScope scope(arena);
+			for (int i = 0; i < 20; i++)
+				arena.allocate(32);
+			TS_ASSERT_EQUALS(arena.getStats().bytesUsed, 656u);
+		}
+
+		TS_ASSERT_EQUALS(arena.getStats().bytesUsed, 16u);
+		TS_ASSERT_EQUALS(arena.getStats().capacity, 128u);
+
+		// Memory released by the scope is handed out again
+		void *second = arena.allocate(16);
+		TS_ASSERT_EQUALS((byte *)second, (byte *)first + 16);
+	}
+};
@@ -0,0 +1,93 @@
+#include "common/compression/deflate.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include <cxxtest/TestSuite.h>
+
+/**
+ * A test suite for random access into deflate streams returned by
+ * wrapSeekableDeflateReadStream().
+ */
+class SeekableDeflateTestSuite : public CxxTest::TestSuite {
+	enum {
+		kDataSize = 3 * 1024 * 1024 + 1234
+	};
+
+	byte *_data;
+	Common::MemoryWriteStreamDynamic *_deflated;
+
+	static uint32 nextRand(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+
+public:
+	void setUp() {
+		// Compressible, but irregular enough to produce many deflate blocks
+		_data = new byte[kDataSize];
+		uint32 seed = 1;
+		for (uint32 i = 0; i < kDataSize; i++)
+			_data[i] = (nextRand(seed) % 16) + (i / 4096) % 7;
+
+		// Produce raw deflate data by stripping the gzip header and footer
+		Common::MemoryWriteStreamDynamic *gzipped = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Common::WriteStream *compressor = Common::wrapCompressedWriteStream(gzipped);
+		compressor->write(_data, kDataSize);
+		compressor->finalize();
+
+		_deflated = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		_deflated->write(gzipped->getData() + 10, gzipped->size() - 10 - 8);
+
+		// The compressing stream owns the one it wraps
+		delete compressor;
+	}
+
+	void tearDown() {
+		delete[] _data;
+		delete _deflated;
+	}
+
+	void test_sequential_then_random_access() {
+#ifdef USE_ZLIB
+		Common::ScopedPtr<Common::SeekableReadStream> stream(Common::wrapSeekableDeflateReadStream(
+			new Common::MemoryReadStream(_deflated->getData(), _deflated->size()), DisposeAfterUse::YES, kDataSize));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), kDataSize);
+
+		byte *buf = new byte[kDataSize];
+		TS_ASSERT_EQUALS(stream->read(buf, kDataSize), (uint32)kDataSize);
+		TS_ASSERT_EQUALS(memcmp(buf, _data, kDataSize), 0);
+
+		// Backward and forward seeks, around checkpoints and in between
+		static const uint32 offsets[] = {
+			2 * 1024 * 1024 + 17, 5, 1024 * 1024 - 1, kDataSize - 100,
+			1024 * 1024 + 4095, 3 * 1024 * 1024, 0, 1500000, 2900000
+		};
+		for (uint i = 0; i < ARRAYSIZE(offsets); i++) {
+			uint32 len = MIN<uint32>(4096, kDataSize - offsets[i]);
+			TS_ASSERT(stream->seek(offsets[i]));
+			TS_ASSERT_EQUALS(stream->pos(), offsets[i]);
+			TS_ASSERT_EQUALS(stream->read(buf, len), len);
+			TS_ASSERT_EQUALS(memcmp(buf, _data + offsets[i], len), 0);
+		}
+
+		delete[] buf;
+#endif
+	}
+
+	void test_seek_before_reading() {
+#ifdef USE_ZLIB
+		Common::ScopedPtr<Common::SeekableReadStream> stream(Common::wrapSeekableDeflateReadStream(
+			new Common::MemoryReadStream(_deflated->getData(), _deflated->size()), DisposeAfterUse::YES, kDataSize));
+
+		// Nothing has been indexed yet, this has to decompress up to there
+		byte buf[256];
+		TS_ASSERT(stream->seek(2500000));
+		TS_ASSERT_EQUALS(stream->read(buf, sizeof(buf)), sizeof(buf));
+		TS_ASSERT_EQUALS(memcmp(buf, _data + 2500000, sizeof(buf)), 0);
+
+		TS_ASSERT(stream->seek(1200000));
+		TS_ASSERT_EQUALS(stream->read(buf, sizeof(buf)), sizeof(buf));
+		TS_ASSERT_EQUALS(memcmp(buf, _data + 1200000, sizeof(buf)), 0);
+#endif
+	}
+};
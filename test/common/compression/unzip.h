@@ -0,0 +1,137 @@
+#include "common/archive.h"
+#include "common/compression/unzip.h"
+#include "common/crc.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include <cxxtest/TestSuite.h>
+
+#include "../../system/null_osystem.h"
+
+/**
+ * A test suite for ZIP members large enough to be decompressed on the fly
+ * instead of being extracted to memory.
+ */
+class StreamedZipMemberTestSuite : public CxxTest::TestSuite {
+	enum {
+		// At least the streaming threshold of ZipArchive
+		kDataSize = 4 * 1024 * 1024 + 1234,
+		kHeaderSize = 30 + 7 // Local file header, followed by "big.bin"
+	};
+
+	byte *_data;
+
+	// Build a ZIP file with a single stored member, so that its data can
+	// be damaged at a known position
+	Common::SeekableReadStream *createZip(uint32 damagedOffset) {
+		Common::CRC32 crc;
+		uint32 crcValue = crc.crcFast(_data, kDataSize);
+
+		Common::MemoryWriteStreamDynamic zip(DisposeAfterUse::NO);
+		zip.writeUint32LE(0x04034b50);
+		zip.writeUint16LE(20);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint32LE(0);
+		zip.writeUint32LE(crcValue);
+		zip.writeUint32LE(kDataSize);
+		zip.writeUint32LE(kDataSize);
+		zip.writeUint16LE(7);
+		zip.writeUint16LE(0);
+		zip.write("big.bin", 7);
+		zip.write(_data, kDataSize);
+
+		uint32 centralDirOffset = zip.pos();
+		zip.writeUint32LE(0x02014b50);
+		zip.writeUint16LE(20);
+		zip.writeUint16LE(20);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint32LE(0);
+		zip.writeUint32LE(crcValue);
+		zip.writeUint32LE(kDataSize);
+		zip.writeUint32LE(kDataSize);
+		zip.writeUint16LE(7);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint32LE(0);
+		zip.writeUint32LE(0);
+		zip.write("big.bin", 7);
+
+		uint32 centralDirSize = zip.pos() - centralDirOffset;
+		zip.writeUint32LE(0x06054b50);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(1);
+		zip.writeUint16LE(1);
+		zip.writeUint32LE(centralDirSize);
+		zip.writeUint32LE(centralDirOffset);
+		zip.writeUint16LE(0);
+
+		if (damagedOffset < kDataSize)
+			zip.getData()[kHeaderSize + damagedOffset] ^= 0xff;
+
+		return new Common::MemoryReadStream(zip.getData(), zip.size(), DisposeAfterUse::YES);
+	}
+
+public:
+	void setUp() {
+		// The archive contents cache is guarded by a mutex
+		Common::install_null_g_system();
+
+		_data = new byte[kDataSize];
+		for (uint32 i = 0; i < kDataSize; i++)
+			_data[i] = (i * 7) ^ (i >> 9);
+	}
+
+	void tearDown() {
+		delete[] _data;
+		Common::uninstall_null_g_system();
+	}
+
+	void test_stream_outlives_archive() {
+		Common::Archive *archive = Common::makeZipArchive(createZip(kDataSize));
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember("big.bin"));
+		delete archive;
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), kDataSize);
+
+		byte *buffer = new byte[kDataSize];
+		TS_ASSERT_EQUALS(stream->read(buffer, kDataSize), (uint32)kDataSize);
+		TS_ASSERT_EQUALS(memcmp(buffer, _data, kDataSize), 0);
+		delete[] buffer;
+
+		TS_ASSERT(!stream->err());
+	}
+
+	void test_crc_mismatch() {
+		Common::ScopedPtr<Common::Archive> archive(Common::makeZipArchive(createZip(kDataSize / 2)));
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember("big.bin"));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		// Data read after seeking forward is only checked once reached in order
+		byte buffer[4096];
+		stream->seek(kDataSize / 2);
+		stream->read(buffer, sizeof(buffer));
+		TS_ASSERT(!stream->err());
+
+		stream->seek(0);
+		while (!stream->eos())
+			stream->read(buffer, sizeof(buffer));
+		TS_ASSERT(stream->err());
+	}
+};
@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/system.h"
+
+class ConfigManagerTestSuite : public CxxTest::TestSuite {
+	Common::String _saved;
+
+	static Common::String save() {
+		Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+		ConfMan.saveToStream(stream);
+		return Common::String((const char *)stream.getData(), stream.size());
+	}
+
+	static void load(const Common::String &contents) {
+		Common::MemoryReadStream stream((const byte *)contents.c_str(), contents.size());
+		ConfMan.loadFromStream(stream);
+	}
+
+	static Common::String makeConfig(int numDomains) {
+		Common::String config("[scummvm]\nversions=1\n\n");
+		for (int i = 0; i < numDomains; i++) {
+			config += Common::String::format("# game %d\n[game%d]\n", i, i);
+			config += Common::String::format("gameid=game%d\ndescription=Game number %d\n", i, i);
+			config += Common::String::format("path=/games/game%d\nlanguage=en\nplatform=pc\n\n", i);
+		}
+		return config;
+	}
+
+public:
+	void setUp() {
+		_saved = save();
+	}
+
+	void tearDown() {
+		load(_saved);
+	}
+
+	void test_round_trip() {
+		Common::String config = makeConfig(5000);
+		load(config);
+		TS_ASSERT(ConfMan.hasGameDomain("game4999"));
+
+		Common::String saved = save();
+		TS_ASSERT(saved.hasPrefix("[scummvm]\n"));
+		TS_ASSERT(saved.contains("# game 4999\n[game4999]\n"));
+
+		// Saving what was loaded back gives the same file
+		load(saved);
+		TS_ASSERT_EQUALS(save(), saved);
+	}
+
+	void test_modification_invalidates_cache() {
+		load(makeConfig(3));
+		Common::String before = save();
+
+		ConfMan.set("language", "de", "game1");
+		Common::String after = save();
+		TS_ASSERT_DIFFERS(before, after);
+		TS_ASSERT(after.contains("[game1]\n"));
+		TS_ASSERT(after.contains("language=de\n"));
+
+		ConfMan.set("language", "en", "game1");
+		TS_ASSERT_EQUALS(save(), before);
+
+		// Renamed domains take their entries along
+		ConfMan.renameGameDomain("game2", "renamed");
+		after = save();
+		TS_ASSERT(!after.contains("[game2]"));
+		TS_ASSERT(after.contains("[renamed]\n"));
+		TS_ASSERT(after.contains("path=/games/game2\n"));
+	}
+
+	void test_command_line_domains_are_skipped() {
+		load(makeConfig(2));
+		ConfMan.set("id_came_from_command_line", "1", "game0");
+		TS_ASSERT(!save().contains("[game0]"));
+	}
+
+	void test_save_benchmark() {
+#ifdef SLOW_TESTS
+		Common::String config = makeConfig(5000);
+
+		uint32 start = g_system->getMillis();
+		load(config);
+		uint32 loadTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		save();
+		uint32 firstSaveTime = g_system->getMillis() - start;
+
+		// Only the modified domain needs to be serialized again
+		ConfMan.set("language", "fr", "game2500");
+		start = g_system->getMillis();
+		for (int i = 0; i < 100; i++)
+			save();
+		uint32 saveTime = g_system->getMillis() - start;
+
+		debug("Loading 5000 domains: %u ms, first save: %u ms, 100 incremental saves: %u ms", loadTime, firstSaveTime, saveTime);
+#endif
+	}
+};
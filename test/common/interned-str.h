@@ -0,0 +1,63 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/hashmap.h"
+#include "common/interned-str.h"
+
+class InternedStringTestSuite : public CxxTest::TestSuite {
+public:
+	void test_identity() {
+		Common::AtomTable table;
+		Common::InternedString a = table.intern("foo");
+		Common::InternedString b = table.intern(Common::String("fo") + "o");
+		Common::InternedString c = table.intern("Foo");
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT_EQUALS(a.hash(), Common::String("foo").hash());
+		TS_ASSERT_EQUALS(a.toString(), "foo");
+		TS_ASSERT_EQUALS(table.size(), 2u);
+	}
+
+	void test_ignore_case() {
+		Common::AtomTable table(true);
+		Common::InternedString a = table.intern("PutProp");
+		Common::InternedString b = table.intern("putprop");
+
+		TS_ASSERT(a == b);
+		// The first spelling is kept
+		TS_ASSERT_EQUALS(b.toString(), "PutProp");
+		TS_ASSERT_EQUALS(table.size(), 1u);
+	}
+
+	void test_find() {
+		Common::AtomTable table;
+		table.intern("known");
+
+		TS_ASSERT(!table.find("known").isNull());
+		TS_ASSERT(table.find("unknown").isNull());
+		// Looking up does not add the string
+		TS_ASSERT_EQUALS(table.size(), 1u);
+
+		Common::InternedString null;
+		TS_ASSERT(null == table.find("unknown"));
+		TS_ASSERT_EQUALS(null.toString(), "");
+	}
+
+	void test_hashmap_key() {
+		Common::AtomTable table(true);
+		Common::HashMap<Common::InternedString, int> map;
+		map[table.intern("alpha")] = 1;
+		map[table.intern("beta")] = 2;
+
+		TS_ASSERT_EQUALS(map[table.intern("ALPHA")], 1);
+		TS_ASSERT(map.contains(table.find("Beta")));
+		TS_ASSERT(!map.contains(table.find("gamma")));
+	}
+
+	void test_default_table() {
+		Common::InternedString a("default-table-string");
+		Common::InternedString b(Common::String("default-table-string"));
+		TS_ASSERT(a == b);
+		TS_ASSERT(a == Common::AtomTable::getDefault().find("default-table-string"));
+	}
+};
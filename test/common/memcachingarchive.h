@@ -0,0 +1,115 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/config-manager.h"
+#include "common/stream.h"
+
+#include "../system/null_osystem.h"
+
+class TestMemcachingArchive : public Common::MemcachingCaseInsensitiveArchive {
+public:
+	TestMemcachingArchive() : reads(0) {}
+
+	bool hasFile(const Common::Path &path) const override { return true; }
+	int listMembers(Common::ArchiveMemberList &list) const override { return 0; }
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override { return Common::ArchiveMemberPtr(); }
+
+	Common::SharedArchiveContents readContentsForPath(const Common::Path &translatedPath) const override {
+		reads++;
+		// Each member is 512 bytes filled with the first character of its name
+		byte *data = new byte[512];
+		memset(data, translatedPath.toString()[0], 512);
+		return Common::SharedArchiveContents(data, 512);
+	}
+
+	mutable int reads;
+};
+
+class MemcachingArchiveTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+		// The cache is guarded by a mutex
+		Common::install_null_g_system();
+
+		// Room for two members
+		ConfMan.setInt("archive_cache_size", 1, Common::ConfigManager::kApplicationDomain);
+		Common::MemcachingCaseInsensitiveArchive::resetCacheStats();
+	}
+
+	void tearDown() {
+		ConfMan.removeKey("archive_cache_size", Common::ConfigManager::kApplicationDomain);
+		Common::uninstall_null_g_system();
+	}
+
+	void test_hits_and_misses() {
+		TestMemcachingArchive archive;
+
+		delete archive.createReadStreamForMember("a");
+		delete archive.createReadStreamForMember("A");
+		Common::SeekableReadStream *stream = archive.createReadStreamForMember("a");
+		TS_ASSERT_EQUALS(stream->readByte(), 'a');
+		delete stream;
+
+		TS_ASSERT_EQUALS(archive.reads, 1);
+
+		Common::ArchiveCacheStats stats = Common::MemcachingCaseInsensitiveArchive::getCacheStats();
+		TS_ASSERT_EQUALS(stats.hits, 2u);
+		TS_ASSERT_EQUALS(stats.misses, 1u);
+		TS_ASSERT_EQUALS(stats.entries, 1u);
+		TS_ASSERT_EQUALS(stats.bytesUsed, 512u);
+	}
+
+	void test_lru_eviction() {
+		TestMemcachingArchive archive;
+
+		delete archive.createReadStreamForMember("a");
+		delete archive.createReadStreamForMember("b");
+		// Touch "a" so that "b" is the least recently used
+		delete archive.createReadStreamForMember("a");
+		delete archive.createReadStreamForMember("c");
+
+		Common::ArchiveCacheStats stats = Common::MemcachingCaseInsensitiveArchive::getCacheStats();
+		TS_ASSERT_EQUALS(stats.evictions, 1u);
+		TS_ASSERT_EQUALS(stats.entries, 2u);
+		TS_ASSERT_EQUALS(archive.reads, 3);
+
+		delete archive.createReadStreamForMember("a");
+		TS_ASSERT_EQUALS(archive.reads, 3);
+		delete archive.createReadStreamForMember("b");
+		TS_ASSERT_EQUALS(archive.reads, 4);
+	}
+
+	void test_open_streams_are_pinned() {
+		TestMemcachingArchive archive;
+
+		Common::SeekableReadStream *a = archive.createReadStreamForMember("a");
+		Common::SeekableReadStream *b = archive.createReadStreamForMember("b");
+		Common::SeekableReadStream *c = archive.createReadStreamForMember("c");
+
+		// Nothing could be evicted while all three are open
+		Common::ArchiveCacheStats stats = Common::MemcachingCaseInsensitiveArchive::getCacheStats();
+		TS_ASSERT_EQUALS(stats.evictions, 0u);
+		TS_ASSERT_EQUALS(stats.pinned, 3u);
+		TS_ASSERT_EQUALS(stats.bytesUsed, 3 * 512u);
+
+		delete a;
+		delete b;
+		delete c;
+
+		Common::MemcachingCaseInsensitiveArchive::enforceCacheBudget();
+		stats = Common::MemcachingCaseInsensitiveArchive::getCacheStats();
+		TS_ASSERT_EQUALS(stats.evictions, 1u);
+		TS_ASSERT_EQUALS(stats.bytesUsed, 2 * 512u);
+	}
+
+	void test_archive_destruction() {
+		{
+			TestMemcachingArchive archive;
+			delete archive.createReadStreamForMember("a");
+		}
+
+		Common::ArchiveCacheStats stats = Common::MemcachingCaseInsensitiveArchive::getCacheStats();
+		TS_ASSERT_EQUALS(stats.entries, 0u);
+		TS_ASSERT_EQUALS(stats.bytesUsed, 0u);
+	}
+};
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/atomic.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+#if defined(POSIX) && defined(SCUMMVM_ATOMIC_REFCOUNT)
+#include <pthread.h>
+#define REFCOUNT_STRESS_TEST
+#endif
+
+struct RefCountStressData {
+	Common::String string;
+	Common::SharedPtr<int> shared;
+	Common::WeakPtr<int> weak;
+	int iterations;
+	bool failed;
+};
+
+static void *refCountStressThread(void *arg) {
+	RefCountStressData *data = (RefCountStressData *)arg;
+
+	for (int i = 0; i < data->iterations; i++) {
+		// Copies share the storage of the original, drop them again
+		Common::String copy(data->string);
+		Common::String other;
+		other = copy;
+		if (other.size() != data->string.size())
+			data->failed = true;
+
+		// Modifying a copy must not touch the shared storage
+		if (i % 64 == 0) {
+			copy += 'x';
+			if (data->string.lastChar() == 'x')
+				data->failed = true;
+		}
+
+		Common::SharedPtr<int> ptr(data->shared);
+		Common::SharedPtr<int> locked(data->weak);
+		if (!locked || *locked != 42)
+			data->failed = true;
+	}
+
+	return nullptr;
+}
+
+class RefCountTestSuite : public CxxTest::TestSuite {
+public:
+	void test_atomic_helpers() {
+		int count = 1;
+		Common::atomicIncrement(count);
+		TS_ASSERT_EQUALS(Common::atomicLoad(count), 2);
+		TS_ASSERT_EQUALS(Common::atomicDecrement(count), 1);
+		TS_ASSERT(Common::atomicIncrementIfNonZero(count));
+		TS_ASSERT_EQUALS(count, 2);
+
+		count = 0;
+		TS_ASSERT(!Common::atomicIncrementIfNonZero(count));
+		TS_ASSERT_EQUALS(count, 0);
+	}
+
+	void test_string_copy_on_write() {
+		Common::String a("a string which is too long to fit in the builtin storage");
+		Common::String b(a);
+		TS_ASSERT_EQUALS(a.c_str(), b.c_str());
+
+		b.setChar('A', 0);
+		TS_ASSERT_DIFFERS(a.c_str(), b.c_str());
+		TS_ASSERT_EQUALS(a[0], 'a');
+		TS_ASSERT_EQUALS(b[0], 'A');
+	}
+
+	void test_weak_ptr_expiry() {
+		Common::SharedPtr<int> shared(new int(1));
+		Common::WeakPtr<int> weak(shared);
+		TS_ASSERT(Common::SharedPtr<int>(weak));
+
+		shared.reset();
+		TS_ASSERT(weak.expired());
+		TS_ASSERT(!Common::SharedPtr<int>(weak));
+	}
+
+	void test_multithreaded_stress() {
+#ifdef REFCOUNT_STRESS_TEST
+		const int numThreads = 4;
+
+		RefCountStressData data;
+		data.string = "a string which is too long to fit in the builtin storage";
+		data.shared.reset(new int(42));
+		data.weak = data.shared;
+#ifdef SLOW_TESTS
+		data.iterations = 1000000;
+#else
+		data.iterations = 20000;
+#endif
+		data.failed = false;
+
+		pthread_t threads[numThreads];
+		for (int i = 0; i < numThreads; i++)
+			TS_ASSERT_EQUALS(pthread_create(&threads[i], nullptr, refCountStressThread, &data), 0);
+		for (int i = 0; i < numThreads; i++)
+			pthread_join(threads[i], nullptr);
+
+		TS_ASSERT(!data.failed);
+		// Every copy made by the threads has been released again
+		TS_ASSERT_EQUALS(data.shared.refCount(), 1);
+		TS_ASSERT_EQUALS(data.string, "a string which is too long to fit in the builtin storage");
+#endif
+	}
+};
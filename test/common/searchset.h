@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+#include "../system/null_osystem.h"
+
+class CountingArchive : public Common::Archive {
+public:
+	CountingArchive(const char *file, byte contents, bool stable = true) : _file(file), _contents(contents), _stable(stable),
+		hasFileCalls(0), listCalls(0), openCalls(0) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		hasFileCalls++;
+		return path.equalsIgnoreCase(_file);
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		listCalls++;
+		list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_file, *this)));
+		return 1;
+	}
+
+	bool hasStableMemberList() const override { return _stable; }
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path, *this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		openCalls++;
+		if (!path.equalsIgnoreCase(_file))
+			return nullptr;
+		return new Common::MemoryReadStream(&_contents, 1);
+	}
+
+	Common::Path _file;
+	byte _contents;
+	bool _stable;
+	mutable int hasFileCalls;
+	mutable int listCalls;
+	mutable int openCalls;
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	static byte readFirstByte(Common::SeekableReadStream *stream) {
+		byte b = stream ? stream->readByte() : 0;
+		delete stream;
+		return b;
+	}
+
+public:
+	void setUp() {
+		// The member index is guarded by a mutex
+		Common::install_null_g_system();
+	}
+
+	void tearDown() {
+		Common::uninstall_null_g_system();
+	}
+
+	void test_indexed_lookups() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("a.dat", 1);
+		CountingArchive *b = new CountingArchive("b.dat", 2);
+		set.add("a", a, 1);
+		set.add("b", b, 0);
+
+		// Hits and misses are answered by the index, whatever the case
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(set.hasFile("B.DAT"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(a->hasFileCalls, 0);
+		TS_ASSERT_EQUALS(b->hasFileCalls, 0);
+
+		// Only the archive which has the file is asked to open it
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("b.dat")), 2);
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("B.dat")), 2);
+		TS_ASSERT(!set.createReadStreamForMember("c.dat"));
+		TS_ASSERT_EQUALS(a->openCalls, 0);
+		TS_ASSERT_EQUALS(b->openCalls, 2);
+
+		Common::Archive *container = nullptr;
+		TS_ASSERT(set.getMember("b.dat", &container));
+		TS_ASSERT_EQUALS(container, b);
+
+		// The members were only listed once
+		TS_ASSERT_EQUALS(a->listCalls, 1);
+		TS_ASSERT_EQUALS(b->listCalls, 1);
+	}
+
+	void test_unindexed_archives() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("file", 1, false);
+		CountingArchive *b = new CountingArchive("b.dat", 2);
+		CountingArchive *c = new CountingArchive("c.dat", 3, false);
+		set.add("a", a, 1);
+		set.add("b", b, 0);
+		set.add("c", c, -1);
+
+		// Archives with a lower priority than the indexed hit are not asked
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("b.dat")), 2);
+		TS_ASSERT_EQUALS(a->hasFileCalls, 1);
+		TS_ASSERT_EQUALS(a->openCalls, 1);
+		TS_ASSERT_EQUALS(c->hasFileCalls, 0);
+		TS_ASSERT_EQUALS(c->openCalls, 0);
+		TS_ASSERT_EQUALS(a->listCalls, 0);
+
+		// An unindexed archive wins over a lower priority indexed one
+		b->_file = "file";
+		set.setPriority("b", -2);
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("file")), 1);
+
+		TS_ASSERT(set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("c.dat")), 3);
+	}
+
+	void test_stale_index() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("file", 1);
+		CountingArchive *b = new CountingArchive("file", 2);
+		set.add("a", a, 1);
+		set.add("b", b, 0);
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("file")), 1);
+
+		// A member which can't be opened anymore is looked for in the following archives
+		a->_file = "other";
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("file")), 2);
+	}
+
+	void test_invalidation() {
+		Common::SearchSet set;
+		set.add("a", new CountingArchive("file", 1), 0);
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("file")), 1);
+		TS_ASSERT(!set.hasFile("other"));
+
+		// A higher priority archive now provides it
+		set.add("b", new CountingArchive("file", 2), 1);
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("file")), 2);
+
+		set.setPriority("a", 2);
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("file")), 1);
+
+		set.remove("a");
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("file")), 2);
+
+		// Changes to nested sets are seen as well
+		Common::SearchSet *nested = new Common::SearchSet();
+		set.add("nested", nested, 3);
+		TS_ASSERT(!set.hasFile("other"));
+		nested->add("c", new CountingArchive("other", 3));
+		TS_ASSERT(set.hasFile("other"));
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("other")), 3);
+
+		set.clear();
+		TS_ASSERT(!set.hasFile("file"));
+	}
+
+	void test_archive_contents_change() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("a.dat", 1, false);
+		set.add("a", a);
+
+		// A file added to an unindexed archive after a failed lookup is found
+		TS_ASSERT(!set.hasFile("late.dat"));
+		TS_ASSERT(!set.createReadStreamForMember("late.dat"));
+		a->_file = "late.dat";
+		TS_ASSERT(set.hasFile("late.dat"));
+		TS_ASSERT_EQUALS(readFirstByte(set.createReadStreamForMember("late.dat")), 1);
+
+		// And a removed one is not found anymore
+		a->_file = "a.dat";
+		TS_ASSERT(!set.hasFile("late.dat"));
+		TS_ASSERT(!set.createReadStreamForMember("late.dat"));
+		TS_ASSERT(!set.getMember("late.dat"));
+	}
+};
@@ -0,0 +1,225 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/util.h"
+#include "graphics/palette.h"
+#include "engines/director/inkblit.h"
+
+/**
+ * Checks the row kernels used by DirectorPlotData::inkBlitSurface() against
+ * inkPixel(), which is what the per-pixel drawPoint() path uses, for every
+ * ink in 8-bit and 32-bit modes.
+ */
+class DirectorInkBlitTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 37;
+
+	uint32 _seed;
+	byte _palette[256 * 3];
+	Graphics::PaletteLookup _paletteLookup;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	static void getInks(Common::Array<Director::InkType> &inks) {
+		static const Director::InkType allInks[] = {
+			Director::kInkTypeCopy, Director::kInkTypeTransparent, Director::kInkTypeReverse,
+			Director::kInkTypeGhost, Director::kInkTypeNotCopy, Director::kInkTypeNotTrans,
+			Director::kInkTypeNotReverse, Director::kInkTypeNotGhost, Director::kInkTypeMatte,
+			Director::kInkTypeMask, Director::kInkTypeBlend, Director::kInkTypeAddPin,
+			Director::kInkTypeAdd, Director::kInkTypeSubPin, Director::kInkTypeBackgndTrans,
+			Director::kInkTypeLight, Director::kInkTypeSub, Director::kInkTypeDark
+		};
+		inks = Common::Array<Director::InkType>(allInks, ARRAYSIZE(allInks));
+	}
+
+	// Some pixels are set to the special colors, so that the ink
+	// colourization paths get exercised too.
+	uint32 randomPixel(const Director::InkBlitParams &p, int bytesPerPixel) {
+		switch (nextRandom() % 8) {
+		case 0:
+			return p.colorBlack;
+		case 1:
+			return p.colorWhite;
+		case 2:
+			return p.backColor;
+		default:
+			return bytesPerPixel == 1 ? (nextRandom() & 0xff) : nextRandom() ^ (nextRandom() << 24);
+		}
+	}
+
+	template<typename T>
+	void checkRow(const Director::InkBlitParams &p, Director::InkRowFunc inkRow, bool masked) {
+		T src[kWidth], expected[kWidth], actual[kWidth];
+		byte mask[kWidth];
+
+		for (int i = 0; i < kWidth; i++) {
+			src[i] = randomPixel(p, sizeof(T));
+			expected[i] = actual[i] = randomPixel(p, sizeof(T));
+			mask[i] = (nextRandom() % 3) ? 0xff : 0;
+		}
+
+		for (int i = 0; i < kWidth; i++) {
+			if (!masked || mask[i])
+				Director::inkPixel(&expected[i], src[i], p);
+		}
+		inkRow((byte *)actual, (const byte *)src, masked ? mask : nullptr, kWidth, p);
+
+		for (int i = 0; i < kWidth; i++) {
+			if (expected[i] != actual[i]) {
+				TS_FAIL(Common::String::format("ink %d, alpha %d, applyColor %d, oneBitImage %d, mask %d: pixel %d is %08x, expected %08x",
+					p.ink, p.alpha, p.applyColor, p.oneBitImage, masked, i, (uint)actual[i], (uint)expected[i]).c_str());
+				return;
+			}
+		}
+	}
+
+	template<typename T>
+	void checkAllInks(Director::InkBlitParams &p) {
+		static const int alphas[] = { 0, 1, 128, 255, 300 };
+		Common::Array<Director::InkType> inks;
+		getInks(inks);
+
+		for (uint i = 0; i < inks.size(); i++) {
+			for (int a = 0; a < ARRAYSIZE(alphas); a++) {
+				for (int flags = 0; flags < 4; flags++) {
+					p.ink = inks[i];
+					p.alpha = alphas[a];
+					p.applyColor = flags & 1;
+					p.oneBitImage = flags & 2;
+
+					Director::InkRowFunc inkRow = Director::getInkRowFunc(p, sizeof(T));
+					TS_ASSERT(inkRow != nullptr);
+					if (!inkRow)
+						continue;
+
+					for (int n = 0; n < 4; n++) {
+						checkRow<T>(p, inkRow, false);
+						checkRow<T>(p, inkRow, true);
+					}
+				}
+			}
+		}
+	}
+
+	void setColors32(Director::InkBlitParams &p) {
+		p.colorBlack = p.format.RGBToColor(0, 0, 0);
+		p.colorWhite = p.format.RGBToColor(0xff, 0xff, 0xff);
+		p.foreColor = p.format.RGBToColor(0x12, 0x34, 0x56);
+		p.backColor = p.format.RGBToColor(0xfe, 0xdc, 0xba);
+	}
+
+	static void getFormats(Common::Array<Graphics::PixelFormat> &formats) {
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0));
+		// Not byte aligned, so the arithmetic inks use the generic kernels
+		formats.push_back(Graphics::PixelFormat(4, 10, 10, 10, 2, 22, 12, 2, 0));
+	}
+
+	// The kernels are normally picked through g_system, which is not
+	// available here
+	static const Director::InkArithmeticKernels *getBestKernels() {
+#ifdef SCUMMVM_NEON
+		return &Director::inkArithmeticKernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			return &Director::inkArithmeticKernelsSSE2;
+#endif
+		return &Director::inkArithmeticKernelsGeneric;
+	}
+
+public:
+	void setUp() {
+		Director::inkArithmeticKernels = getBestKernels();
+
+		_seed = 0x1234;
+		for (int i = 0; i < 256 * 3; i++)
+			_palette[i] = nextRandom() & 0xff;
+		_paletteLookup.setPalette(_palette, 256);
+	}
+
+	void test_inks_8bit() {
+		Director::InkBlitParams p;
+		p.palette = _palette;
+		p.paletteLookup = &_paletteLookup;
+		p.format = Graphics::PixelFormat::createFormatCLUT8();
+		p.colorBlack = 0xff;
+		p.colorWhite = 0x00;
+		p.foreColor = 0x23;
+		p.backColor = 0xc4;
+
+		checkAllInks<byte>(p);
+	}
+
+	void test_inks_32bit() {
+		Common::Array<Graphics::PixelFormat> formats;
+		getFormats(formats);
+
+		for (uint i = 0; i < formats.size(); i++) {
+			Director::InkBlitParams p;
+			p.format = formats[i];
+			setColors32(p);
+
+			checkAllInks<uint32>(p);
+		}
+	}
+
+	void test_arithmetic_kernels_simd() {
+		const Director::InkArithmeticKernels *kernels[2] = { nullptr, nullptr };
+#ifdef SCUMMVM_NEON
+		kernels[0] = &Director::inkArithmeticKernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			kernels[1] = &Director::inkArithmeticKernelsSSE2;
+#endif
+
+		Common::Array<Graphics::PixelFormat> formats;
+		getFormats(formats);
+
+		for (int k = 0; k < 2; k++) {
+			if (!kernels[k])
+				continue;
+
+			const Director::InkRowFunc Director::InkArithmeticKernels::*rows[] = {
+				&Director::InkArithmeticKernels::blend,
+				&Director::InkArithmeticKernels::addPin,
+				&Director::InkArithmeticKernels::add,
+				&Director::InkArithmeticKernels::subPin,
+				&Director::InkArithmeticKernels::light,
+				&Director::InkArithmeticKernels::sub,
+				&Director::InkArithmeticKernels::dark
+			};
+			const Director::InkType inks[] = {
+				Director::kInkTypeBlend, Director::kInkTypeAddPin, Director::kInkTypeAdd,
+				Director::kInkTypeSubPin, Director::kInkTypeLight, Director::kInkTypeSub,
+				Director::kInkTypeDark
+			};
+
+			for (uint f = 0; f < formats.size(); f++) {
+				if (!Director::inkFormatIsByteAligned(formats[f]))
+					continue;
+
+				Director::InkBlitParams p;
+				p.format = formats[f];
+				setColors32(p);
+
+				for (int r = 0; r < ARRAYSIZE(rows); r++) {
+					for (int alpha = 0; alpha <= 255; alpha += (r == 0 ? 17 : 256)) {
+						p.ink = inks[r];
+						p.alpha = (r == 0) ? MAX(alpha, 1) : 0;
+						checkRow<uint32>(p, kernels[k]->*rows[r], false);
+						checkRow<uint32>(p, kernels[k]->*rows[r], true);
+					}
+				}
+			}
+		}
+	}
+};
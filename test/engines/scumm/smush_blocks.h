@@ -0,0 +1,294 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/util.h"
+#include "engines/scumm/smush/blocks.h"
+#include "engines/scumm/smush/codec37.h"
+#include "engines/scumm/smush/codec47.h"
+
+/**
+ * Checks that the SIMD block kernels used by the SMUSH codec 47 decoder
+ * produce the same pixels as the portable ones, and that the codec 37 and
+ * codec 47 decoders produce the same frames as the original decoders.
+ */
+class SmushBlocksTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	byte nextByte() {
+		_seed = _seed * 1103515245 + 12345;
+		return (byte)(_seed >> 16);
+	}
+
+	static void getKernels(const Scumm::SmushBlockKernels *kernels[2]) {
+		kernels[0] = kernels[1] = nullptr;
+#ifdef SCUMMVM_NEON
+		kernels[0] = &Scumm::smushBlockKernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			kernels[1] = &Scumm::smushBlockKernelsSSE2;
+#endif
+	}
+
+	// Codec 47 frame header: sequence number, compression, buffer rotation,
+	// the colors of codes 0xF8-0xFB and the background colors of the first frame
+	static void makeCodec47Frame(byte *frame, int seqNb, byte rotation, const byte *data, int size) {
+		memset(frame, 0, 26);
+		frame[0] = seqNb;
+		frame[2] = 2;
+		frame[3] = rotation;
+		frame[8] = 0x21;
+		frame[9] = 0x43;
+		frame[10] = 0x65;
+		frame[11] = 0x87;
+		frame[12] = 0xC4;
+		frame[13] = 0x3B;
+		memcpy(frame + 26, data, size);
+	}
+
+	// Codec 37 frame header: compression, sequence number, size and flags
+	static void makeCodec37Frame(byte *frame, byte compression, int seqNb, byte flags, const byte *data, int size) {
+		memset(frame, 0, 16);
+		frame[0] = compression;
+		frame[2] = seqNb;
+		frame[4] = size;
+		frame[12] = flags;
+		memcpy(frame + 16, data, size);
+	}
+
+public:
+	void test_generic_glyphs() {
+		const Scumm::SmushBlockKernels &generic = Scumm::smushBlockKernelsGeneric;
+		const int pitch = 16;
+		byte mask[64], dst[pitch * 8];
+
+		for (int i = 0; i < 64; i++)
+			mask[i] = (i % 3) ? 0xFF : 0x00;
+
+		memset(dst, 0x55, sizeof(dst));
+		generic.glyph8x8(dst, pitch, mask, 0x12, 0xF3);
+		for (int y = 0; y < 8; y++) {
+			for (int x = 0; x < 8; x++)
+				TS_ASSERT_EQUALS(dst[y * pitch + x], ((y * 8 + x) % 3) ? 0x12 : 0xF3);
+			for (int x = 8; x < pitch; x++)
+				TS_ASSERT_EQUALS(dst[y * pitch + x], 0x55);
+		}
+
+		memset(dst, 0x55, sizeof(dst));
+		generic.glyph4x4(dst, pitch, mask, 0x12, 0xF3);
+		for (int y = 0; y < 4; y++) {
+			for (int x = 0; x < 4; x++)
+				TS_ASSERT_EQUALS(dst[y * pitch + x], ((y * 4 + x) % 3) ? 0x12 : 0xF3);
+			for (int x = 4; x < pitch; x++)
+				TS_ASSERT_EQUALS(dst[y * pitch + x], 0x55);
+		}
+	}
+
+	void test_block_kernels() {
+		const int pitch = 24;
+		byte src[pitch * 8], mask[64], expected[pitch * 8], actual[pitch * 8];
+
+		_seed = 1;
+		for (uint i = 0; i < ARRAYSIZE(src); i++)
+			src[i] = nextByte();
+		for (uint i = 0; i < ARRAYSIZE(mask); i++)
+			mask[i] = (nextByte() & 1) ? 0xFF : 0x00;
+
+		const Scumm::SmushBlockKernels *kernels[2];
+		getKernels(kernels);
+		for (uint k = 0; k < ARRAYSIZE(kernels); k++) {
+			if (!kernels[k])
+				continue;
+
+			// Draw at an odd offset to check unaligned access, and check that
+			// the pixels next to the block are left alone.
+			for (int op = 0; op < 4; op++) {
+				const Scumm::SmushBlockKernels *impls[2] = { &Scumm::smushBlockKernelsGeneric, kernels[k] };
+				byte *results[2] = { expected, actual };
+
+				for (int i = 0; i < 2; i++) {
+					memset(results[i], 0x55, pitch * 8);
+					byte *dst = results[i] + 3;
+					switch (op) {
+					case 0:
+						impls[i]->copy8x8(dst, src + 5, pitch);
+						break;
+					case 1:
+						impls[i]->fill8x8(dst, 0xA7, pitch);
+						break;
+					case 2:
+						impls[i]->glyph8x8(dst, pitch, mask, 0x12, 0xF3);
+						break;
+					default:
+						impls[i]->glyph4x4(dst, pitch, mask, 0x12, 0xF3);
+						break;
+					}
+				}
+
+				for (int i = 0; i < pitch * 8; i++)
+					TS_ASSERT_EQUALS(actual[i], expected[i]);
+			}
+		}
+	}
+
+	/**
+	 * Decodes two 16x16 frames with every kind of codec 47 block and
+	 * compares them with the output of the decoder before the glyphs were
+	 * drawn from masks, with each set of kernels.
+	 */
+	void test_codec47_frames() {
+		// glyph, glyph, subblocks (glyph, glyph, fill, 2x2 subblocks), subblocks
+		// (param color, previous buffer, motion, 2x2 subblocks)
+		static const byte frame0[] = {
+			0xFD, 0x05, 0x12, 0xF3,
+			0xFD, 0xC3, 0xA0, 0x0B,
+			0xFF,
+				0xFD, 0x21, 0x30, 0x31,
+				0xFD, 0x9E, 0x32, 0x33,
+				0xFE, 0x77,
+				0xFF, 0xFE, 0x66, 0xFA, 0xFF, 0x01, 0x02, 0x03, 0x04, 0xFC,
+			0xFF,
+				0xF9,
+				0xFC,
+				0x00,
+				0xFF, 0xFB, 0xFE, 0x99, 0x00, 0xFF, 0x05, 0x06, 0x07, 0x08
+		};
+		// motion, motion, subblocks (motion, motion, glyph, previous buffer), glyph
+		static const byte frame1[] = {
+			0x5A,
+			0x76,
+			0xFF,
+				0x67,
+				0x7B,
+				0xFD, 0x44, 0x01, 0x02,
+				0xFC,
+			0xFD, 0x80, 0xE0, 0x0E
+		};
+		static const byte expected0[] = {
+			0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0,
+			0xF3, 0xF3, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0x0B,
+			0xF3, 0xF3, 0xF3, 0xF3, 0x12, 0x12, 0x12, 0x12, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0x0B, 0x0B,
+			0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0x12, 0x12, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0x0B, 0x0B, 0x0B,
+			0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xA0, 0xA0, 0xA0, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B,
+			0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xA0, 0xA0, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B,
+			0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xA0, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B,
+			0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B,
+			0x31, 0x30, 0x30, 0x31, 0x33, 0x33, 0x33, 0x33, 0x43, 0x43, 0x43, 0x43, 0xC4, 0xC4, 0xC4, 0xC4,
+			0x31, 0x31, 0x31, 0x31, 0x33, 0x33, 0x33, 0x33, 0x43, 0x43, 0x43, 0x43, 0xC4, 0xC4, 0xC4, 0xC4,
+			0x31, 0x31, 0x31, 0x31, 0x33, 0x33, 0x32, 0x33, 0x43, 0x43, 0x43, 0x43, 0xC4, 0xC4, 0xC4, 0xC4,
+			0x31, 0x31, 0x31, 0x31, 0x32, 0x32, 0x32, 0x33, 0x43, 0x43, 0x43, 0x43, 0xC4, 0xC4, 0xC4, 0xC4,
+			0x77, 0x77, 0x77, 0x77, 0x66, 0x66, 0x65, 0x65, 0x3B, 0x3B, 0x3B, 0x3B, 0x87, 0x87, 0x99, 0x99,
+			0x77, 0x77, 0x77, 0x77, 0x66, 0x66, 0x65, 0x65, 0x3B, 0x3B, 0x3B, 0x3B, 0x87, 0x87, 0x99, 0x99,
+			0x77, 0x77, 0x77, 0x77, 0x01, 0x02, 0xC4, 0xC4, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x05, 0x06,
+			0x77, 0x77, 0x77, 0x77, 0x03, 0x04, 0xC4, 0xC4, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x07, 0x08
+		};
+		static const byte expected1[] = {
+			0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x12,
+			0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xF3,
+			0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0x0B, 0xF3,
+			0x3B, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0x0B, 0x0B, 0xF3,
+			0xA0, 0xF3, 0xF3, 0x12, 0x12, 0x12, 0x12, 0x12, 0xA0, 0xA0, 0xA0, 0xA0, 0x0B, 0x0B, 0x0B, 0xF3,
+			0x0B, 0xF3, 0xF3, 0xF3, 0xF3, 0x12, 0x12, 0x12, 0xA0, 0xA0, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0xF3,
+			0x0B, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0x12, 0xA0, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0xF3,
+			0x0B, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0xF3, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0xF3,
+			0xF3, 0xF3, 0xF3, 0xF3, 0x30, 0x30, 0x31, 0x33, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+			0xF3, 0xF3, 0xF3, 0xF3, 0x31, 0x31, 0x31, 0x33, 0x0E, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+			0x31, 0x30, 0x30, 0x31, 0x31, 0x31, 0x31, 0x33, 0x0E, 0x0E, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+			0x31, 0x31, 0x31, 0x31, 0x31, 0x31, 0x31, 0x32, 0x0E, 0x0E, 0x0E, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+			0x02, 0x02, 0x02, 0x02, 0xC4, 0xC4, 0xC4, 0xC4, 0x0E, 0x0E, 0x0E, 0x0E, 0xE0, 0xE0, 0xE0, 0xE0,
+			0x02, 0x02, 0x02, 0x01, 0xC4, 0xC4, 0xC4, 0xC4, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xE0, 0xE0, 0xE0,
+			0x02, 0x02, 0x02, 0x02, 0xC4, 0xC4, 0xC4, 0xC4, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xE0, 0xE0,
+			0x02, 0x02, 0x02, 0x02, 0xC4, 0xC4, 0xC4, 0xC4, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xE0
+		};
+
+		const Scumm::SmushBlockKernels *kernels[3] = { &Scumm::smushBlockKernelsGeneric };
+		getKernels(kernels + 1);
+
+		const Scumm::SmushBlockKernels *oldKernels = Scumm::smushBlockKernels;
+		for (uint k = 0; k < ARRAYSIZE(kernels); k++) {
+			if (!kernels[k])
+				continue;
+			Scumm::smushBlockKernels = kernels[k];
+
+			Scumm::SmushDeltaGlyphsDecoder decoder(16, 16);
+			byte frame[26 + 64], dst[256];
+
+			// The first frame is moved to the motion buffer for the second one
+			makeCodec47Frame(frame, 0, 1, frame0, sizeof(frame0));
+			TS_ASSERT(decoder.decode(dst, frame));
+			TS_ASSERT_SAME_DATA(dst, expected0, sizeof(expected0));
+
+			makeCodec47Frame(frame, 1, 0, frame1, sizeof(frame1));
+			TS_ASSERT(decoder.decode(dst, frame));
+			TS_ASSERT_SAME_DATA(dst, expected1, sizeof(expected1));
+		}
+		Scumm::smushBlockKernels = oldKernels;
+	}
+
+	/**
+	 * Decodes 16x8 codec 37 frames with runs of unchanged blocks crossing
+	 * and ending on block rows, and compares them with the output of the
+	 * decoder before the runs were copied a row at a time.
+	 */
+	void test_codec37_runs() {
+		byte raw[128];
+		for (int i = 0; i < 128; i++)
+			raw[i] = (byte)(i * 13 + (i >> 4));
+
+		// run of 5 blocks, literal pixels, motion, run to the end of the frame
+		static const byte frame1[] = {
+			0x00, 0x04,
+			0xFF, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+			0x11,
+			0x00, 0x00
+		};
+		// with 0xFD/0xFE: block fill, line fills, run to the end of the row,
+		// run of 3 blocks, motion
+		static const byte frame2[] = {
+			0xFD, 0x9A,
+			0xFE, 0xA1, 0xA2, 0xA3, 0xA4,
+			0x00, 0x01,
+			0x00, 0x02,
+			0x02
+		};
+		static const byte expected1[] = {
+			0x00, 0x0D, 0x1A, 0x27, 0x34, 0x41, 0x4E, 0x5B, 0x68, 0x75, 0x82, 0x8F, 0x9C, 0xA9, 0xB6, 0xC3,
+			0xD1, 0xDE, 0xEB, 0xF8, 0x05, 0x12, 0x1F, 0x2C, 0x39, 0x46, 0x53, 0x60, 0x6D, 0x7A, 0x87, 0x94,
+			0xA2, 0xAF, 0xBC, 0xC9, 0xD6, 0xE3, 0xF0, 0xFD, 0x0A, 0x17, 0x24, 0x31, 0x3E, 0x4B, 0x58, 0x65,
+			0x73, 0x80, 0x8D, 0x9A, 0xA7, 0xB4, 0xC1, 0xCE, 0xDB, 0xE8, 0xF5, 0x02, 0x0F, 0x1C, 0x29, 0x36,
+			0x44, 0x51, 0x5E, 0x6B, 0x10, 0x11, 0x12, 0x13, 0x8A, 0x97, 0xA4, 0xB1, 0xE0, 0xED, 0xFA, 0x07,
+			0x15, 0x22, 0x2F, 0x3C, 0x14, 0x15, 0x16, 0x17, 0x5B, 0x68, 0x75, 0x82, 0xB1, 0xBE, 0xCB, 0xD8,
+			0xE6, 0xF3, 0x00, 0x0D, 0x18, 0x19, 0x1A, 0x1B, 0x2C, 0x39, 0x46, 0x53, 0x82, 0x8F, 0x9C, 0xA9,
+			0xB7, 0xC4, 0xD1, 0xDE, 0x1C, 0x1D, 0x1E, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x53, 0x60, 0x6D, 0x7A
+		};
+		static const byte expected2[] = {
+			0x9A, 0x9A, 0x9A, 0x9A, 0xA1, 0xA1, 0xA1, 0xA1, 0x68, 0x75, 0x82, 0x8F, 0x9C, 0xA9, 0xB6, 0xC3,
+			0x9A, 0x9A, 0x9A, 0x9A, 0xA2, 0xA2, 0xA2, 0xA2, 0x39, 0x46, 0x53, 0x60, 0x6D, 0x7A, 0x87, 0x94,
+			0x9A, 0x9A, 0x9A, 0x9A, 0xA3, 0xA3, 0xA3, 0xA3, 0x0A, 0x17, 0x24, 0x31, 0x3E, 0x4B, 0x58, 0x65,
+			0x9A, 0x9A, 0x9A, 0x9A, 0xA4, 0xA4, 0xA4, 0xA4, 0xDB, 0xE8, 0xF5, 0x02, 0x0F, 0x1C, 0x29, 0x36,
+			0x44, 0x51, 0x5E, 0x6B, 0x10, 0x11, 0x12, 0x13, 0x8A, 0x97, 0xA4, 0xB1, 0xFA, 0x07, 0x15, 0x22,
+			0x15, 0x22, 0x2F, 0x3C, 0x14, 0x15, 0x16, 0x17, 0x5B, 0x68, 0x75, 0x82, 0xCB, 0xD8, 0xE6, 0xF3,
+			0xE6, 0xF3, 0x00, 0x0D, 0x18, 0x19, 0x1A, 0x1B, 0x2C, 0x39, 0x46, 0x53, 0x9C, 0xA9, 0xB7, 0xC4,
+			0xB7, 0xC4, 0xD1, 0xDE, 0x1C, 0x1D, 0x1E, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x6D, 0x7A, 0x00, 0x00
+		};
+
+		Scumm::SmushDeltaBlocksDecoder decoder(16, 8);
+		byte frame[16 + 128], dst[128];
+
+		makeCodec37Frame(frame, 0, 0, 0, raw, sizeof(raw));
+		decoder.decode(dst, frame);
+		TS_ASSERT_SAME_DATA(dst, raw, sizeof(raw));
+
+		makeCodec37Frame(frame, 4, 1, 0, frame1, sizeof(frame1));
+		decoder.decode(dst, frame);
+		TS_ASSERT_SAME_DATA(dst, expected1, sizeof(expected1));
+
+		makeCodec37Frame(frame, 4, 2, 4, frame2, sizeof(frame2));
+		decoder.decode(dst, frame);
+		TS_ASSERT_SAME_DATA(dst, expected2, sizeof(expected2));
+	}
+};
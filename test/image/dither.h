@@ -0,0 +1,109 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "image/codecs/dither.h"
+#include "graphics/surface.h"
+
+// A codec handing out a fixed frame
+class FixedFrameCodec : public Image::Codec {
+public:
+	FixedFrameCodec(const Graphics::Surface &frame, const byte *palette) : _frame(frame), _palette(palette) {}
+
+	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override { return &_frame; }
+	Graphics::PixelFormat getPixelFormat() const override { return _frame.format; }
+	bool containsPalette() const override { return _palette != nullptr; }
+	const byte *getPalette() override { return _palette; }
+
+private:
+	const Graphics::Surface &_frame;
+	const byte *_palette;
+};
+
+class DitherCodecTestSuite : public CxxTest::TestSuite {
+public:
+	void test_quicktime_dither_clut8() {
+		byte srcPalette[256 * 3];
+		makePalette(srcPalette, 7);
+
+		Graphics::Surface frame;
+		frame.create(13, 9, Graphics::PixelFormat::createFormatCLUT8());
+		for (int y = 0; y < frame.h; y++)
+			for (int x = 0; x < frame.w; x++)
+				frame.setPixel(x, y, (x * 37 + y * 11) & 0xFF);
+
+		checkDither(frame, srcPalette);
+		frame.free();
+	}
+
+	void test_quicktime_dither_rgb565() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+
+		Graphics::Surface frame;
+		frame.create(11, 6, rgb565);
+		for (int y = 0; y < frame.h; y++)
+			for (int x = 0; x < frame.w; x++)
+				frame.setPixel(x, y, rgb565.RGBToColor(x * 23, y * 40, (x * y * 5) & 0xFF));
+
+		checkDither(frame, nullptr);
+		frame.free();
+	}
+
+	void test_quicktime_dither_table_shared() {
+		byte palette[256 * 3];
+		makePalette(palette, 3);
+
+		Common::SharedPtr<byte> first = Image::DitherCodec::getQuickTimeDitherTable(palette);
+		Common::SharedPtr<byte> second = Image::DitherCodec::getQuickTimeDitherTable(palette);
+		TS_ASSERT(first.get() == second.get());
+
+		byte *fresh = Image::DitherCodec::createQuickTimeDitherTable(palette, 256);
+		TS_ASSERT(memcmp(first.get(), fresh, 0x10000) == 0);
+		delete[] fresh;
+	}
+
+private:
+	static void makePalette(byte *palette, int seed) {
+		for (int i = 0; i < 256 * 3; i++)
+			palette[i] = (i * seed * 13 + (i >> 3)) & 0xFF;
+	}
+
+	// Compare against a plain per-pixel lookup in the dither table
+	static void checkDither(const Graphics::Surface &frame, const byte *srcPalette) {
+		static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
+
+		byte ditherPalette[256 * 3];
+		makePalette(ditherPalette, 5);
+
+		Image::DitherCodec codec(new FixedFrameCodec(frame, srcPalette));
+		codec.setDither(Image::Codec::kDitherTypeQT, ditherPalette);
+
+		Common::MemoryReadStream stream(ditherPalette, 1);
+		const Graphics::Surface *result = codec.decodeFrame(stream);
+		TS_ASSERT(result != nullptr);
+		if (!result)
+			return;
+
+		byte *table = Image::DitherCodec::createQuickTimeDitherTable(ditherPalette, 256);
+
+		for (int y = 0; y < frame.h; y++) {
+			uint16 offset = colorTableOffsets[y & 3];
+			for (int x = 0; x < frame.w; x++) {
+				uint32 pixel = frame.getPixel(x, y);
+				byte r, g, b;
+				if (srcPalette) {
+					r = srcPalette[pixel * 3];
+					g = srcPalette[pixel * 3 + 1];
+					b = srcPalette[pixel * 3 + 2];
+				} else {
+					frame.format.colorToRGB(pixel, r, g, b);
+				}
+
+				uint16 color = ((r & 0xF8) << 6) | ((g & 0xF8) << 1) | (b >> 4);
+				TS_ASSERT_EQUALS(result->getPixel(x, y), table[offset + color]);
+				offset += 0x4000;
+			}
+		}
+
+		delete[] table;
+	}
+};
@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/png.h"
+#include "graphics/surface.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+public:
+	void test_load_into_surface() {
+#ifdef USE_PNG
+		const Graphics::PixelFormat rgb24 = Graphics::PixelFormat::createFormatRGB24();
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+
+		Graphics::Surface src;
+		src.create(3, 40, rgb24);
+		for (int y = 0; y < src.h; y++)
+			for (int x = 0; x < src.w; x++)
+				src.setPixel(x, y, rgb24.RGBToColor(x * 100, y * 6, 255 - y));
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		TS_ASSERT(Image::writePNG(out, src));
+
+		Graphics::Surface dst;
+		dst.create(8, 48, rgb565);
+		dst.fillRect(Common::Rect(dst.w, dst.h), 0x1234);
+
+		Image::PNGDecoder decoder;
+		Common::MemoryReadStream stream(out.getData(), out.size());
+		TS_ASSERT(decoder.loadStreamInto(stream, dst, 2, 3));
+		TS_ASSERT(decoder.getSurface() == nullptr);
+
+		for (int y = 0; y < dst.h; y++) {
+			for (int x = 0; x < dst.w; x++) {
+				uint32 expected = 0x1234;
+				if (x >= 2 && x < 5 && y >= 3 && y < 43) {
+					byte r, g, b;
+					rgb24.colorToRGB(src.getPixel(x - 2, y - 3), r, g, b);
+					expected = rgb565.RGBToColor(r, g, b);
+				}
+				TS_ASSERT_EQUALS(dst.getPixel(x, y), expected);
+			}
+		}
+
+		// An image which does not fit is rejected
+		stream.seek(0);
+		TS_ASSERT(!decoder.loadStreamInto(stream, dst, 6, 0));
+
+		src.free();
+		dst.free();
+#endif
+	}
+
+	void test_output_pixel_format() {
+#ifdef USE_PNG
+		const byte palette[2 * 3] = { 0, 0, 0, 255, 128, 64 };
+		const Graphics::PixelFormat argb = Graphics::PixelFormat::createFormatARGB32();
+
+		Graphics::Surface src;
+		src.create(2, 1, Graphics::PixelFormat::createFormatCLUT8());
+		src.setPixel(0, 0, 1);
+		src.setPixel(1, 0, 0);
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		TS_ASSERT(Image::writePNG(out, src, palette, 2));
+
+		Image::PNGDecoder decoder;
+		decoder.setOutputPixelFormat(argb);
+		Common::MemoryReadStream stream(out.getData(), out.size());
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT(surface != nullptr);
+		if (!surface)
+			return;
+
+		TS_ASSERT(surface->format == argb);
+		TS_ASSERT(!decoder.hasPalette());
+		TS_ASSERT_EQUALS(surface->getPixel(0, 0), argb.ARGBToColor(255, 255, 128, 64));
+		TS_ASSERT_EQUALS(surface->getPixel(1, 0), argb.ARGBToColor(255, 0, 0, 0));
+
+		src.free();
+#endif
+	}
+};
@@ -0,0 +1,126 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "graphics/blit.h"
+#include "graphics/surface.h"
+
+class ScaleBlitBoxTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+		// Use the portable kernel, the SIMD ones are checked against it below
+		Graphics::boxAccumulateFunc = Graphics::boxAccumulateGeneric;
+	}
+
+	void tearDown() {
+		Graphics::boxAccumulateFunc = nullptr;
+	}
+
+	void test_box_average_32bpp() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Graphics::Surface src, dst;
+		src.create(6, 4, format);
+		dst.create(2, 2, format);
+
+		for (int y = 0; y < src.h; y++)
+			for (int x = 0; x < src.w; x++)
+				src.setPixel(x, y, format.ARGBToColor(255, x * 40, y * 60, (x + y) * 20));
+
+		TS_ASSERT(Graphics::scaleBlitBox((byte *)dst.getPixels(), (const byte *)src.getPixels(),
+		                                 dst.pitch, src.pitch, dst.w, dst.h, src.w, src.h, format));
+
+		// Every output pixel covers a 3x2 block of input pixels
+		for (int y = 0; y < dst.h; y++) {
+			for (int x = 0; x < dst.w; x++) {
+				uint r = 0, g = 0, b = 0;
+				for (int sy = y * 2; sy < y * 2 + 2; sy++) {
+					for (int sx = x * 3; sx < x * 3 + 3; sx++) {
+						r += sx * 40;
+						g += sy * 60;
+						b += (sx + sy) * 20;
+					}
+				}
+				TS_ASSERT_EQUALS(dst.getPixel(x, y), format.ARGBToColor(255, (r + 3) / 6, (g + 3) / 6, (b + 3) / 6));
+			}
+		}
+
+		src.free();
+		dst.free();
+	}
+
+	void test_box_average_16bpp() {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const uint16 src[2] = { (uint16)format.RGBToColor(255, 255, 255), (uint16)format.RGBToColor(0, 0, 0) };
+		uint16 dst = 0;
+
+		TS_ASSERT(Graphics::scaleBlitBox((byte *)&dst, (const byte *)src, 2, 4, 1, 1, 2, 1, format));
+		TS_ASSERT_EQUALS(dst, format.RGBToColor(128, 128, 128));
+	}
+
+	void test_box_rejects_upscale() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		uint32 src[4] = { 0 }, dst[8] = { 0 };
+
+		TS_ASSERT(!Graphics::scaleBlitBox((byte *)dst, (const byte *)src, 16, 8, 4, 2, 2, 2, format));
+		TS_ASSERT(!Graphics::scaleBlitBox((byte *)dst, (const byte *)src, 4, 8, 1, 2, 2, 2, Graphics::PixelFormat::createFormatCLUT8()));
+	}
+
+	void test_box_accumulate_kernels() {
+		byte src[77];
+		uint32 expected[77];
+		for (uint i = 0; i < ARRAYSIZE(src); i++) {
+			src[i] = (byte)(i * 37 + 11);
+			expected[i] = 1000 + i + src[i];
+		}
+
+		Graphics::BoxAccumulateFunc kernels[3] = { nullptr, nullptr, nullptr };
+#ifdef SCUMMVM_NEON
+		kernels[0] = Graphics::boxAccumulateNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			kernels[1] = Graphics::boxAccumulateSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			kernels[2] = Graphics::boxAccumulateAVX2;
+#endif
+
+		for (uint k = 0; k < ARRAYSIZE(kernels); k++) {
+			if (!kernels[k])
+				continue;
+
+			uint32 acc[77];
+			for (uint i = 0; i < ARRAYSIZE(acc); i++)
+				acc[i] = 1000 + i;
+
+			kernels[k](acc, src, ARRAYSIZE(src));
+			for (uint i = 0; i < ARRAYSIZE(acc); i++)
+				TS_ASSERT_EQUALS(acc[i], expected[i]);
+		}
+	}
+};
@@ -51,6 +51,18 @@ endif
 	TEST_LIBS += engines/ultima/libultima.a
 endif
 
+ifeq ($(ENABLE_DIRECTOR), STATIC_PLUGIN)
+	TESTS += $(srcdir)/test/engines/director/*.h
+	TEST_LIBS += engines/director/libdirector.a
+endif
+
+ifeq ($(ENABLE_SCUMM), STATIC_PLUGIN)
+ifdef ENABLE_SCUMM_7_8
+	TESTS += $(srcdir)/test/engines/scumm/*.h
+	TEST_LIBS += engines/scumm/libscumm.a
+endif
+endif
+
 ifeq ($(ENABLE_TWINE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/twine/*.h
 	TEST_LIBS += engines/twine/libtwine.a
@@ -71,6 +83,11 @@ ifdef N64
 TEST_LDFLAGS := $(filter-out -mno-crt0,$(TEST_LDFLAGS))
 endif
 
+# The reference counting stress test runs on POSIX threads
+ifneq ($(findstring -DPOSIX,$(DEFINES)),)
+TEST_LDFLAGS += -pthread
+endif
+
 ifdef PSP
 TEST_LIBS += backends/platform/psp/memory.o \
 	backends/platform/psp/mp3.o \
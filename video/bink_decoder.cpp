@@ -245,7 +245,7 @@ BinkDecoder::AudioInfo::~AudioInfo() {
 }
 
 BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, bool swapPlanes, bool hasAlpha, uint32 id) :
-		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr) {
+		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr), _needsConversion(false) {
 	_curFrame = -1;
 
 	for (int i = 0; i < 16; i++)
@@ -444,6 +444,26 @@ bool BinkDecoder::BinkVideoTrack::rewind() {
 	return true;
 }
 
+const Graphics::Surface *BinkDecoder::BinkVideoTrack::decodeNextFrame() {
+	if (_needsConversion) {
+		convertFrame(_surface);
+		_needsConversion = false;
+	}
+
+	return _surface;
+}
+
+bool BinkDecoder::BinkVideoTrack::canRenderFrame() const {
+	// The conversion writes whole even-sized surfaces, so odd-sized videos
+	// still need to go through our own over-allocated buffer.
+	return _width == _surfaceWidth && _height == _surfaceHeight;
+}
+
+void BinkDecoder::BinkVideoTrack::renderFrame(Graphics::Surface &dst) {
+	assert(dst.w == _surfaceWidth && dst.h == _surfaceHeight && dst.format == _pixelFormat);
+	convertFrame(&dst);
+}
+
 void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	assert(frame.bits);
 
@@ -476,24 +496,28 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 			break;
 	}
 
+	// Swap the planes with the reference planes. The YUV to RGB conversion
+	// is left until the frame is asked for, from the reference planes.
+	for (int i = 0; i < 4; i++)
+		SWAP(_curPlanes[i], _oldPlanes[i]);
+
+	_needsConversion = true;
+	_curFrame++;
+}
+
+void BinkDecoder::BinkVideoTrack::convertFrame(Graphics::Surface *dst) {
 	// Convert the YUV data we have to our format
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
 	if (_hasAlpha) {
-		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2] && _curPlanes[3]);
-		YUVToRGBMan.convert420Alpha(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2], _curPlanes[3],
+		assert(_oldPlanes[0] && _oldPlanes[1] && _oldPlanes[2] && _oldPlanes[3]);
+		YUVToRGBMan.convert420Alpha(dst, Graphics::YUVToRGBManager::kScaleITU, _oldPlanes[0], _oldPlanes[1], _oldPlanes[2], _oldPlanes[3],
 				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
 	} else {
-		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2]);
-		YUVToRGBMan.convert420(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
+		assert(_oldPlanes[0] && _oldPlanes[1] && _oldPlanes[2]);
+		YUVToRGBMan.convert420(dst, Graphics::YUVToRGBManager::kScaleITU, _oldPlanes[0], _oldPlanes[1], _oldPlanes[2],
 				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
 	}
-
-	// And swap the planes with the reference planes
-	for (int i = 0; i < 4; i++)
-		SWAP(_curPlanes[i], _oldPlanes[i]);
-
-	_curFrame++;
 }
 
 void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
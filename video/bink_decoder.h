@@ -162,7 +162,9 @@ private:
 
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
-		const Graphics::Surface *decodeNextFrame() override { return _surface; }
+		const Graphics::Surface *decodeNextFrame() override;
+		bool canRenderFrame() const override;
+		void renderFrame(Graphics::Surface &dst) override;
 		bool isSeekable() const  override{ return true; }
 		bool seek(const Audio::Timestamp &time) override { return true; }
 		bool rewind() override;
@@ -251,6 +253,7 @@ private:
 		int _frameCount;
 
 		Graphics::Surface *_surface;
+		bool _needsConversion; ///< Whether the last decoded frame still needs converting into _surface
 		Graphics::PixelFormat _pixelFormat;
 		uint16 _width;
 		uint16 _height;
@@ -292,6 +295,9 @@ private:
 		/** Decode a plane. */
 		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
 
+		/** Convert the last decoded frame to RGB. */
+		void convertFrame(Graphics::Surface *dst);
+
 		/** Read/Initialize a bundle for decoding a plane. */
 		void readBundle(VideoFrame &video, Source source);
 
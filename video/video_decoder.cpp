@@ -26,8 +26,11 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
+#include "graphics/surface.h"
+
 namespace Video {
 
 VideoDecoder::VideoDecoder() {
@@ -208,28 +211,50 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
-	_needsUpdate = false;
-	_canSetDither = false;
-	_canSetDefaultFormat = false;
-
-	readNextPacket();
+	PROFILE_ZONE("VideoDecoder::decodeNextFrame");
+	VideoTrack *track = readNextFrame();
 
 	// If we have no next video track at this point, there shouldn't be
 	// any frame available for us to display.
-	if (!_nextVideoTrack)
+	if (!track)
 		return 0;
 
-	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+	const Graphics::Surface *frame = track->decodeNextFrame();
+	finishNextFrame(track);
+	return frame;
+}
 
-	if (_nextVideoTrack->hasDirtyPalette()) {
-		_palette = _nextVideoTrack->getPalette();
-		_dirtyPalette = true;
+bool VideoDecoder::decodeNextFrameToScreen(int x, int y) {
+	Common::Rect rect(x, y, x + getWidth(), y + getHeight());
+	bool onScreen = !rect.isEmpty() && rect.left >= 0 && rect.top >= 0 && rect.right <= g_system->getWidth() && rect.bottom <= g_system->getHeight();
+
+	VideoTrack *track = _nextVideoTrack;
+	if (!onScreen || !track || !track->canRenderFrame() || track->getPixelFormat() != g_system->getScreenFormat()) {
+		const Graphics::Surface *frame = decodeNextFrame();
+		if (frame)
+			g_system->copyRectToScreen(frame->getPixels(), frame->pitch, x, y, frame->w, frame->h);
+		return frame != nullptr;
 	}
 
-	// Look for the next video track here for the next decode.
-	findNextVideoTrack();
+	// Decode before locking the screen, so that the backend is only held
+	// up for the time it takes to write the frame.
+	PROFILE_ZONE("VideoDecoder::decodeNextFrameToScreen");
+	track = readNextFrame();
+	if (!track)
+		return false;
 
-	return frame;
+	Graphics::Surface *screen = g_system->lockScreenRect(rect);
+	if (screen) {
+		track->renderFrame(*screen);
+		g_system->unlockScreenRect();
+	} else {
+		const Graphics::Surface *frame = track->decodeNextFrame();
+		if (frame)
+			g_system->copyRectToScreen(frame->getPixels(), frame->pitch, x, y, frame->w, frame->h);
+	}
+
+	finishNextFrame(track);
+	return true;
 }
 
 bool VideoDecoder::setReverse(bool reverse) {
@@ -988,6 +1013,26 @@ bool VideoDecoder::endOfVideoTracks() const {
 	return true;
 }
 
+VideoDecoder::VideoTrack *VideoDecoder::readNextFrame() {
+	_needsUpdate = false;
+	_canSetDither = false;
+	_canSetDefaultFormat = false;
+
+	readNextPacket();
+
+	return _nextVideoTrack;
+}
+
+void VideoDecoder::finishNextFrame(VideoTrack *track) {
+	if (track->hasDirtyPalette()) {
+		_palette = track->getPalette();
+		_dirtyPalette = true;
+	}
+
+	// Look for the next video track here for the next decode.
+	findNextVideoTrack();
+}
+
 VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	_nextVideoTrack = 0;
 	uint32 bestTime = 0xFFFFFFFF;
@@ -371,6 +371,24 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame and put it on the screen at the given position.
+	 *
+	 * If the backend supports OSystem::lockScreenRect() and the video track
+	 * can render its frames into a caller-provided surface, the frame is
+	 * decoded first and then rendered straight into the screen, without any
+	 * intermediate copy. The screen is only locked while rendering.
+	 * Otherwise, this behaves like decodeNextFrame() followed by a copy of the
+	 * frame to the screen.
+	 *
+	 * The whole video area must lie within the screen. As with
+	 * decodeNextFrame(), the caller is responsible for updating the
+	 * palette of paletted videos and for calling OSystem::updateScreen().
+	 *
+	 * @return true if a new frame was drawn, false otherwise
+	 */
+	bool decodeNextFrameToScreen(int x, int y);
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -661,6 +679,22 @@ protected:
 		 */
 		virtual const Graphics::Surface *decodeNextFrame() = 0;
 
+		/**
+		 * Whether renderFrame() is supported by this track.
+		 */
+		virtual bool canRenderFrame() const { return false; }
+
+		/**
+		 * Write the most recently decoded frame to the given surface.
+		 *
+		 * This is meant for tracks which convert their frames from another
+		 * representation, so that they can convert straight into the
+		 * destination. The surface must have the track's dimensions and
+		 * pixel format. The frame returned by decodeNextFrame() is left
+		 * untouched.
+		 */
+		virtual void renderFrame(Graphics::Surface &dst) {}
+
 		/**
 		 * Get the palette currently in use by this track
 		 */
@@ -912,6 +946,19 @@ protected:
 	 */
 	virtual void readNextPacket() {}
 
+	/**
+	 * Read the packet for the next frame, as decodeNextFrame() does.
+	 *
+	 * @return The track the frame belongs to, or 0 if there is none
+	 */
+	VideoTrack *readNextFrame();
+
+	/**
+	 * Pick up the palette of the frame just decoded by @p track and move
+	 * on to the next video track.
+	 */
+	void finishNextFrame(VideoTrack *track);
+
 	/**
 	 * Define a track to be used by this class.
 	 *